@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/App/DecoderApp/DecApp.cpp" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecApp.cpp.o" "gcc" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecApp.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/DecAppCfg.cpp" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecAppCfg.cpp.o" "gcc" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecAppCfg.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/decmain.cpp" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/decmain.cpp.o" "gcc" "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/decmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_split_build/source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/DecoderAnalyserLib/CMakeFiles/DecoderAnalyserLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/App/DecoderApp/DecApp.cpp" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/DecApp.cpp.o" "gcc" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/DecApp.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/DecAppCfg.cpp" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/DecAppCfg.cpp.o" "gcc" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/DecAppCfg.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/decmain.cpp" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/decmain.cpp.o" "gcc" "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/decmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_split_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
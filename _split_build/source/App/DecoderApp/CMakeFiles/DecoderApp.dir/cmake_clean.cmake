@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/DecoderApp"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/DecoderApp.pdb"
+  "CMakeFiles/DecoderApp.dir/DecApp.cpp.o"
+  "CMakeFiles/DecoderApp.dir/DecApp.cpp.o.d"
+  "CMakeFiles/DecoderApp.dir/DecAppCfg.cpp.o"
+  "CMakeFiles/DecoderApp.dir/DecAppCfg.cpp.o.d"
+  "CMakeFiles/DecoderApp.dir/decmain.cpp.o"
+  "CMakeFiles/DecoderApp.dir/decmain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DecoderApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/App/EncoderApp/EncApp.cpp" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/EncApp.cpp.o" "gcc" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/EncApp.cpp.o.d"
+  "/root/repo/source/App/EncoderApp/EncAppCfg.cpp" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/EncAppCfg.cpp.o" "gcc" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/EncAppCfg.cpp.o.d"
+  "/root/repo/source/App/EncoderApp/encmain.cpp" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/encmain.cpp.o" "gcc" "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/encmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_split_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DependInfo.cmake"
+  "/root/repo/_split_build/source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
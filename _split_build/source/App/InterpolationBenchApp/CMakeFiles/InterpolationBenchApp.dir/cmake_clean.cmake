@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/InterpolationBenchApp"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/InterpolationBenchApp.pdb"
+  "CMakeFiles/InterpolationBenchApp.dir/InterpolationBenchApp.cpp.o"
+  "CMakeFiles/InterpolationBenchApp.dir/InterpolationBenchApp.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/InterpolationBenchApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/SubpicMergeApp"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/SubpicMergeApp.pdb"
+  "CMakeFiles/SubpicMergeApp.dir/SubpicMergeApp.cpp.o"
+  "CMakeFiles/SubpicMergeApp.dir/SubpicMergeApp.cpp.o.d"
+  "CMakeFiles/SubpicMergeApp.dir/SubpicMergeMain.cpp.o"
+  "CMakeFiles/SubpicMergeApp.dir/SubpicMergeMain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SubpicMergeApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/Lib/EncoderLib/AQp.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/AQp.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/AQp.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/ApproxFilterPolicy.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/ApproxFilterPolicy.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/ApproxFilterPolicy.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/BinEncoder.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/BinEncoder.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/BinEncoder.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/CABACWriter.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/CABACWriter.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/CABACWriter.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncAdaptiveLoopFilter.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncAdaptiveLoopFilter.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncAdaptiveLoopFilter.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncCu.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncCu.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncCu.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncGOP.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncGOP.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncGOP.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncHRD.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncHRD.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncHRD.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncLib.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncLib.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncLib.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncLibCommon.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncLibCommon.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncLibCommon.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncModeCtrl.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncModeCtrl.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncModeCtrl.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncReshape.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncReshape.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncReshape.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncSampleAdaptiveOffset.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncSampleAdaptiveOffset.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncSampleAdaptiveOffset.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncSlice.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncSlice.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncSlice.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/EncTemporalFilter.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncTemporalFilter.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/EncTemporalFilter.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/FracPelPlaneCache.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/FracPelPlaneCache.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/FracPelPlaneCache.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/InterSearch.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/InterSearch.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/InterSearch.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/IntraSearch.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/IntraSearch.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/IntraSearch.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/NALwrite.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/NALwrite.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/NALwrite.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/RateCtrl.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/RateCtrl.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/RateCtrl.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/SEIEncoder.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/SEIEncoder.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/SEIEncoder.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/SEIwrite.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/SEIwrite.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/SEIwrite.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/VLCWriter.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/VLCWriter.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/VLCWriter.cpp.o.d"
+  "/root/repo/source/Lib/EncoderLib/WeightPredAnalysis.cpp" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/WeightPredAnalysis.cpp.o" "gcc" "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/WeightPredAnalysis.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_split_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
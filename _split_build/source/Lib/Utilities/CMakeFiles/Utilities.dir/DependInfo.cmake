@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/Lib/Utilities/VideoIOYuv.cpp" "source/Lib/Utilities/CMakeFiles/Utilities.dir/VideoIOYuv.cpp.o" "gcc" "source/Lib/Utilities/CMakeFiles/Utilities.dir/VideoIOYuv.cpp.o.d"
+  "/root/repo/source/Lib/Utilities/program_options_lite.cpp" "source/Lib/Utilities/CMakeFiles/Utilities.dir/program_options_lite.cpp.o" "gcc" "source/Lib/Utilities/CMakeFiles/Utilities.dir/program_options_lite.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_split_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/umake/gcc-12.2/x86_64/release/libUtilities.a"
+  "/root/repo/lib/umake/gcc-12.2/x86_64/release/libUtilities.pdb"
+  "CMakeFiles/Utilities.dir/VideoIOYuv.cpp.o"
+  "CMakeFiles/Utilities.dir/VideoIOYuv.cpp.o.d"
+  "CMakeFiles/Utilities.dir/program_options_lite.cpp.o"
+  "CMakeFiles/Utilities.dir/program_options_lite.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Utilities.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
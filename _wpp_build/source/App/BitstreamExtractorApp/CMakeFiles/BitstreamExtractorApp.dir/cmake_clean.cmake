@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/BitstreamExtractorApp"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/BitstreamExtractorApp.pdb"
+  "CMakeFiles/BitstreamExtractorApp.dir/BitstreamExtractorApp.cpp.o"
+  "CMakeFiles/BitstreamExtractorApp.dir/BitstreamExtractorApp.cpp.o.d"
+  "CMakeFiles/BitstreamExtractorApp.dir/BitstreamExtractorAppCfg.cpp.o"
+  "CMakeFiles/BitstreamExtractorApp.dir/BitstreamExtractorAppCfg.cpp.o.d"
+  "CMakeFiles/BitstreamExtractorApp.dir/bitstreamextractormain.cpp.o"
+  "CMakeFiles/BitstreamExtractorApp.dir/bitstreamextractormain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BitstreamExtractorApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
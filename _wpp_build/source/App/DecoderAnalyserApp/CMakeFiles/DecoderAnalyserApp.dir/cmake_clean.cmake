@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/DecoderAnalyserApp"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/DecoderAnalyserApp.pdb"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecApp.cpp.o"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecApp.cpp.o.d"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecAppCfg.cpp.o"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/DecAppCfg.cpp.o.d"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/decmain.cpp.o"
+  "CMakeFiles/DecoderAnalyserApp.dir/__/DecoderApp/decmain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DecoderAnalyserApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,83 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/Lib/CommonLib/AdaptiveLoopFilter.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/AdaptiveLoopFilter.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/AdaptiveLoopFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/AffineGradientSearch.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/AffineGradientSearch.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/AffineGradientSearch.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ApproxFilterBank.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ApproxFilterBank.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ApproxFilterBank.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/BitStream.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/BitStream.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/BitStream.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Buffer.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Buffer.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Buffer.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/CacheModel.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/CacheModel.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/CacheModel.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ChromaFormat.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ChromaFormat.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ChromaFormat.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/CodingStructure.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/CodingStructure.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/CodingStructure.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ContextModelling.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ContextModelling.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ContextModelling.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Contexts.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Contexts.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Contexts.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/DepQuant.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DepQuant.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DepQuant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/HRD.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/HRD.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/HRD.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Hash.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Hash.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Hash.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/IbcHashMap.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/IbcHashMap.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/IbcHashMap.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/InterPrediction.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/InterPrediction.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/InterPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/InterpolationFilter.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/InterpolationFilter.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/InterpolationFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/IntraPrediction.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/IntraPrediction.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/IntraPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/LoopFilter.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/LoopFilter.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/LoopFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/MCTS.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/MCTS.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/MCTS.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/MatrixIntraPrediction.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/MatrixIntraPrediction.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/MatrixIntraPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Mv.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Mv.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Mv.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/OpCounter.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/OpCounter.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/OpCounter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ParameterSetManager.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ParameterSetManager.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ParameterSetManager.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/PicYuvMD5.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/PicYuvMD5.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/PicYuvMD5.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Picture.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Picture.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Picture.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ProfileLevelTier.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ProfileLevelTier.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/ProfileLevelTier.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Quant.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Quant.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Quant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/QuantRDOQ.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/QuantRDOQ.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/QuantRDOQ.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RdCost.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RdCost.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RdCost.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RdCostWeightPrediction.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RdCostWeightPrediction.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RdCostWeightPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Reshape.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Reshape.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Reshape.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Rom.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Rom.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Rom.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RomLFNST.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RomLFNST.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RomLFNST.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RomTr.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RomTr.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/RomTr.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/SEI.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SEI.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SEI.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/SampleAdaptiveOffset.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SampleAdaptiveOffset.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SampleAdaptiveOffset.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/SearchWindowModel.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SearchWindowModel.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/SearchWindowModel.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Slice.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Slice.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Slice.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/TrQuant.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/TrQuant.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/TrQuant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/TrQuant_EMT.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/TrQuant_EMT.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/TrQuant_EMT.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Unit.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Unit.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/Unit.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/UnitPartitioner.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/UnitPartitioner.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/UnitPartitioner.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/UnitTools.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/UnitTools.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/UnitTools.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/WeightPrediction.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/WeightPrediction.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/WeightPrediction.cpp.o.d"
+  "/root/repo/source/Lib/libmd5/libmd5.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/__/libmd5/libmd5.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/__/libmd5/libmd5.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/dtrace.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/dtrace.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/dtrace.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/dtrace_blockstatistics.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/dtrace_blockstatistics.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/dtrace_blockstatistics.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/CommonDefX86.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/CommonDefX86.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/CommonDefX86.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/InitX86.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/InitX86.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/InitX86.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/AdaptiveLoopFilter_avx.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/AdaptiveLoopFilter_avx.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/AdaptiveLoopFilter_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/AffineGradientSearch_avx.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/AffineGradientSearch_avx.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/AffineGradientSearch_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/Buffer_avx.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/Buffer_avx.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/Buffer_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/InterpolationFilter_avx.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/InterpolationFilter_avx.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/InterpolationFilter_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/RdCost_avx.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/RdCost_avx.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx/RdCost_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/AdaptiveLoopFilter_avx2.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/AdaptiveLoopFilter_avx2.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/AdaptiveLoopFilter_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/AffineGradientSearch_avx2.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/AffineGradientSearch_avx2.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/AffineGradientSearch_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/Buffer_avx2.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/Buffer_avx2.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/Buffer_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/InterpolationFilter_avx2.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/InterpolationFilter_avx2.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/InterpolationFilter_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/RdCost_avx2.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/RdCost_avx2.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/avx2/RdCost_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/AdaptiveLoopFilter_sse41.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/AdaptiveLoopFilter_sse41.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/AdaptiveLoopFilter_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/AffineGradientSearch_sse41.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/AffineGradientSearch_sse41.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/AffineGradientSearch_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/Buffer_sse41.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/Buffer_sse41.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/Buffer_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/InterpolationFilter_sse41.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/InterpolationFilter_sse41.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/InterpolationFilter_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/RdCost_sse41.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/RdCost_sse41.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse41/RdCost_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse42/IbcHashmap_sse42.cpp" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse42/IbcHashmap_sse42.cpp.o" "gcc" "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/x86/sse42/IbcHashmap_sse42.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/umake/gcc-12.2/x86_64/release/libEncoderLib.a"
+)
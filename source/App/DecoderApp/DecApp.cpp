@@ -113,6 +113,11 @@ uint32_t DecApp::decode()
   // create & initialize internal classes
   xCreateDecLib();
 
+  if( m_asyncIOFrames > 0 && !m_reconFileName.empty() )
+  {
+    m_reconWriter.open( m_asyncIOFrames );
+  }
+
   m_iPOCLastDisplay += m_iSkipFrame;      // set the last displayed POC correctly for skip forward.
 
   // clear contents of colour-remap-information-SEI output file
@@ -443,12 +448,9 @@ void DecApp::xCreateDecLib()
   m_cDecLib.create();
 
   // initialize decoder class
-  m_cDecLib.init(
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-    m_cacheCfgFile
-#endif
-  );
+  m_cDecLib.init( m_cacheCfgFile );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cDecLib.setNumLoopFilterThreads(m_numLoopFilterThreads);
 
 
   if (!m_outputDecodedSEIMessagesFilename.empty())
@@ -470,6 +472,7 @@ void DecApp::xDestroyDecLib()
 {
   if( !m_reconFileName.empty() )
   {
+    m_reconWriter.close();
     for( auto & recFile : m_cVideoIOYuvReconFile )
     {
       recFile.second.close();
@@ -563,14 +566,20 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
 
           if (display)
           {
-            m_cVideoIOYuvReconFile[pcPicTop->layerId].write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                          m_outputColourSpaceConvert,
-                                          false, // TODO: m_packedYUVMode,
-                                          conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          NUM_CHROMA_FORMAT, isTff );
+            VideoIOYuv& recFile = m_cVideoIOYuvReconFile[pcPicTop->layerId];
+            const int   confLeft   = conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() );
+            const int   confRight  = conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() );
+            const int   confTop    = conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() );
+            const int   confBottom = conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() );
+            m_reconWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+              [this, &recFile, confLeft, confRight, confTop, confBottom, isTff]( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot )
+            {
+              recFile.write( picTop, picBot,
+                             m_outputColourSpaceConvert,
+                             false, // TODO: m_packedYUVMode,
+                             confLeft, confRight, confTop, confBottom,
+                             NUM_CHROMA_FORMAT, isTff );
+            } );
           }
         }
         writeLineToOutputLog(pcPicTop);
@@ -619,18 +628,25 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           ChromaFormat chromaFormatIDC = sps->getChromaFormatIdc();
           if( m_upscaledOutput )
           {
+            // the upscaling needs the parameter sets of the picture, so it is done here after the queued frames
+            m_reconWriter.flush();
             m_cVideoIOYuvReconFile[pcPic->layerId].writeUpscaledPicture( *sps, *pcPic->cs->pps, pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode, m_upscaledOutput, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
           }
           else
           {
-            m_cVideoIOYuvReconFile[pcPic->layerId].write( pcPic->getRecoBuf().get( COMPONENT_Y ).width, pcPic->getRecoBuf().get( COMPONENT_Y ).height, pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+            VideoIOYuv& recFile = m_cVideoIOYuvReconFile[pcPic->layerId];
+            const int   confLeft   = conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC );
+            const int   confRight  = conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC );
+            const int   confTop    = conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC );
+            const int   confBottom = conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC );
+            m_reconWriter.write( pcPic->getRecoBuf(), [this, &recFile, confLeft, confRight, confTop, confBottom]( const CPelUnitBuf& pic )
+            {
+              recFile.write( pic.get( COMPONENT_Y ).width, pic.get( COMPONENT_Y ).height, pic,
+                             m_outputColourSpaceConvert,
+                             m_packedYUVMode,
+                             confLeft, confRight, confTop, confBottom,
+                             NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+            } );
             }
         }
         writeLineToOutputLog(pcPic);
@@ -688,14 +704,20 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
           const Window &conf = pcPicTop->cs->pps->getConformanceWindow();
           const bool    isTff   = pcPicTop->topField;
 
-          m_cVideoIOYuvReconFile[pcPicTop->layerId].write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        false, // TODO: m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        NUM_CHROMA_FORMAT, isTff );
+          VideoIOYuv& recFile = m_cVideoIOYuvReconFile[pcPicTop->layerId];
+          const int   confLeft   = conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() );
+          const int   confRight  = conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() );
+          const int   confTop    = conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() );
+          const int   confBottom = conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() );
+          m_reconWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+            [this, &recFile, confLeft, confRight, confTop, confBottom, isTff]( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot )
+          {
+            recFile.write( picTop, picBot,
+                           m_outputColourSpaceConvert,
+                           false, // TODO: m_packedYUVMode,
+                           confLeft, confRight, confTop, confBottom,
+                           NUM_CHROMA_FORMAT, isTff );
+          } );
         }
         writeLineToOutputLog(pcPicTop);
         writeLineToOutputLog(pcPicBottom);
@@ -752,18 +774,25 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
           ChromaFormat chromaFormatIDC = sps->getChromaFormatIdc();
           if( m_upscaledOutput )
           {
+            // the upscaling needs the parameter sets of the picture, so it is done here after the queued frames
+            m_reconWriter.flush();
             m_cVideoIOYuvReconFile[pcPic->layerId].writeUpscaledPicture( *sps, *pcPic->cs->pps, pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode, m_upscaledOutput, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
           }
           else
           {
-            m_cVideoIOYuvReconFile[pcPic->layerId].write( pcPic->getRecoBuf().get( COMPONENT_Y ).width, pcPic->getRecoBuf().get( COMPONENT_Y ).height, pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+            VideoIOYuv& recFile = m_cVideoIOYuvReconFile[pcPic->layerId];
+            const int   confLeft   = conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC );
+            const int   confRight  = conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC );
+            const int   confTop    = conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC );
+            const int   confBottom = conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC );
+            m_reconWriter.write( pcPic->getRecoBuf(), [this, &recFile, confLeft, confRight, confTop, confBottom]( const CPelUnitBuf& pic )
+            {
+              recFile.write( pic.get( COMPONENT_Y ).width, pic.get( COMPONENT_Y ).height, pic,
+                             m_outputColourSpaceConvert,
+                             m_packedYUVMode,
+                             confLeft, confRight, confTop, confBottom,
+                             NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+            } );
             }
         }
         writeLineToOutputLog(pcPic);
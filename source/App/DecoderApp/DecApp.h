@@ -43,6 +43,7 @@
 #endif // _MSC_VER > 1000
 
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
 #include "DecAppCfg.h"
@@ -61,6 +62,7 @@ private:
   // class interface
   DecLib          m_cDecLib;                     ///< decoder class
   std::unordered_map<int, VideoIOYuv>      m_cVideoIOYuvReconFile;        ///< reconstruction YUV class
+  VideoIOYuvAsyncWriter                    m_reconWriter;                 ///< background reconstruction output
 
   // for output control
   int             m_iPOCLastDisplay;              ///< last POC in display order
@@ -107,9 +107,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("TraceRule",                 sTracingRule,                         string( "" ), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")" )
   ("TraceFile",                 sTracingFile,                         string( "" ), "Tracing file" )
 #endif
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   ("CacheCfg",                  m_cacheCfgFile,                       string( "" ), "CacheCfg File" )
-#endif
 #if RExt__DECODER_DEBUG_STATISTICS
   ("Stats",                     m_statMode,                           3,           "Control decoder debugging statistic output mode\n"
                                                                                    "\t0: disable statistic\n"
@@ -120,6 +118,8 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
   ("targetSubPicIdx",          m_targetSubPicIdx,                     0,           "Specify which subpicture shall be written to output, using subpic index, 0: disabled, subpicIdx=m_targetSubPicIdx-1 \n" )
   ( "UpscaledOutput",          m_upscaledOutput,                          0,       "Upscaled output for RPR" )
+  ("NumLoopFilterThreads",     m_numLoopFilterThreads,                1,           "Number of threads filtering the CTU lines of a picture in the deblocking filter and the CTUs in SAO (requires OpenMP)")
+  ("AsyncIOFrames",            m_asyncIOFrames,                       0,           "Number of decoded frames queued for writing by a background thread (0: synchronous output)")
   ;
 
   po::setDefaults(opts);
@@ -170,6 +170,18 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
+  if (m_numLoopFilterThreads < 1)
+  {
+    msg( ERROR, "Number of loop filter threads cannot be smaller than 1\n");
+    return false;
+  }
+
+  if (m_asyncIOFrames < 0)
+  {
+    msg( ERROR, "Number of asynchronous I/O frames cannot be negative\n");
+    return false;
+  }
+
   if (m_bitstreamFileName.empty())
   {
     msg( ERROR, "No input file specified, aborting\n");
@@ -245,6 +257,8 @@ DecAppCfg::DecAppCfg()
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_numLoopFilterThreads(1)
+, m_asyncIOFrames(0)
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
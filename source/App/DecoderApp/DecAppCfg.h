@@ -85,6 +85,8 @@ protected:
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
+  int           m_numLoopFilterThreads;               ///< number of threads of the CTU-line parallel deblocking filter
+  int           m_asyncIOFrames;                      ///< number of output frames queued for the background writer, 0: synchronous output
 public:
   DecAppCfg();
   virtual ~DecAppCfg();
@@ -626,6 +626,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
   m_cEncLib.setMinSearchWindow                                   ( m_minSearchWindow );
   m_cEncLib.setRestrictMESampling                                ( m_bRestrictMESampling );
+  m_cEncLib.setApproxCfg                                         ( m_approxCfg );
+  m_cEncLib.setSearchWindowCfg                                   ( m_searchWindowCfg );
 
   //====== Quality control ========
   m_cEncLib.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
@@ -1074,6 +1076,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cEncLib.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cEncLib.setSummaryVerboseness                                ( m_summaryVerboseness );
+  m_cEncLib.setCacheCfgFile                                      ( m_cacheCfgFile );
   m_cEncLib.setIMV                                               ( m_ImvMode );
   m_cEncLib.setIMV4PelFast                                       ( m_Imv4PelFast );
   m_cEncLib.setDecodeBitstream                                   ( 0, m_decodeBitstreams[0] );
@@ -1089,6 +1092,13 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
 #endif
+#if ENABLE_WPP_PARALLELISM
+  m_cEncLib.setNumWppThreads                                     ( m_numWppThreads );
+  m_cEncLib.setNumWppExtraLines                                  ( m_numWppExtraLines );
+  m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+#endif
+  m_cEncLib.setNumLoopFilterThreads                              ( m_numLoopFilterThreads );
   m_cEncLib.setUseALF                                            ( m_alf );
   m_cEncLib.setUseCCALF                                          ( m_ccalf );
   m_cEncLib.setCCALFQpThreshold                                  ( m_ccalfQpThreshold );
@@ -1161,6 +1171,10 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
       }
     }
     m_cVideoIOYuvReconFile.open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth );  // write mode
+    if( m_asyncIOFrames > 0 )
+    {
+      m_reconWriter.open( m_asyncIOFrames );
+    }
   }
 
   // create the encoder
@@ -1176,6 +1190,8 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
 void EncApp::xDestroyLib()
 {
   // Video I/O
+  m_inputReader.close();
+  m_reconWriter.close();
   m_cVideoIOYuvInputFile.close();
   m_cVideoIOYuvReconFile.close();
 
@@ -1233,7 +1249,18 @@ void EncApp::createLib( const int layerIdx )
     m_temporalFilter.init( m_FrameSkip, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth, m_iSourceWidth, m_iSourceHeight,
       m_aiPad, m_bClipInputVideoToRec709Range, m_inputFileName, m_chromaFormatIDC,
       m_inputColourSpaceConvert, m_iQP, m_gopBasedTemporalFilterStrengths,
-      m_gopBasedTemporalFilterFutureReference );
+      m_gopBasedTemporalFilterFutureReference, m_gopBasedTemporalFilterNumThreads );
+  }
+
+  // prefetch the input frames, temporal subsampling and 360 video read the file directly
+#if EXTENSION_360_VIDEO
+  if( m_asyncIOFrames > 0 && m_temporalSubsampleRatio == 1 && !m_ext360->isEnabled() )
+#else
+  if( m_asyncIOFrames > 0 && m_temporalSubsampleRatio == 1 )
+#endif
+  {
+    const int maxFrames = m_isField ? m_framesToBeEncoded >> 1 : m_framesToBeEncoded;
+    m_inputReader.open( m_cVideoIOYuvInputFile, unitArea, m_asyncIOFrames, maxFrames, m_inputColourSpaceConvert, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
   }
 }
 
@@ -1282,6 +1309,11 @@ bool EncApp::encodePrep( bool& eos )
   const InputColourSpaceConversion snrCSC = ( !m_snrInternalColourSpace ) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
   // read input YUV file
+  if( m_inputReader.isOpen() )
+  {
+    m_inputReader.read( *m_orgPic, *m_trueOrgPic );
+  }
+  else
 #if EXTENSION_360_VIDEO
   if( m_ext360->isEnabled() )
   {
@@ -1292,7 +1324,9 @@ bool EncApp::encodePrep( bool& eos )
     m_cVideoIOYuvInputFile.read( *m_orgPic, *m_trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
   }
 #else
-  m_cVideoIOYuvInputFile.read( *m_orgPic, *m_trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+  {
+    m_cVideoIOYuvInputFile.read( *m_orgPic, *m_trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+  }
 #endif
 
   if( m_gopBasedTemporalFilterEnabled )
@@ -1307,7 +1341,7 @@ bool EncApp::encodePrep( bool& eos )
   eos = ( m_isField && ( m_iFrameRcvd == ( m_framesToBeEncoded >> 1 ) ) ) || ( !m_isField && ( m_iFrameRcvd == m_framesToBeEncoded ) );
 
   // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-  if( m_cVideoIOYuvInputFile.isEof() )
+  if( m_inputReader.isOpen() ? m_inputReader.isEof() : m_cVideoIOYuvInputFile.isEof() )
   {
     m_flush = true;
     eos = true;
@@ -1403,10 +1437,13 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList )
 
       if (!m_reconFileName.empty())
       {
-        m_cVideoIOYuvReconFile.write( *pcPicYuvRecTop, *pcPicYuvRecBottom,
-                                      ipCSC,
-                                      false, // TODO: m_packedYUVMode,
-                                      m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        m_reconWriter.write( *pcPicYuvRecTop, *pcPicYuvRecBottom, [this, ipCSC]( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot )
+        {
+          m_cVideoIOYuvReconFile.write( picTop, picBot,
+                                        ipCSC,
+                                        false, // TODO: m_packedYUVMode,
+                                        m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        } );
       }
     }
   }
@@ -1422,12 +1459,17 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList )
           const SPS& sps = *m_cEncLib.getSPS( 0 );
           const PPS& pps = *m_cEncLib.getPPS( ( sps.getMaxPicWidthInLumaSamples() != pcPicYuvRec->get( COMPONENT_Y ).width || sps.getMaxPicHeightInLumaSamples() != pcPicYuvRec->get( COMPONENT_Y ).height ) ? ENC_PPS_ID_RPR : 0 );
 
+          // the upscaling needs the parameter sets, which may change, so it is done here after the queued frames
+          m_reconWriter.flush();
           m_cVideoIOYuvReconFile.writeUpscaledPicture( sps, pps, *pcPicYuvRec, ipCSC, m_packedYUVMode, m_cEncLib.getUpscaledOutput(), NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
         else
         {
-          m_cVideoIOYuvReconFile.write( pcPicYuvRec->get( COMPONENT_Y ).width, pcPicYuvRec->get( COMPONENT_Y ).height, *pcPicYuvRec, ipCSC, m_packedYUVMode,
-            m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          m_reconWriter.write( *pcPicYuvRec, [this, ipCSC]( const CPelUnitBuf& pic )
+          {
+            m_cVideoIOYuvReconFile.write( pic.get( COMPONENT_Y ).width, pic.get( COMPONENT_Y ).height, pic, ipCSC, m_packedYUVMode,
+              m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          } );
         }
       }
     }
@@ -43,6 +43,7 @@
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "CommonLib/NAL.h"
 #include "EncAppCfg.h"
 #if EXTENSION_360_VIDEO
@@ -71,6 +72,8 @@ private:
   EncLib            m_cEncLib;                    ///< encoder class
   VideoIOYuv        m_cVideoIOYuvInputFile;       ///< input YUV file
   VideoIOYuv        m_cVideoIOYuvReconFile;       ///< output reconstruction file
+  VideoIOYuvAsyncReader m_inputReader;            ///< input frame prefetching
+  VideoIOYuvAsyncWriter m_reconWriter;            ///< background reconstruction output
   int               m_iFrameRcvd;                 ///< number of received frames
   uint32_t          m_essentialBytes;
   uint32_t          m_totalBytes;
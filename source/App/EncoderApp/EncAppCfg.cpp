@@ -778,6 +778,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("CacheCfg",                                        m_cacheCfgFile,                                string(""), "Reference memory cache model configuration file, e.g. cfg/CacheCfg/cache_l1l2.cfg. If empty, the model is disabled.")
   ("Verbosity,v",                                     m_verbosity,                               (int)VERBOSE, "Specifies the level of the verboseness")
 
 #if JVET_O0756_CONFIG_HDRMETRICS || JVET_O0756_CALCULATE_HDRMETRICS
@@ -1169,7 +1170,17 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("DeblockingFilterMetric",                          m_DeblockingFilterMetric,                         false)
 #endif
   // Coding tools
-  ("fme_filter_ntaps",                                LabUCPel::ntaps_filter,                              8, "Approximate Filters")
+  ("fme_filter_ntaps",                                m_approxCfg.fmeFilterNumTaps,                        8, "Approximate Filters")
+  ("fme_filter_policy_file",                          m_approxCfg.fmeFilterPolicyFile,             string(""), "Rule file for per-block selection of approximate FME filters")
+  ("fme_filter_bank_file",                            m_approxCfg.fmeFilterBankFile,               string(""), "Coefficient file replacing the built-in approximate luma/chroma filters")
+  ("mc_prescreen_luma_ntaps",                         m_approxCfg.mcPrescreenLumaNumTaps,                  8, "Luma filter taps of the merge/affine candidate predictions ranked by SATD, the tested modes use exact MC (2, 4, 6 or 8)")
+  ("mc_prescreen_chroma_ntaps",                       m_approxCfg.mcPrescreenChromaNumTaps,                4, "Chroma filter taps of the merge/affine candidate predictions ranked by SATD, the tested modes use exact MC (2 or 4)")
+  ("fme_plane_cache_mb",                              m_approxCfg.fmePlaneCacheSizeMB,                     0, "Memory budget (MB) per search instance for precomputed fractional-sample reference planes (0: off)")
+  ("search_window_model",                             m_searchWindowCfg.enable,                        false, "Report the external bandwidth of a per-CTU luma search window buffer for each frame")
+  ("search_window_margin_hor",                        m_searchWindowCfg.marginHor,                         0, "Search window extension left and right of the CTU in luma samples (0: SearchRange + 8)")
+  ("search_window_margin_ver",                        m_searchWindowCfg.marginVer,                         0, "Search window extension above and below the CTU in luma samples (0: SearchRange + 8)")
+  ("search_window_ctu_reuse",                         m_searchWindowCfg.ctuReuse,                       true, "Keep the overlap with the search window of the previous CTU instead of reloading the whole window")
+  ("search_window_clamp",                             m_searchWindowCfg.clampSearch,                   false, "Restrict the motion search to positions whose interpolation support lies in the search window")
 
   ("ReconBasedCrossCPredictionEstimate",              m_reconBasedCrossCPredictionEstimate,             false, "When determining the alpha value for cross-component prediction, use the decoded residual rather than the pre-transform encoder-side residual")
   ("TransformSkip",                                   m_useTransformSkip,                               false, "Intra transform skipping")
@@ -1455,10 +1466,13 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("DecodeBitstream2ModPOCAndType",                   m_bs2ModPOCAndType,                       false, "Modify POC and NALU-type of second input bitstream, to use second BS as closing I-slice")
   ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to parallelize splitting")
   ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Force single thread execution even if taking the parallelized path")
-  ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization")
+  ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization (CTU lines with WaveFrontSynchro, tiles otherwise)")
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
   ("DebugCTU",                                        m_debugCTU,                                  -1, "If DebugBitstream is present, load frames up to this POC from this bitstream. Starting with DebugPOC-frame at CTUline containin debug CTU.")
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
+  ("NumFrameThreads",                                 m_numFrameThreads,                            1, "Number of threads used to compress independent pictures of a GOP concurrently")
+  ("NumLoopFilterThreads",                            m_numLoopFilterThreads,                       1, "Number of threads used for the CTU-parallel deblocking and SAO and the CTU-parallel parts of the loop filter estimation (requires OpenMP)")
+  ("AsyncIOFrames",                                   m_asyncIOFrames,                              0, "Number of input frames prefetched and reconstructed frames queued for writing by background threads (0: synchronous file I/O)")
   ( "ALF",                                             m_alf,                                    true, "Adaptive Loop Filter\n" )
   ( "CCALF",                                           m_ccalf,                                  true, "Cross-component Adaptive Loop Filter" )
   ( "CCALFQpTh",                                       m_ccalfQpThreshold,                         37, "QP threshold above which encoder reduces CCALF usage")
@@ -1497,6 +1511,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   opts.addOptions()
     ("TemporalFilter",                                m_gopBasedTemporalFilterEnabled,          false,            "Enable GOP based temporal filter. Disabled per default")
     ("TemporalFilterFutureReference",                 m_gopBasedTemporalFilterFutureReference,   true,            "Enable referencing of future frames in the GOP based temporal filter. This is typically disabled for Low Delay configurations.")
+    ("TemporalFilterThreads",                         m_gopBasedTemporalFilterNumThreads,           1,            "Number of threads used by the GOP based temporal filter (requires OpenMP)")
     ("TemporalFilterStrengthFrame*",                  m_gopBasedTemporalFilterStrengths, std::map<int, double>(), "Strength for every * frame in GOP based temporal filter, where * is an integer."
                                                                                                                   " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95");
   // clang-format on
@@ -2713,8 +2728,52 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
 #endif
 
+#if ENABLE_WPP_PARALLELISM
+  xConfirmPara( m_numWppThreads < 1, "Number of WPP threads cannot be smaller than 1" );
+  xConfirmPara( m_numWppExtraLines != 0, "NumWppExtraLines is not supported, CTU lines are handed out to the WPP threads in order" );
+  xConfirmPara( m_numWppThreads > 1 && !m_entropyCodingSyncEnabledFlag && !m_picPartitionFlag, "NumWppThreads > 1 requires WaveFrontSynchro or multiple tiles" );
+  xConfirmPara( m_ensureWppBitEqual && !m_entropyCodingSyncEnabledFlag, "EnsureWppBitEqual requires WaveFrontSynchro" );
+  if( m_numWppThreads > 1 )
+  {
+#if ENABLE_SPLIT_PARALLELISM
+    xConfirmPara( m_numSplitThreads > 1, "Split and WPP parallelism cannot be combined" );
+#endif
+    xConfirmPara( m_RCEnableRateControl, "Rate control is not supported with NumWppThreads > 1" );
+    xConfirmPara( m_MCTSEncConstraint, "MCTSEncConstraint is not supported with NumWppThreads > 1" );
+    xConfirmPara( m_encDbOpt, "EncDbOpt is not supported with NumWppThreads > 1" );
+    xConfirmPara( m_PLTMode != 0, "PLT is not supported with NumWppThreads > 1" );
+#if ENABLE_QPA
+    xConfirmPara( m_bUsePerceptQPA, "PerceptQPA is not supported with NumWppThreads > 1" );
+#endif
+#if WCG_EXT && ER_CHROMA_QP_WCG_PPS
+    xConfirmPara( m_wcgChromaQpControl.isEnabled(), "WCGPPSEnable is not supported with NumWppThreads > 1" );
+#endif
+    xConfirmPara( !m_cacheCfgFile.empty(), "CacheCfg is not supported with NumWppThreads > 1" );
+    xConfirmPara( m_searchWindowCfg.enable, "search_window_model is not supported with NumWppThreads > 1" );
+  }
+  xConfirmPara( m_numFrameThreads < 1, "Number of frame threads cannot be smaller than 1" );
+  if( m_numFrameThreads > 1 )
+  {
+    xConfirmPara( m_numWppThreads > 1, "Frame and WPP parallelism cannot be combined" );
+#if ENABLE_SPLIT_PARALLELISM
+    xConfirmPara( m_numSplitThreads > 1, "Frame and split parallelism cannot be combined" );
+#endif
+    xConfirmPara( m_iGOPSize < 2, "NumFrameThreads > 1 requires a GOP of more than one picture" );
+    xConfirmPara( m_RCEnableRateControl, "Rate control is not supported with NumFrameThreads > 1" );
+    xConfirmPara( m_isField, "Field coding is not supported with NumFrameThreads > 1" );
+    xConfirmPara( m_compositeRefEnabled, "CompositeLTReference is not supported with NumFrameThreads > 1" );
+    xConfirmPara( m_maxLayers > 1, "Multi-layer coding is not supported with NumFrameThreads > 1" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(), "DebugBitstream is not supported with NumFrameThreads > 1" );
+    xConfirmPara( !m_cacheCfgFile.empty(), "CacheCfg is not supported with NumFrameThreads > 1" );
+    xConfirmPara( m_searchWindowCfg.enable, "search_window_model is not supported with NumFrameThreads > 1" );
+  }
+#else
   xConfirmPara( m_numWppThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numWppThreads has to be 1" );
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
+  xConfirmPara( m_numFrameThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numFrameThreads has to be 1" );
+#endif
+  xConfirmPara( m_numLoopFilterThreads < 1, "Number of loop filter threads cannot be smaller than 1" );
+  xConfirmPara( m_asyncIOFrames < 0, "Number of asynchronous I/O frames cannot be negative" );
 
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
@@ -2849,6 +2908,13 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_loopFilterCrTcOffsetDiv2 < -12 || m_loopFilterCrTcOffsetDiv2 > 12,          "Loop Filter Tc Offset div. 2 exceeds supported range (-12 to 12)" );
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
+  xConfirmPara( m_approxCfg.fmeFilterNumTaps < 2 || m_approxCfg.fmeFilterNumTaps > 8 || ( m_approxCfg.fmeFilterNumTaps & 1 ), "fme_filter_ntaps shall be 2, 4, 6 or 8" );
+  xConfirmPara( m_approxCfg.mcPrescreenLumaNumTaps < 2 || m_approxCfg.mcPrescreenLumaNumTaps > 8 || ( m_approxCfg.mcPrescreenLumaNumTaps & 1 ), "mc_prescreen_luma_ntaps shall be 2, 4, 6 or 8" );
+  xConfirmPara( m_approxCfg.mcPrescreenChromaNumTaps != 2 && m_approxCfg.mcPrescreenChromaNumTaps != 4,                "mc_prescreen_chroma_ntaps shall be 2 or 4" );
+  xConfirmPara( m_approxCfg.fmePlaneCacheSizeMB < 0,                                         "fme_plane_cache_mb shall not be negative" );
+  xConfirmPara( m_searchWindowCfg.marginHor != 0 && m_searchWindowCfg.marginHor < NTAPS_LUMA, "search_window_margin_hor shall be 0 or at least 8" );
+  xConfirmPara( m_searchWindowCfg.marginVer != 0 && m_searchWindowCfg.marginVer < NTAPS_LUMA, "search_window_margin_ver shall be 0 or at least 8" );
+  xConfirmPara( m_searchWindowCfg.clampSearch && !m_searchWindowCfg.enable,                   "search_window_clamp requires search_window_model" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
   xConfirmPara( m_iMaxDeltaQP > MAX_DELTA_QP,                                               "Absolute Delta QP exceeds supported range (0 to 7)" );
 #if ENABLE_QPA
@@ -3906,6 +3972,7 @@ bool EncAppCfg::xCheckParameter()
   if (m_gopBasedTemporalFilterEnabled)
   {
     xConfirmPara(m_temporalSubsampleRatio != 1, "GOP Based Temporal Filter only support Temporal sub-sample ratio 1");
+    xConfirmPara(m_gopBasedTemporalFilterNumThreads < 1, "Number of temporal filter threads cannot be smaller than 1");
   }
 #if EXTENSION_360_VIDEO
   check_failed |= m_ext360.verifyParameters();
@@ -4227,6 +4294,9 @@ void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "NumFrameThreads:%d ", m_numFrameThreads );
+  msg( VERBOSE, "NumLoopFilterThreads:%d ", m_numLoopFilterThreads );
+  msg( VERBOSE, "AsyncIOFrames:%d ", m_asyncIOFrames );
 
   if (m_resChangeInClvsEnabled)
   {
@@ -432,6 +432,9 @@ protected:
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numFrameThreads;
+  int       m_numLoopFilterThreads;
+  int       m_asyncIOFrames;
 
   int       m_log2MaxTbSize;
   // coding tools (bit-depth)
@@ -487,6 +490,8 @@ protected:
   int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
   bool      m_bClipForBiPredMeEnabled;                        ///< Enables clipping for Bi-Pred ME.
   bool      m_bFastMEAssumingSmootherMVEnabled;               ///< Enables fast ME assuming a smoother MV.
+  ApproxCfg m_approxCfg;                                      ///< settings of the approximate kernels
+  SearchWindowCfg m_searchWindowCfg;                          ///< settings of the search window model
   FastInterSearchMode m_fastInterSearchMode;                  ///< Parameter that controls fast encoder settings
   bool      m_bUseEarlyCU;                                    ///< flag for using Early CU setting
   bool      m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
@@ -714,6 +719,7 @@ protected:
   int       m_Imv4PelFast;                                    ///< imv 4-Pel fast mode
 
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
+  std::string m_cacheCfgFile;                                 ///< cache model configuration file
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
 
@@ -746,6 +752,7 @@ protected:
   bool                  m_gopBasedTemporalFilterEnabled;               ///< GOP-based Temporal Filter enable/disable
   bool                  m_gopBasedTemporalFilterFutureReference;       ///< Enable/disable future frame references in the GOP-based Temporal Filter
   std::map<int, double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
+  int                   m_gopBasedTemporalFilterNumThreads;            ///< Number of threads used by the GOP-based Temporal Filter
 
   int         m_maxLayers;
   int         m_targetOlsIdx;
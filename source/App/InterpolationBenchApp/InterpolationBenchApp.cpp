@@ -0,0 +1,290 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InterpolationBenchApp.cpp
+    \brief    Micro-benchmark of the motion compensation interpolation filters
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/InterpolationFilter.h"
+#ifdef TARGET_SIMD_X86
+#include "CommonLib/x86/CommonDefX86.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup InterpolationBenchApp
+//! \{
+
+/// one filter table as selected through the arguments of InterpolationFilter::filterHor/filterVer
+struct BenchFilter
+{
+  const char* name;
+  ComponentID compID;
+  int         frac;           ///< in units of the luma/chroma filter table
+  int         nFilterIdx;
+  bool        useAltHpelIf;
+  int         numTaps;        ///< n_taps_filter, selects the approximate luma/chroma set
+};
+
+static const BenchFilter g_benchFilters[] =
+{
+  { "luma8",         COMPONENT_Y,  4, 0, false, 8 },
+  { "luma6",         COMPONENT_Y,  4, 0, false, 6 },
+  { "luma4",         COMPONENT_Y,  4, 0, false, 4 },
+  { "luma2",         COMPONENT_Y,  4, 0, false, 2 },
+  { "lumaAltHpel",   COMPONENT_Y,  8, 0, true,  8 },
+  { "lumaBilinear",  COMPONENT_Y,  4, 1, false, 8 },
+  { "luma4x4",       COMPONENT_Y,  4, 2, false, 8 },
+  { "lumaRPR1",      COMPONENT_Y,  4, 3, false, 8 },
+  { "lumaRPR2",      COMPONENT_Y,  4, 4, false, 8 },
+  { "lumaAffRPR1",   COMPONENT_Y,  4, 5, false, 8 },
+  { "lumaAffRPR2",   COMPONENT_Y,  4, 6, false, 8 },
+  { "chroma",        COMPONENT_Cb, 3, 0, false, 8 },
+  { "chroma2",       COMPONENT_Cb, 3, 0, false, 2 },
+  { "chromaRPR1",    COMPONENT_Cb, 3, 3, false, 8 },
+  { "chromaRPR2",    COMPONENT_Cb, 3, 4, false, 8 },
+};
+
+static const int g_blockSizes[] = { 4, 8, 16, 32, 64, 128 };
+
+static const int MAX_BLOCK_SIZE = 128;
+static const int SRC_MARGIN     = 8;
+
+/// source of an interpolation kernel set, either the C++ reference or one SIMD level
+struct BenchIsa
+{
+  std::string          name;
+  InterpolationFilter* filter;
+};
+
+static inline uint64_t readCycles()
+{
+#ifdef TARGET_SIMD_X86
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static void runFilter( InterpolationFilter& ifFilter, const BenchFilter& bf, const bool isVer, const bool isFirst, const bool isLast,
+                       const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const ClpRng& clpRng )
+{
+  if( isVer )
+  {
+    ifFilter.filterVer( bf.compID, src, srcStride, dst, dstStride, width, height, bf.frac, isFirst, isLast, CHROMA_420, clpRng, bf.nFilterIdx, false, bf.useAltHpelIf, bf.numTaps );
+  }
+  else
+  {
+    ifFilter.filterHor( bf.compID, src, srcStride, dst, dstStride, width, height, bf.frac, isLast, CHROMA_420, clpRng, bf.nFilterIdx, false, bf.useAltHpelIf, bf.numTaps );
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  bool        doHelp        = false;
+  std::string outputFile;
+  int         bitDepth      = 10;
+  int         minSamples    = 1 << 20;
+  std::string filterName;
+  std::string filterBankFile;
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",               doHelp,        false,      "this help text")
+  ("Output,o",           outputFile,    string(""), "CSV output file name (default: stdout)")
+  ("BitDepth,d",         bitDepth,      10,         "internal bit depth of the source samples")
+  ("Samples,s",          minSamples,    1 << 20,    "number of output samples filtered per measurement")
+  ("Filter,f",           filterName,    string(""), "only run the named filter (e.g. luma4), default: all")
+  ("FilterBank,b",       filterBankFile, string(""), "coefficient file replacing the built-in approximate filters")
+  ;
+
+  po::setDefaults( opts );
+  po::ErrorReporter err;
+  const list<const char*>& argvUnhandled = po::scanArgv( opts, argc, ( const char** ) argv, err );
+  for( list<const char*>::const_iterator it = argvUnhandled.begin(); it != argvUnhandled.end(); it++ )
+  {
+    std::cerr << "Unhandled argument ignored: " << *it << std::endl;
+  }
+  if( doHelp )
+  {
+    po::doHelp( cout, opts );
+    return 0;
+  }
+  if( err.is_errored )
+  {
+    return 1;
+  }
+  if( bitDepth < 8 || bitDepth > 12 || minSamples <= 0 )
+  {
+    std::cerr << "Invalid BitDepth or Samples" << std::endl;
+    return 1;
+  }
+
+  FILE* out = stdout;
+  if( !outputFile.empty() )
+  {
+    out = fopen( outputFile.c_str(), "w" );
+    if( out == NULL )
+    {
+      std::cerr << "Error: could not open output file: " << outputFile << std::endl;
+      return 1;
+    }
+  }
+
+  ApproxFilterBank filterBank;
+  if( !filterBankFile.empty() )
+  {
+    try
+    {
+      filterBank.load( filterBankFile );
+    }
+    catch( Exception &e )
+    {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  // every kernel set gets its own InterpolationFilter, the constructor installs the C++ reference
+  std::vector<BenchIsa> isas;
+  InterpolationFilter scalarFilter;
+  isas.push_back( BenchIsa{ "scalar", &scalarFilter } );
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_MCIF
+  const X86_VEXT vext = read_x86_extension_flags();
+  InterpolationFilter sse41Filter, avxFilter, avx2Filter;
+  if( vext >= SSE41 )
+  {
+    sse41Filter._initInterpolationFilterX86<SSE41>();
+    isas.push_back( BenchIsa{ "SSE41", &sse41Filter } );
+  }
+  if( vext >= AVX )
+  {
+    avxFilter._initInterpolationFilterX86<AVX>();
+    isas.push_back( BenchIsa{ "AVX", &avxFilter } );
+  }
+  if( vext >= AVX2 )
+  {
+    avx2Filter._initInterpolationFilterX86<AVX2>();
+    isas.push_back( BenchIsa{ "AVX2", &avx2Filter } );
+  }
+#endif
+  for( BenchIsa& isa : isas )
+  {
+    isa.filter->setApproxFilterBank( &filterBank );
+  }
+
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bitDepth ) - 1;
+  clpRng.bd  = bitDepth;
+
+  const int srcStride = MAX_BLOCK_SIZE + 2 * SRC_MARGIN;
+  const int dstStride = MAX_BLOCK_SIZE;
+  std::vector<Pel> srcBuf( srcStride * srcStride );
+  std::vector<Pel> dstBuf( dstStride * MAX_BLOCK_SIZE );
+  srand( 1 );
+  for( Pel& s : srcBuf )
+  {
+    s = Pel( rand() & clpRng.max );
+  }
+  const Pel* src = &srcBuf[SRC_MARGIN * srcStride + SRC_MARGIN];
+
+  fprintf( out, "isa,filter,dir,isFirst,isLast,width,height,calls,msamples_per_s,cycles_per_sample\n" );
+
+  for( const BenchIsa& isa : isas )
+  {
+    for( const BenchFilter& bf : g_benchFilters )
+    {
+      if( !filterName.empty() && filterName != bf.name )
+      {
+        continue;
+      }
+      for( int dir = 0; dir < 2; dir++ )
+      {
+        const bool isVer = dir == 1;
+        for( int first = isVer ? 0 : 1; first < 2; first++ )
+        {
+          for( int last = 0; last < 2; last++ )
+          {
+            for( int width : g_blockSizes )
+            {
+              for( int height : g_blockSizes )
+              {
+                const int numCalls = std::max( 1, minSamples / ( width * height ) );
+
+                // warm up caches and branch predictors
+                runFilter( *isa.filter, bf, isVer, first != 0, last != 0, src, srcStride, &dstBuf[0], dstStride, width, height, clpRng );
+
+                const auto     startTime   = std::chrono::steady_clock::now();
+                const uint64_t startCycles = readCycles();
+                for( int i = 0; i < numCalls; i++ )
+                {
+                  runFilter( *isa.filter, bf, isVer, first != 0, last != 0, src, srcStride, &dstBuf[0], dstStride, width, height, clpRng );
+                }
+                const uint64_t cycles      = readCycles() - startCycles;
+                const double   seconds     = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+                const double   numSamples  = double( numCalls ) * width * height;
+
+                fprintf( out, "%s,%s,%s,%d,%d,%d,%d,%d,%.2f,%.3f\n", isa.name.c_str(), bf.name, isVer ? "ver" : "hor", first, last, width, height, numCalls,
+                         seconds > 0 ? numSamples / seconds * 1e-6 : 0.0, cycles / numSamples );
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if( out != stdout )
+  {
+    fclose( out );
+  }
+  return 0;
+}
+
+//! \}
@@ -66,6 +66,9 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
   m_filterCcAlf = filterBlkCcAlf<CC_ALF>;
   m_filter5x5Blk = filterBlk<ALF_FILTER_5>;
   m_filter7x7Blk = filterBlk<ALF_FILTER_7>;
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  m_updateCovariance = updateCovariance;
+#endif
 
 #if ENABLE_SIMD_OPT_ALF
 #ifdef TARGET_SIMD_X86
@@ -74,6 +77,29 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
 #endif
 }
 
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+void AdaptiveLoopFilter::updateCovariance( double* E, double* y, const Pel* eLocal, const int eLocalStride, const int numCoeff, const int numBins, const double yLocal, const double weight )
+{
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int l = k; l < numCoeff; l++ )
+    {
+      for( int b0 = 0; b0 < numBins; b0++ )
+      {
+        for( int b1 = 0; b1 < numBins; b1++ )
+        {
+          E[( ( b0 * MaxAlfNumClippingValues + b1 ) * MAX_NUM_ALF_LUMA_COEFF + k ) * MAX_NUM_ALF_LUMA_COEFF + l] += weight * ( eLocal[k * eLocalStride + b0] * (double)eLocal[l * eLocalStride + b1] );
+        }
+      }
+    }
+    for( int b = 0; b < numBins; b++ )
+    {
+      y[b * MAX_NUM_ALF_LUMA_COEFF + k] += weight * ( eLocal[k * eLocalStride + b] * yLocal );
+    }
+  }
+}
+#endif
+
 bool AdaptiveLoopFilter::isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad )
 {
   clipTop = false; clipBottom = false; clipLeft = false; clipRight = false;
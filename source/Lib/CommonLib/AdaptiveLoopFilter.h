@@ -141,6 +141,11 @@ public:
                          const short *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
 #endif
                          int vbPos);
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  // encoder statistics: add the weighted outer product of the clipped differences eLocal[coeff][bin] to E[bin][bin][coeff][coeff] (upper triangle) and y[bin][coeff]
+  static void updateCovariance( double* E, double* y, const Pel* eLocal, const int eLocalStride, const int numCoeff, const int numBins, const double yLocal, const double weight );
+  void (*m_updateCovariance)( double* E, double* y, const Pel* eLocal, const int eLocalStride, const int numCoeff, const int numBins, const double yLocal, const double weight );
+#endif
 
 #ifdef TARGET_SIMD_X86
   void initAdaptiveLoopFilterX86();
@@ -0,0 +1,263 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ApproxFilterBank.cpp
+    \brief    coefficient sets of the approximate interpolation filters
+*/
+
+#include "ApproxFilterBank.h"
+#include "InterpolationFilter.h"
+
+#include <fstream>
+#include <sstream>
+
+//! \ingroup CommonLib
+//! \{
+
+ApproxFilterBank::ApproxFilterBank()
+{
+  ::memcpy( m_lumaFilter, InterpolationFilter::m_lumaFilter, sizeof( m_lumaFilter ) );
+  for( int idx = 0; idx < N_APPROX_FILTERS; idx++ )
+  {
+    m_lumaKernelTaps[idx] = xGetKernelTaps( m_lumaFilter[idx][0], LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, NTAPS_LUMA );
+  }
+
+  // bilinear chroma approximation in 1/32 sample accuracy
+  ::memcpy( m_chromaFilter[0], InterpolationFilter::m_chromaFilter, sizeof( m_chromaFilter[0] ) );
+  for( int frac = 0; frac < CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS; frac++ )
+  {
+    m_chromaFilter[1][frac][0] = 0;
+    m_chromaFilter[1][frac][1] = 64 - 2 * frac;
+    m_chromaFilter[1][frac][2] = 2 * frac;
+    m_chromaFilter[1][frac][3] = 0;
+  }
+  for( int idx = 0; idx < N_APPROX_CHROMA_FILTERS; idx++ )
+  {
+    m_chromaKernelTaps[idx] = xGetKernelTaps( m_chromaFilter[idx][0], CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, NTAPS_CHROMA );
+  }
+}
+
+const ApproxFilterBank& ApproxFilterBank::getDefault()
+{
+  static const ApproxFilterBank defaultBank;
+  return defaultBank;
+}
+
+/**
+ * The bank file consists of sections starting with a header line naming the component and the tap count the
+ * section replaces, followed by one line of coefficients per phase (16 for luma, 32 for chroma). '#' starts a
+ * comment:
+ *
+ *   Luma 4
+ *   0 64 0 0
+ *   -2 63 4 -1
+ *   ...
+ *
+ * Luma 2, 4, 6 and Chroma 2 may be replaced, the normative sets Luma 8 and Chroma 4 are fixed. Sets not listed
+ * keep their built-in coefficients.
+ */
+void ApproxFilterBank::load( const std::string& fileName )
+{
+  std::ifstream file( fileName );
+  if( !file.is_open() )
+  {
+    THROW( "Cannot open approximate filter bank file " << fileName );
+  }
+
+  bool lumaLoaded  [N_APPROX_FILTERS]        = { false };
+  bool chromaLoaded[N_APPROX_CHROMA_FILTERS] = { false };
+
+  std::vector<TFilterCoeff> coeffs;
+  std::string  name;
+  bool         isLuma    = true;
+  int          numTaps   = 0;
+  int          numPhases = 0;
+  int          phase     = 0;
+
+  auto finishSection = [&]()
+  {
+    if( numTaps == 0 )
+    {
+      return;
+    }
+    CHECK( phase != numPhases, name << " has " << phase << " phases instead of " << numPhases << " in " << fileName );
+
+    const int maxTaps = isLuma ? NTAPS_LUMA : NTAPS_CHROMA;
+    xValidate( &coeffs[0], numPhases, maxTaps, numTaps, name + " in " + fileName );
+
+    if( isLuma )
+    {
+      const int idx = xLumaIdx( numTaps );
+      ::memcpy( m_lumaFilter[idx], &coeffs[0], sizeof( m_lumaFilter[idx] ) );
+      m_lumaKernelTaps[idx] = xGetKernelTaps( m_lumaFilter[idx][0], numPhases, maxTaps );
+    }
+    else
+    {
+      const int idx = xChromaIdx( numTaps );
+      ::memcpy( m_chromaFilter[idx], &coeffs[0], sizeof( m_chromaFilter[idx] ) );
+      m_chromaKernelTaps[idx] = xGetKernelTaps( m_chromaFilter[idx][0], numPhases, maxTaps );
+    }
+    numTaps = 0;
+  };
+
+  std::string line;
+  int lineNum = 0;
+  while( std::getline( file, line ) )
+  {
+    lineNum++;
+    const size_t commentPos = line.find( '#' );
+    if( commentPos != std::string::npos )
+    {
+      line.erase( commentPos );
+    }
+
+    std::istringstream tokens( line );
+    std::string first;
+    if( !( tokens >> first ) )
+    {
+      continue;
+    }
+
+    if( first == "Luma" || first == "Chroma" )
+    {
+      finishSection();
+
+      isLuma = first == "Luma";
+      CHECK( !( tokens >> numTaps ), "Missing tap count in line " << lineNum << " of " << fileName );
+      name = first + " " + std::to_string( numTaps );
+      if( isLuma )
+      {
+        CHECK( numTaps != 2 && numTaps != 4 && numTaps != 6, name << " cannot be replaced, only Luma 2, 4 and 6 are approximate (line " << lineNum << " of " << fileName << ")" );
+        CHECK( lumaLoaded[xLumaIdx( numTaps )], name << " defined twice in " << fileName );
+        lumaLoaded[xLumaIdx( numTaps )] = true;
+        numPhases = LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS;
+      }
+      else
+      {
+        CHECK( numTaps != 2, name << " cannot be replaced, only Chroma 2 is approximate (line " << lineNum << " of " << fileName << ")" );
+        CHECK( chromaLoaded[xChromaIdx( numTaps )], name << " defined twice in " << fileName );
+        chromaLoaded[xChromaIdx( numTaps )] = true;
+        numPhases = CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS;
+      }
+      std::string extra;
+      CHECK( tokens >> extra, "Unexpected '" << extra << "' in line " << lineNum << " of " << fileName );
+
+      // sets are stored centered in the layout of the normative filter
+      const int maxTaps = isLuma ? NTAPS_LUMA : NTAPS_CHROMA;
+      coeffs.assign( numPhases * maxTaps, 0 );
+      phase = 0;
+      continue;
+    }
+
+    CHECK( numTaps == 0, "Coefficients without Luma/Chroma header in line " << lineNum << " of " << fileName );
+    CHECK( phase >= numPhases, name << " has more than " << numPhases << " phases (line " << lineNum << " of " << fileName << ")" );
+
+    const int maxTaps = isLuma ? NTAPS_LUMA : NTAPS_CHROMA;
+    TFilterCoeff* row = &coeffs[phase * maxTaps + ( ( maxTaps - numTaps ) >> 1 )];
+    tokens.clear();
+    tokens.str( line );
+    for( int i = 0; i < numTaps; i++ )
+    {
+      int value;
+      CHECK( !( tokens >> value ), name << " expects " << numTaps << " coefficients in line " << lineNum << " of " << fileName );
+      CHECK( value < -128 || value > 127, "Coefficient " << value << " out of range in line " << lineNum << " of " << fileName );
+      row[i] = TFilterCoeff( value );
+    }
+    std::string extra;
+    CHECK( tokens >> extra, name << " expects " << numTaps << " coefficients in line " << lineNum << " of " << fileName );
+    phase++;
+  }
+  finishSection();
+}
+
+int ApproxFilterBank::xGetKernelTaps( const TFilterCoeff* coeff, const int numPhases, const int maxTaps )
+{
+  int kernelTaps = 2;
+  for( int phase = 0; phase < numPhases; phase++ )
+  {
+    for( int i = 0; i < maxTaps; i++ )
+    {
+      if( coeff[phase * maxTaps + i] != 0 )
+      {
+        // distance to the outer kernel boundary, the center pair sits at maxTaps / 2 - 1 and maxTaps / 2
+        const int reach = i < ( maxTaps >> 1 ) ? ( maxTaps >> 1 ) - i : i - ( maxTaps >> 1 ) + 1;
+        kernelTaps = std::max( kernelTaps, 2 * reach );
+      }
+    }
+  }
+  return kernelTaps;
+}
+
+/**
+ * A set is accepted if every phase has DC gain 64, phase 0 is the identity, phase p mirrors phase P - p and the
+ * intermediate result of the first filter stage fits into 16 bit. The latter holds independently of the bit depth
+ * as the first stage output is shifted to 14 bit precision: the sums of the positive and negative coefficients
+ * bound the excursion above the maximum and below zero.
+ */
+void ApproxFilterBank::xValidate( const TFilterCoeff* coeff, const int numPhases, const int maxTaps, const int numTaps, const std::string& name )
+{
+  const int maxPosSum = ( ( 1 << 15 ) - 1 + IF_INTERNAL_OFFS ) >> ( IF_INTERNAL_PREC - IF_FILTER_PREC );
+  const int maxNegSum = ( ( 1 << 15 ) - IF_INTERNAL_OFFS ) >> ( IF_INTERNAL_PREC - IF_FILTER_PREC );
+
+  for( int phase = 0; phase < numPhases; phase++ )
+  {
+    const TFilterCoeff* c = coeff + phase * maxTaps;
+    int sum = 0, posSum = 0, negSum = 0;
+    for( int i = 0; i < maxTaps; i++ )
+    {
+      sum += c[i];
+      ( c[i] > 0 ? posSum : negSum ) += c[i];
+    }
+    CHECK( sum != ( 1 << IF_FILTER_PREC ), name << ": phase " << phase << " sums to " << sum << " instead of " << ( 1 << IF_FILTER_PREC ) );
+    CHECK( posSum > maxPosSum, name << ": phase " << phase << " has positive coefficient sum " << posSum << " exceeding " << maxPosSum );
+    CHECK( -negSum > maxNegSum, name << ": phase " << phase << " has negative coefficient sum " << -negSum << " exceeding " << maxNegSum );
+
+    if( phase == 0 )
+    {
+      for( int i = 0; i < maxTaps; i++ )
+      {
+        CHECK( c[i] != ( i == ( maxTaps >> 1 ) - 1 ? 1 << IF_FILTER_PREC : 0 ), name << ": phase 0 shall be the identity" );
+      }
+    }
+    else
+    {
+      const TFilterCoeff* m = coeff + ( numPhases - phase ) * maxTaps;
+      for( int i = 0; i < maxTaps; i++ )
+      {
+        CHECK( c[i] != m[maxTaps - 1 - i], name << ": phase " << phase << " is not the mirror of phase " << numPhases - phase );
+      }
+    }
+  }
+}
+
+//! \}
@@ -0,0 +1,90 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ApproxFilterBank.h
+    \brief    coefficient sets of the approximate interpolation filters (header)
+*/
+
+#ifndef __APPROXFILTERBANK__
+#define __APPROXFILTERBANK__
+
+#include "CommonDef.h"
+#include "LabUCPel.h"
+
+#include <string>
+
+//! \ingroup CommonLib
+//! \{
+
+#define N_APPROX_CHROMA_FILTERS  2 ///< chroma sets selectable by tap count: 4 (normative), 2
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+ * Luma and chroma interpolation filter banks indexed by the requested tap count. The normative sets (8-tap luma,
+ * 4-tap chroma) are fixed, the approximate ones start from the built-in tables and may be replaced from a file.
+ * Every set is kept in the layout of the normative filter, together with the narrowest kernel covering all of
+ * its non-zero coefficients.
+ */
+class ApproxFilterBank
+{
+public:
+  ApproxFilterBank();
+
+  void load( const std::string& fileName );
+
+  static const ApproxFilterBank& getDefault();
+
+  /// coefficients of the kernel to run for the given luma tap count, to be used with getLumaKernelTaps()
+  const TFilterCoeff* getLumaFilter     ( const int numTaps, const int frac ) const { const int idx = xLumaIdx( numTaps ); return m_lumaFilter[idx][frac] + ( ( NTAPS_LUMA - m_lumaKernelTaps[idx] ) >> 1 ); }
+  int                 getLumaKernelTaps ( const int numTaps )                 const { return m_lumaKernelTaps[xLumaIdx( numTaps )]; }
+  const TFilterCoeff* getChromaFilter   ( const int numTaps, const int frac ) const { const int idx = xChromaIdx( numTaps ); return m_chromaFilter[idx][frac] + ( ( NTAPS_CHROMA - m_chromaKernelTaps[idx] ) >> 1 ); }
+  int                 getChromaKernelTaps( const int numTaps )                const { return m_chromaKernelTaps[xChromaIdx( numTaps )]; }
+
+private:
+  static int  xLumaIdx        ( const int numTaps ) { return 4 - ( numTaps >> 1 ); }
+  static int  xChromaIdx      ( const int numTaps ) { return 2 - ( numTaps >> 1 ); }
+  static int  xGetKernelTaps  ( const TFilterCoeff* coeff, const int numPhases, const int maxTaps );
+  static void xValidate       ( const TFilterCoeff* coeff, const int numPhases, const int maxTaps, const int numTaps, const std::string& name );
+
+  TFilterCoeff m_lumaFilter      [N_APPROX_FILTERS][LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][NTAPS_LUMA];
+  int          m_lumaKernelTaps  [N_APPROX_FILTERS];
+  TFilterCoeff m_chromaFilter    [N_APPROX_CHROMA_FILTERS][CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][NTAPS_CHROMA];
+  int          m_chromaKernelTaps[N_APPROX_CHROMA_FILTERS];
+};
+
+//! \}
+
+#endif // __APPROXFILTERBANK__
@@ -37,23 +37,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <memory.h>
 #include <inttypes.h>
-#define __STDC_FORMAT_MACROS
-#ifdef WIN32
-#define strdup _strdup
-#endif
+#include <limits>
 
 #include "Utilities/program_options_lite.h"
 #include "CacheModel.h"
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-
-#ifndef JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_ACCESS_INFO
-#define JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_ACCESS_INFO 0
-#endif
-#ifndef JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_FRAME
-#define JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_FRAME -1
-#endif
 
 enum CacheAddressMap
 {
@@ -64,174 +52,305 @@ enum CacheAddressMap
 
 namespace po = df::program_options_lite;
 
-void* cache_mem_align_malloc(int size, int alignSize)
+static int xCalcPower( int num )
 {
-  unsigned char *alignBuf;
-  unsigned char *buf = (unsigned char *)malloc(size + 2 * alignSize + sizeof(void **));
-  if (buf)
+  int power = -1;
+
+  for ( int i = 0 ; i < 32 ; i++ )
+  {
+    if ( num == (1 << i) )
+    {
+      power = i;
+      break;
+    }
+  }
+  if (power < 0)
   {
-    alignBuf = buf + alignSize + sizeof(void **);
-    alignBuf -= (intptr_t)alignBuf & (alignSize - 1);
-    *((void **)(alignBuf - sizeof(void **))) = buf;
-    return alignBuf;
+    THROW("non power of 2");
   }
-  return nullptr; // memory keep fail
+  return power;
+}
+
+static const char *CACHE_REPLACE_NAMES[NUM_CACHE_REPLACE] = { "PLRU", "LRU", "FIFO" };
+
+// ====================================================================================================================
+// CacheLevel
+// ====================================================================================================================
+
+CacheLevel::CacheLevel()
+  : m_lineSize    ( 0 )
+  , m_numCacheLine( 0 )
+  , m_numWay      ( 0 )
+  , m_replacement ( CACHE_REPLACE_PLRU )
+  , m_shift       ( 0 )
+  , m_treeDepth   ( 0 )
+  , m_stamp       ( 0 )
+{
 }
 
-void cache_mem_align_free(void *ptr)
+void CacheLevel::create( int lineSize, int numCacheLine, int numWay, int replacement )
 {
-  if ( ptr )
+  if ( lineSize <= 0 || numCacheLine <= 0 || numWay <= 0 )
   {
-    free(*(((void **)ptr) - 1));
+    THROW( "cache line size, number of cache lines and number of ways shall be positive" );
   }
+  if ( replacement < 0 || replacement >= NUM_CACHE_REPLACE )
+  {
+    THROW( "Unknown replacement policy " << replacement );
+  }
+  m_lineSize     = lineSize;
+  m_numCacheLine = numCacheLine;
+  m_numWay       = numWay;
+  m_replacement  = replacement;
+  m_shift        = xCalcPower( m_lineSize );
+  m_treeDepth    = m_replacement == CACHE_REPLACE_PLRU ? xCalcPower( m_numWay ) : 0;
+
+  const int cacheSize = m_numCacheLine * m_numWay;
+  m_addr      .assign( cacheSize, 0 );
+  m_poc       .assign( cacheSize, 0 );
+  m_comp      .assign( cacheSize, MAX_NUM_COMPONENT );
+  m_available .assign( cacheSize, false );
+  m_age       .assign( cacheSize, 0 );
+  m_treeStatus.assign( m_numCacheLine, 0 );
+  m_stamp = 0;
 }
 
-CacheModel::CacheModel()
+// clear cache status (set invalid for each entry)
+void CacheLevel::clear()
 {
-  m_cacheEnable       = false;
-  m_cacheEnableFilter = false;
-  m_cacheLineSize     = 0;
-  m_numCacheLine      = 0;
-  m_numWay            = 0;
-  m_cacheSize         = 0;
-  m_shift             = 0;
-  m_cacheAddr         = nullptr;
-  m_cachePoc          = nullptr;
-  m_cacheComp         = nullptr;
-  m_available         = nullptr;
-  m_refPoc            = 0;
-  m_base              = nullptr;
-  m_compID            = MAX_NUM_COMPONENT;
-  m_hitCount          = nullptr;
-  m_treeStatus        = nullptr;
-  m_missHitCount      = 0;
-  m_totalAccess       = 0;
-  m_hitCountSeq       = 0;
-  m_missHitCountSeq   = 0;
-  m_totalAccessSeq    = 0;
-  m_frameCount        = 0;
+  std::fill( m_available.begin(), m_available.end(), false );
+  std::fill( m_age.begin(), m_age.end(), 0 );
+  std::fill( m_treeStatus.begin(), m_treeStatus.end(), 0 );
+  m_stamp = 0;
 }
 
-CacheModel::~CacheModel()
+bool CacheLevel::access( size_t addr, int poc, ComponentID compID )
 {
+  const int entry = (int) (addr % m_numCacheLine);
+  const int pos   = entry * m_numWay;
+
+  m_stamp++;
+
+  // check cache hit in each way
+  for ( int way = 0 ; way < m_numWay ; way++ )
+  {
+    if ( m_available[pos + way] && m_addr[pos + way] == addr && m_poc[pos + way] == poc && m_comp[pos + way] == compID )
+    {
+      xUpdateStatus( entry, way, true );
+      return true;
+    }
+  }
+
+  // read data from the next level and update cache entry
+  const int way = xGetVictimWay( entry );
+  m_addr     [pos + way] = addr;
+  m_poc      [pos + way] = poc;
+  m_comp     [pos + way] = compID;
+  m_available[pos + way] = true;
+  xUpdateStatus( entry, way, false );
+
+  return false;
 }
 
-int CacheModel::xCalcPower( int num )
+void CacheLevel::printConfig( int level ) const
 {
-  int power = -1;
+  fprintf( stdout, "L%d cache line size %d, cache line number %d, way number %d, %s replacement\n", level + 1, m_lineSize, m_numCacheLine, m_numWay, CACHE_REPLACE_NAMES[m_replacement] );
+}
 
-  for ( int i = 0 ; i < 32 ; i++ )
+int CacheLevel::xGetVictimWay( int entry )
+{
+  // single way
+  if ( m_numWay == 1 )
   {
-    if ( num == (1 << i) )
+    return 0;
+  }
+  if ( m_replacement == CACHE_REPLACE_PLRU )
+  {
+    return xGetWayTreePLRU( entry );
+  }
+
+  // LRU and FIFO: fill invalid ways first, then replace the oldest one
+  const int pos    = entry * m_numWay;
+  int       victim = 0;
+  for ( int way = 0 ; way < m_numWay ; way++ )
+  {
+    if ( !m_available[pos + way] )
     {
-      power = i;
-      break;
+      return way;
+    }
+    if ( m_age[pos + way] < m_age[pos + victim] )
+    {
+      victim = way;
     }
   }
-  if (power < 0)
+  return victim;
+}
+
+void CacheLevel::xUpdateStatus( int entry, int way, bool hit )
+{
+  if ( m_numWay == 1 )
   {
-    THROW("non power of 2");
+    return;
   }
-  return power;
+  switch ( m_replacement )
+  {
+  case CACHE_REPLACE_PLRU:
+    xUpdatePLRUStatus( entry, way );
+    break;
+  case CACHE_REPLACE_LRU:
+    m_age[entry * m_numWay + way] = m_stamp;
+    break;
+  case CACHE_REPLACE_FIFO:
+    if ( !hit )
+    {
+      m_age[entry * m_numWay + way] = m_stamp;
+    }
+    break;
+  default:
+    THROW( "Unknown replacement policy " << m_replacement );
+  }
+}
+
+//-- PLRU
+
+int CacheLevel::xGetWayTreePLRU( int entry )
+{
+  int shift  = 0;
+  int way    = 0;
+  for ( int i = 0; i < m_treeDepth ; i++ )
+  {
+    int flag  = (m_treeStatus[ entry ] >> shift) & 0x1;
+    shift = (shift << 1) + flag + 1;
+    way   = (way << 1) | (flag ^ 0x1);
+  }
+
+  return way;
+}
+
+void CacheLevel::xUpdatePLRUStatus( int entry, int way )
+{
+  int val   = m_treeStatus[ entry ];
+  int shift = 0;
+
+  for ( int i = 0 ; i < m_treeDepth ; i++ )
+  {
+    int flag = (way >> (m_treeDepth - i - 1)) & 0x1;
+    val = (val & (~0 ^ (1 << shift))) | (flag << shift); // only set shift-th bit
+    shift = (shift << 1) + 2 - flag;
+  }
+
+  m_treeStatus[ entry ] = val;
+}
+
+// ====================================================================================================================
+// CacheModel
+// ====================================================================================================================
+
+CacheModel::CacheModel()
+{
+  m_cacheEnable       = false;
+  m_frameReport       = false;
+  m_numLevels         = 0;
+  m_cacheAddrMode     = CACHE_MODE_1D;
+  m_cacheBlkWidth     = 0;
+  m_cacheBlkHeight    = 0;
+  m_curPoc            = 0;
+  m_ctuAddr           = 0;
+  m_refPoc            = 0;
+  m_base              = nullptr;
+  m_compID            = MAX_NUM_COMPONENT;
+  m_picWidth          = 0;
+  m_frameCount        = 0;
+}
+
+CacheModel::~CacheModel()
+{
 }
 
 void CacheModel::xConfigure(const std::string& filename )
 {
+  int cacheLineSize, numCacheLine, numWay, replacement;
+  int l2CacheLineSize, l2NumCacheLine, l2NumWay, l2Replacement;
+
   po::Options opts;
   opts.addOptions()
-  ("CacheEnable",   m_cacheEnable,   false, "Cache Enable" )
-  ("CacheLineSize", m_cacheLineSize,   128, "Cache line size")
-  ("NumCacheLine",  m_numCacheLine,     32, "Number of cache line")
-  ("NumWay",        m_numWay,            4, "Number of way")
-  ("CacheAddrMode", m_cacheAddrMode,     0, "Address mapping mode 0 : linear address 1 : 2D address")
-  ("BlkWidth",      m_cacheBlkWidth,    32, "Block width in 2D address mode")
-  ("BlkHeight",     m_cacheBlkHeight,   16, "Block height in 2D address mode")
-  ("FrameReport",   m_frameReport,   false, "Report in each frame" )
+  ("CacheEnable",     m_cacheEnable,   false, "Cache Enable" )
+  ("CacheLineSize",   cacheLineSize,     128, "Cache line size")
+  ("NumCacheLine",    numCacheLine,       32, "Number of cache line")
+  ("NumWay",          numWay,              4, "Number of way")
+  ("Replacement",     replacement,         0, "Replacement policy 0 : tree PLRU 1 : LRU 2 : FIFO")
+  ("L2CacheLineSize", l2CacheLineSize,   512, "L2 cache line size")
+  ("L2NumCacheLine",  l2NumCacheLine,      0, "Number of L2 cache line (0 : no L2 cache)")
+  ("L2NumWay",        l2NumWay,            8, "Number of L2 way")
+  ("L2Replacement",   l2Replacement,       0, "L2 replacement policy 0 : tree PLRU 1 : LRU 2 : FIFO")
+  ("CacheAddrMode",   m_cacheAddrMode,     0, "Address mapping mode 0 : linear address 1 : 2D address")
+  ("BlkWidth",        m_cacheBlkWidth,    32, "Block width in 2D address mode")
+  ("BlkHeight",       m_cacheBlkHeight,   16, "Block height in 2D address mode")
+  ("FrameReport",     m_frameReport,   false, "Report in each frame" )
+  ("MapFile",         m_mapFileName, std::string( "" ), "Per CTU and reference picture statistics output file (CSV)" )
   ;
 
   po::setDefaults(opts);
   po::parseConfigFile( opts, filename );
 
-  if ( m_cacheLineSize > CACHE_MEM_ALIGN_SIZE )
+  if ( !m_cacheEnable )
   {
-    fprintf( stderr, "cache line size is bigger that memory alignment\n" );
-    fprintf( stderr, "This may lead mismatch among enviroments\n" );
+    return;
+  }
+
+  m_level[0].create( cacheLineSize, numCacheLine, numWay, replacement );
+  m_numLevels = 1;
+  if ( l2NumCacheLine > 0 )
+  {
+    if ( l2CacheLineSize < cacheLineSize )
+    {
+      THROW( "L2 cache line size shall not be smaller than L1 cache line size" );
+    }
+    m_level[1].create( l2CacheLineSize, l2NumCacheLine, l2NumWay, l2Replacement );
+    m_numLevels = 2;
   }
+
   if ( m_cacheAddrMode == CACHE_MODE_2D )
   {
     int blkSize = m_cacheBlkWidth * m_cacheBlkHeight;
-    if ( m_cacheLineSize % blkSize != 0 && blkSize % m_cacheLineSize ) {
+    if ( cacheLineSize % blkSize != 0 && blkSize % cacheLineSize ) {
       THROW("CacheLineSize shall be multiple of BlkWidth x BlkHeight or BlkWidth x BlkHeight shall be multiple of CacheLineSize in 2D mode");
     }
   }
+  else if ( m_cacheAddrMode != CACHE_MODE_1D )
+  {
+    THROW( "Unknown address mode " << m_cacheAddrMode );
+  }
 }
 
 // initilize cache information such as size
 void CacheModel::create(const std::string& cacheCfgFileName)
 {
-  bool init = cacheCfgFileName == "";
-
-  if (cacheCfgFileName.length() > 1000)
-  {
-    THROW("config file name for cache model is too long. It shall be < 1000\n");
-  }
-  if ( init )
+  if ( cacheCfgFileName.empty() )
   {
     return; // no cache config
   }
   xConfigure(cacheCfgFileName);
 
-  if ( !m_cacheEnable )
-  {
-    return;
-  }
-
-  // set parameters
-  m_cacheSize = m_numCacheLine * m_numWay;
-  // calc address calculation parameter
-  m_shift = xCalcPower( m_cacheLineSize );
-  // keep memory
-  m_cacheAddr  = new size_t [m_cacheSize];
-  m_cachePoc   = new int [m_cacheSize];
-  m_cacheComp  = new ComponentID [m_cacheSize];
-  m_available  = new bool  [m_cacheSize];
-  m_hitCount   = new int  [m_cacheSize];
-  // PLRU
-  m_treeDepth  = xCalcPower( m_numWay );
-  m_treeStatus = new int [m_numCacheLine];
-  if ( m_cacheLineSize > 0 && m_numCacheLine > 0 && m_numWay > 0 )
+  if ( m_cacheEnable && !m_mapFileName.empty() )
   {
-    m_cacheEnableFilter = true;
+    m_mapFile.open( m_mapFileName.c_str(), std::ios::out );
+    if ( !m_mapFile )
+    {
+      THROW( "Unable to open cache map file " << m_mapFileName );
+    }
+    m_mapFile << "frame,poc,ctu,refPoc,access,l1Miss,l2Miss,bandwidth" << std::endl;
   }
 }
 
 // free memory
 void CacheModel::destroy()
 {
-  if ( m_cacheAddr )
-  {
-    delete [] m_cacheAddr;
-  }
-  if ( m_cachePoc )
-  {
-    delete [] m_cachePoc;
-  }
-  if ( m_cacheComp )
+  if ( m_mapFile.is_open() )
   {
-    delete [] m_cacheComp;
-  }
-  if ( m_available )
-  {
-    delete [] m_available;
-  }
-  if ( m_hitCount )
-  {
-    delete [] m_hitCount;
-  }
-  if ( m_treeStatus )
-  {
-    delete [] m_treeStatus;
+    m_mapFile.close();
   }
+  m_ctuStats.clear();
 }
 
 // clear cache status (set invalid for each entry)
@@ -239,11 +358,22 @@ void CacheModel::clear()
 {
   if ( m_cacheEnable )
   {
-    ::memset( m_available, 0, m_cacheSize * sizeof(bool) );
-    ::memset( m_hitCount,  0, m_cacheSize * sizeof(int) );
-    m_missHitCount = 0;
-    m_totalAccess  = 0;
+    for ( int i = 0 ; i < m_numLevels ; i++ )
+    {
+      m_level[i].clear();
+    }
+    m_ctuStats.clear();
+  }
+}
+
+CacheStats CacheModel::xGetFrameStats() const
+{
+  CacheStats frameStats;
+  for ( const auto &ctuStats : m_ctuStats )
+  {
+    frameStats.add( ctuStats.second );
   }
+  return frameStats;
 }
 
 // accuulate result for sequence level
@@ -251,37 +381,50 @@ void CacheModel::accumulateFrame( )
 {
   if ( m_cacheEnable )
   {
-    for ( int i = 0 ; i < m_cacheSize ; i++ )
-    {
-      m_hitCountSeq += m_hitCount[ i ];
-    }
-    m_missHitCountSeq += m_missHitCount;
-    m_totalAccessSeq  += m_totalAccess;
-
-    if ( m_totalAccessSeq < 0 )
-    {
-      fprintf( stdout, "detect overflow\n" );
-    }
+    m_seqStats.add( xGetFrameStats() );
   }
 }
 
 // report bandwidth, hit ratio and so on in a Frame
-void CacheModel::reportFrame( )
+void CacheModel::reportFrame( int poc )
 {
   if ( m_cacheEnable )
   {
+    m_curPoc = poc;
+    const CacheLevel &lastLevel = m_level[m_numLevels - 1];
+
     if ( m_frameReport )
     {
-      int hitCount = 0;
+      const CacheStats frameStats = xGetFrameStats();
 
-      for ( int i = 0 ; i < m_cacheSize ; i++ )
+      fprintf( stdout, "Cache Statics in frame %d (POC %d)\n", m_frameCount, m_curPoc );
+      fprintf( stdout, "L1 hit ratio %5.2f [%%]\n", 100.0 * ( frameStats.access - frameStats.miss[0] ) / std::max<int64_t>( 1, frameStats.access ) );
+      if ( m_numLevels > 1 )
       {
-        hitCount += m_hitCount[ i ];
+        fprintf( stdout, "L2 hit ratio %5.2f [%%]\n", 100.0 * ( frameStats.miss[0] - frameStats.miss[1] ) / std::max<int64_t>( 1, frameStats.miss[0] ) );
       }
+      fprintf( stdout, "Required bandwidth %.1f [MB]\n", ( (double) frameStats.miss[m_numLevels - 1] * lastLevel.getLineSize() ) / ( 1024 * 1024 ) );
 
-      fprintf( stdout, "Cache Statics in frame %d\n", m_frameCount );
-      fprintf( stdout, "Hit ratio %5.2f [%%]\n", (100 * (double)(hitCount)) / m_totalAccess );
-      fprintf( stdout, "Required bandwidth %.1f [MB]\n", ((double)(m_missHitCount) * m_cacheLineSize) / (1024 * 1024) );
+      std::map<int, CacheStats> refStats;
+      for ( const auto &ctuStats : m_ctuStats )
+      {
+        refStats[ctuStats.first.second].add( ctuStats.second );
+      }
+      for ( const auto &ref : refStats )
+      {
+        fprintf( stdout, "  ref POC %4d: access %10" PRIi64 " L1 miss %8" PRIi64 " L2 miss %8" PRIi64 " bandwidth %.1f [KB]\n", ref.first,
+                 ref.second.access, ref.second.miss[0], ref.second.miss[1], ( (double) ref.second.miss[m_numLevels - 1] * lastLevel.getLineSize() ) / 1024 );
+      }
+    }
+
+    if ( m_mapFile.is_open() )
+    {
+      for ( const auto &ctuStats : m_ctuStats )
+      {
+        const CacheStats &stats = ctuStats.second;
+        m_mapFile << m_frameCount << ',' << m_curPoc << ',' << ctuStats.first.first << ',' << ctuStats.first.second << ','
+                  << stats.access << ',' << stats.miss[0] << ',' << stats.miss[1] << ',' << stats.miss[m_numLevels - 1] * lastLevel.getLineSize() << '\n';
+      }
     }
     m_frameCount++;
   }
@@ -292,18 +435,21 @@ void CacheModel::reportSequence( )
   if ( m_cacheEnable )
   {
     fprintf( stdout, "Cache config\n" );
-    fprintf( stdout, "Cache line size: %d\n", m_cacheLineSize  );
-    fprintf( stdout, "Cache line number %d\n", m_numCacheLine );
-    fprintf( stdout, "Cache way number %d\n\n", m_numWay );
+    for ( int i = 0 ; i < m_numLevels ; i++ )
+    {
+      m_level[i].printConfig( i );
+    }
+    fprintf( stdout, "\n" );
 
     fprintf( stdout, "Cache Statics in total\n" );
-    fprintf( stdout, "Hit ratio %5.2f [%%]\n", (100 * (double)(m_hitCountSeq)) / m_totalAccessSeq );
-#ifdef _MSC_VER
-    fprintf( stdout, "Hit count / total %I64d / %I64d\n", m_hitCountSeq, m_totalAccessSeq );
-#else
-    fprintf( stdout, "Hit count / total %" PRIi64 " / %" PRIi64 "\n", m_hitCountSeq, m_totalAccessSeq );
-#endif
-    fprintf( stdout, "Required bandwidth %.1f [MB] / frame\n", (((double)m_missHitCountSeq) * m_cacheLineSize) / (m_frameCount * 1024 * 1024) );
+    fprintf( stdout, "L1 hit ratio %5.2f [%%]\n", 100.0 * ( m_seqStats.access - m_seqStats.miss[0] ) / std::max<int64_t>( 1, m_seqStats.access ) );
+    fprintf( stdout, "L1 miss count / total %" PRIi64 " / %" PRIi64 "\n", m_seqStats.miss[0], m_seqStats.access );
+    if ( m_numLevels > 1 )
+    {
+      fprintf( stdout, "L2 hit ratio %5.2f [%%]\n", 100.0 * ( m_seqStats.miss[0] - m_seqStats.miss[1] ) / std::max<int64_t>( 1, m_seqStats.miss[0] ) );
+      fprintf( stdout, "L2 miss count / total %" PRIi64 " / %" PRIi64 "\n", m_seqStats.miss[1], m_seqStats.miss[0] );
+    }
+    fprintf( stdout, "Required bandwidth %.1f [MB] / frame\n", ( (double) m_seqStats.miss[m_numLevels - 1] * m_level[m_numLevels - 1].getLineSize() ) / ( std::max( 1, m_frameCount ) * 1024 * 1024 ) );
   }
 }
 
@@ -315,98 +461,6 @@ void CacheModel::setRefPicture( const Picture *refPic, const ComponentID CompID
     m_picWidth = refPic->getRecoBuf( CompID ).stride;
 }
 
-bool CacheModel::xIsCacheHit( int pos, size_t addr )
-{
-  bool ret = false;
-
-  if ( m_available[pos] )
-  {
-    if ( addr == m_cacheAddr[pos] )
-    {
-      if ( m_refPoc == m_cachePoc[pos] )
-      {
-        if ( m_compID == m_cacheComp[pos] )
-        {
-          ret = true;
-        }
-      }
-    }
-  }
-  return ret;
-}
-
-//-- PLRU
-
-int CacheModel::xGetWayTreePLRU( int entry )
-{
-  int shift  = 0;
-  int way    = 0;
-  for ( int i = 0; i < m_treeDepth ; i++ )
-  {
-    int flag  = (m_treeStatus[ entry ] >> shift) & 0x1;
-    shift = (shift << 1) + flag + 1;
-    way   = (way << 1) | (flag ^ 0x1);
-  }
-  xUpdateCacheStatus( entry, way );
-
-  return way;
-}
-
-void CacheModel::xUpdatePLRUStatus( int entry, int way )
-{
-  int val   = m_treeStatus[ entry ];
-  int shift = 0;
-
-  for ( int i = 0 ; i < m_treeDepth ; i++ )
-  {
-    int flag = (way >> (m_treeDepth - i - 1)) & 0x1;
-    val = (val & (~0 ^ (1 << shift))) | (flag << shift); // only set shift-th bit
-    shift = (shift << 1) + 2 - flag;
-  }
-
-  m_treeStatus[ entry ] = val;
-}
-
-//-- other cache alg. (for future use)
-
-// get update way based on each update algorithm (Now Tree PLRU only)
-int CacheModel::xGetWay( int entry )
-{
-  // single way
-  if ( m_numWay == 1 )
-  {
-    return 0;
-  }
-  // multiway
-  return xGetWayTreePLRU( entry );
-}
-
-// update cache entry
-void CacheModel::xUpdateCache( int entry, size_t addr )
-{
-  int way = xGetWay( entry );
-
-  if (entry * m_numWay + way >= m_cacheSize || entry * m_numWay + way < 0)
-  {
-    THROW("incorrect cache info");
-  }
-
-  m_cacheAddr[ entry * m_numWay + way ] = addr;
-  m_cachePoc[ entry * m_numWay + way ]  = m_refPoc;
-  m_cacheComp[ entry * m_numWay + way ] = m_compID;
-  m_available[ entry * m_numWay + way ] = true;
-
-}
-
-void CacheModel::xUpdateCacheStatus( int entry, int way )
-{
-  if ( m_numWay == 1 )
-  {
-    return;
-  }
-  xUpdatePLRUStatus( entry, way );
-}
-
 size_t CacheModel::xMapAddress( size_t offset ) {
 
   size_t ret;
@@ -433,52 +487,36 @@ size_t CacheModel::xMapAddress( size_t offset ) {
   }
 }
 
-// check cache hit/miss
-void CacheModel::cacheAccess( const Pel *addr, const std::string& fileName, const int lineNum )
+// check cache hit/miss for each sample of a block of the current reference picture
+void CacheModel::blockAccess( const Pel *buf, int stride, int width, int height )
 {
-  if ( !m_cacheEnable || !m_cacheEnableFilter )
-  {
-    return;
-  }
-  bool hit = false;
-  size_t cacheAddr = xMapAddress( (size_t) (addr - m_base) ) >> m_shift;
-  int  entry = (int) (cacheAddr % m_numCacheLine);
-  int  pos   = entry * m_numWay;
-  int  way;
+  CacheStats  &stats  = m_ctuStats[std::make_pair( m_ctuAddr, m_refPoc )];
+  const size_t offset = (size_t) (buf - m_base);
 
-  // check cache hit in each way
-  for ( way = 0 ; way < m_numWay ; way++ )
+  for ( int row = 0 ; row < height ; row++ )
   {
-      if ( xIsCacheHit( pos + way, cacheAddr ) ) {
-        hit = true;
-        break;
+    size_t prevLine = std::numeric_limits<size_t>::max();
+    for ( int col = 0 ; col < width ; col++ )
+    {
+      const size_t addr = xMapAddress( offset + row * stride + col );
+      const size_t line = addr >> m_level[0].getShift();
+
+      stats.access++;
+      // the most recently used line is a hit and does not change the replacement state
+      if ( line == prevLine )
+      {
+        continue;
       }
-  }
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_ACCESS_INFO
-  if ( m_frameCount == JVET_J0090_MEMORY_BANDWITH_MEASURE_PRINT_FRAME )
-  {
-    fprintf( stdout, "%s %d:%p\n", fileName.c_str(), lineNum, addr );
-  }
-#endif
+      prevLine = line;
 
-  if ( !hit )
-  {
-    // read data from external memory
-    m_missHitCount++;
-    // update cache entry
-    xUpdateCache( entry, cacheAddr );
-  }
-  else
-  {
-    // update hit status
-    m_hitCount[ pos + way ] ++;
-    xUpdateCacheStatus( entry, way );
+      if ( !m_level[0].access( line, m_refPoc, m_compID ) )
+      {
+        stats.miss[0]++;
+        if ( m_numLevels > 1 && !m_level[1].access( addr >> m_level[1].getShift(), m_refPoc, m_compID ) )
+        {
+          stats.miss[1]++;
+        }
+      }
+    }
   }
-  m_totalAccess++;
-}
-
-void CacheModel::setCacheEnable( bool enable )
-{
-  m_cacheEnableFilter = enable;
 }
-#endif // JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -40,89 +40,121 @@
 #define _CACHEMODEL_H_
 #include "Picture.h"
 
-// function list
-#if !JVET_J0090_MEMORY_BANDWITH_MEASURE
-#define JVET_J0090_SET_CACHE_ENABLE( enable )          /* do nothing */
-#define JVET_J0090_SET_REF_PICTURE( refPic, compID )   /* do nothing */
-#define JVET_J0090_CACHE_ACCESS( src, fileName, line ) /* do nothing */
-#else
-#define JVET_J0090_SET_CACHE_ENABLE( enable )          m_cacheModel->setCacheEnable( enable )
-#define JVET_J0090_SET_REF_PICTURE( refPic, compID )   m_cacheModel->setRefPicture( refPic, compID )
-#define JVET_J0090_CACHE_ACCESS( src, fileName, line ) m_cacheModel->cacheAccess( src, fileName, line )
+#include <map>
+#include <fstream>
 
+enum CacheReplacement
+{
+  CACHE_REPLACE_PLRU = 0,   // tree pseudo-LRU
+  CACHE_REPLACE_LRU,
+  CACHE_REPLACE_FIFO,
+  NUM_CACHE_REPLACE
+};
+
+static const int MAX_NUM_CACHE_LEVELS = 2;
+
+// access counters, misses are counted in cache lines of the respective level
+struct CacheStats
+{
+  int64_t access;
+  int64_t miss[MAX_NUM_CACHE_LEVELS];
+
+  CacheStats() : access( 0 ) { miss[0] = miss[1] = 0; }
+  void add( const CacheStats &other )
+  {
+    access += other.access;
+    for( int i = 0; i < MAX_NUM_CACHE_LEVELS; i++ )
+    {
+      miss[i] += other.miss[i];
+    }
+  }
+};
+
+// one set-associative cache level
+class CacheLevel
+{
+private:
+  int           m_lineSize;        // size of byte in each entry (shall be power of 2)
+  int           m_numCacheLine;    // # of cache line (sets)
+  int           m_numWay;          // # of way
+  int           m_replacement;     // CacheReplacement
+  int           m_shift;
+  int           m_treeDepth;
+  int64_t       m_stamp;
+  // cache entry
+  std::vector<size_t>      m_addr;
+  std::vector<int>         m_poc;
+  std::vector<ComponentID> m_comp;
+  std::vector<bool>        m_available;
+  std::vector<int64_t>     m_age;          // LRU: last use, FIFO: insertion
+  std::vector<int>         m_treeStatus;   // PLRU: one tree per set
 
+public:
+  CacheLevel();
+  void   create( int lineSize, int numCacheLine, int numWay, int replacement );
+  void   clear();
+  bool   access( size_t addr, int poc, ComponentID compID );   ///< returns true on hit, allocates the line on miss
+  int    getShift()    const { return m_shift; }
+  int    getLineSize() const { return m_lineSize; }
+  int    getSize()     const { return m_lineSize * m_numCacheLine * m_numWay; }
+  void   printConfig( int level ) const;
+
+protected:
+  int    xGetVictimWay( int entry );
+  void   xUpdateStatus( int entry, int way, bool hit );
+  // PLRU
+  int    xGetWayTreePLRU( int entry );
+  void   xUpdatePLRUStatus( int entry, int way );
+};
 
 class CacheModel
 {
 private:
   // cache enable
   bool          m_cacheEnable;
-  bool          m_cacheEnableFilter;
   // report level
   bool          m_frameReport;
   // cache parameters
-  int           m_cacheLineSize;   // size of byte in each entry (shall be power of 2)
-  int           m_numCacheLine;    // # of cache line
-  int           m_numWay;          // # of way
-  int           m_cacheSize;       // total entry numer (line number * way)
+  int           m_numLevels;
+  CacheLevel    m_level[MAX_NUM_CACHE_LEVELS];
   int           m_cacheAddrMode;   // cache address mode
   int           m_cacheBlkWidth;   // block width in 2D access
   int           m_cacheBlkHeight;  // block height in 2D access
-  // cache parameters for address calc
-  int           m_shift;
-  // cache entry
-  size_t*       m_cacheAddr;
-  int*          m_cachePoc;
-  ComponentID*  m_cacheComp;
-  bool*         m_available;
   // access Information
+  int           m_curPoc;
+  int           m_ctuAddr;
   int           m_refPoc;
-  Pel*          m_base;
+  const Pel*    m_base;
   ComponentID   m_compID;
   int           m_picWidth;
-  // PLRU parameters
-  int           m_treeDepth;
-  int*          m_treeStatus;
 
-  // stastical infromation for a frame
-  int*          m_hitCount; // for each cache entry
-  int           m_missHitCount; // for calc total bandwidth
-  int           m_totalAccess;
+  // stastical infromation for a frame, per CTU and reference picture
+  std::map<std::pair<int, int>, CacheStats> m_ctuStats;
   // stastical infromation for a sequence
-  int64_t       m_hitCountSeq;
-  int64_t       m_missHitCountSeq;
-  int64_t       m_totalAccessSeq;
+  CacheStats    m_seqStats;
   int           m_frameCount;
+  // per CTU / reference picture map output
+  std::string   m_mapFileName;
+  std::ofstream m_mapFile;
 
 public:
   CacheModel();
   ~CacheModel();
-  bool isCacheEnable( ) { return m_cacheEnable; }
+  bool isCacheEnable( ) const { return m_cacheEnable; }
   void create(const std::string& cacheCfgFileName);
   void destroy( );
   void clear( );
-  void reportFrame();
+  void reportFrame( int poc );
   void reportSequence();
-  void cacheAccess( const Pel *addr, const std::string& fileName, const int lineNum );
   void accumulateFrame( );
-  void setCacheEnable( bool enable );
   void setRefPicture( const Picture *refPic, const ComponentID compID );
+  void setCurrentCtu( int poc, int ctuAddr ) { m_curPoc = poc; m_ctuAddr = ctuAddr; }
+  void blockAccess( const Pel *buf, int stride, int width, int height );
 
 protected:
-  bool xIsCacheHit( int pos, size_t addr );
-  int xCalcTreeSize( int way );
-  int xCalcPower( int num );
-  int xGetWay( int entry );
   size_t xMapAddress( size_t offset );
   void xConfigure(const std::string& filename);
-  void xUpdateCache( int entry, size_t addr );
-  void xUpdateCacheStatus( int entry, int way );
-  // PLRU
-  int xGetWayTreePLRU( int entry );
-  void xUpdatePLRUStatus( int entry, int way );
+  CacheStats xGetFrameStats() const;
 };
 
-#endif // JVET_J0090_MEMORY_BANDWITH_MEASURE
 #endif // _CACHEMODEL_H_
-
-
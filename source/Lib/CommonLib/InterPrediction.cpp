@@ -65,8 +65,13 @@ InterPrediction::InterPrediction()
 , m_gradX1(nullptr)
 , m_gradY1(nullptr)
 , m_subPuMC(false)
+, m_cacheModel(nullptr)
+, m_searchWindowModel(nullptr)
 , m_IBCBufferWidth(0)
 {
+  m_approxMcNumTaps[CHANNEL_TYPE_LUMA]   = NTAPS_LUMA;
+  m_approxMcNumTaps[CHANNEL_TYPE_CHROMA] = NTAPS_CHROMA;
+
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
   {
     for( uint32_t refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
@@ -218,9 +223,7 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC, cons
       m_cRefSamplesDMVRL1[ch] = (Pel*)xMalloc(Pel, (MAX_CU_SIZE + (2 * DMVR_NUM_ITERATION) + NTAPS_LUMA) * (MAX_CU_SIZE + (2 * DMVR_NUM_ITERATION) + NTAPS_LUMA));
     }
   }
-#if !JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_if.initInterpolationFilter( true );
-#endif
 
   if (m_storedMv == nullptr)
   {
@@ -242,6 +245,36 @@ void InterPrediction::init( RdCost* pcRdCost, ChromaFormat chromaFormatIDC, cons
 // Public member functions
 // ====================================================================================================================
 
+/// number of rows the horizontal pass has to provide for the vertical pass of the given (approximate) filter
+int InterPrediction::xGetMcFilterSize( const ComponentID compID, const int numTaps ) const
+{
+  if( isLuma( compID ) )
+  {
+    return numTaps < NTAPS_LUMA ? m_if.getApproxFilterBank().getLumaKernelTaps( numTaps ) : NTAPS_LUMA;
+  }
+  return numTaps < NTAPS_CHROMA ? m_if.getApproxFilterBank().getChromaKernelTaps( numTaps ) : NTAPS_CHROMA;
+}
+
+void InterPrediction::xCacheAccess( const PredictionUnit& pu, const Picture* refPic, const ComponentID compID, const Pel* buf, const int stride, const int width, const int height, const int hFilterSize, const int vFilterSize )
+{
+  // the reference area read by the filters, a filter size of 1 denotes an integer position
+  const Pel* src = buf - ( ( vFilterSize - 1 ) >> 1 ) * stride - ( ( hFilterSize - 1 ) >> 1 );
+
+  if( m_cacheModel )
+  {
+    m_cacheModel->setCurrentCtu( pu.cu->slice->getPOC(), getCtuAddr( pu.lumaPos(), *pu.cs->pcv ) );
+    m_cacheModel->setRefPicture( refPic, compID );
+    m_cacheModel->blockAccess( src, stride, width + hFilterSize - 1, height + vFilterSize - 1 );
+  }
+  if( m_searchWindowModel && isLuma( compID ) )
+  {
+    const PreCalcValues& pcv = *pu.cs->pcv;
+    m_searchWindowModel->setCurrentCtu( Position( pu.lumaPos().x & ~pcv.maxCUWidthMask, pu.lumaPos().y & ~pcv.maxCUHeightMask ) );
+    m_searchWindowModel->setRefPicture( refPic );
+    m_searchWindowModel->blockAccess( src, width + hFilterSize - 1, height + vFilterSize - 1 );
+  }
+}
+
 bool InterPrediction::xCheckIdenticalMotion( const PredictionUnit &pu )
 {
   const Slice &slice = *pu.cs->slice;
@@ -361,48 +394,6 @@ void InterPrediction::xSubPuBio(PredictionUnit& pu, PelUnitBuf& predBuf, const R
   Position puPos = pu.lumaPos();
   Size puSize = pu.lumaSize();
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  JVET_J0090_SET_CACHE_ENABLE(true);
-  int mvShift = (MV_FRACTIONAL_BITS_INTERNAL);
-  for (int k = 0; k < NUM_REF_PIC_LIST_01; k++)
-  {
-    RefPicList refId = (RefPicList)k;
-    const Picture* refPic = pu.cu->slice->getRefPic(refId, pu.refIdx[refId]);
-    for (int compID = 0; compID < MAX_NUM_COMPONENT; compID++)
-    {
-      Mv cMv = pu.mv[refId];
-      int mvshiftTemp = mvShift + getComponentScaleX((ComponentID)compID, pu.chromaFormat);
-      int filtersize = (compID == (COMPONENT_Y)) ? NTAPS_LUMA : NTAPS_CHROMA;
-      cMv += Mv(-(((filtersize >> 1) - 1) << mvshiftTemp), -(((filtersize >> 1) - 1) << mvshiftTemp));
-      bool wrapRef = false;
-      if ( pu.cu->slice->getRefPic(refId, pu.refIdx[refId])->isWrapAroundEnabled( pu.cs->pps ) )
-      {
-        wrapRef = wrapClipMv(cMv, pu.blocks[0].pos(), pu.blocks[0].size(), pu.cs->sps, pu.cs->pps);
-      }
-      else
-      {
-        clipMv(cMv, pu.lumaPos(), pu.lumaSize(), *pu.cs->sps, *pu.cs->pps);
-      }
-
-      int width = predBuf.bufs[compID].width + (filtersize - 1);
-      int height = predBuf.bufs[compID].height + (filtersize - 1);
-
-      CPelBuf refBuf;
-      Position recOffset = pu.blocks[compID].pos().offset(cMv.getHor() >> mvshiftTemp, cMv.getVer() >> mvshiftTemp);
-      refBuf = refPic->getRecoBuf(CompArea((ComponentID)compID, pu.chromaFormat, recOffset, pu.blocks[compID].size()), wrapRef);
-
-      JVET_J0090_SET_REF_PICTURE(refPic, (ComponentID)compID);
-      for (int row = 0; row < height; row++)
-      {
-        for (int col = 0; col < width; col++)
-        {
-          JVET_J0090_CACHE_ACCESS(((Pel *)refBuf.buf) + row * refBuf.stride + col, __FILE__, __LINE__);
-        }
-      }
-    }
-  }
-  JVET_J0090_SET_CACHE_ENABLE(false);
-#endif
   PredictionUnit subPu;
 
   subPu.cs = pu.cs;
@@ -445,7 +436,6 @@ void InterPrediction::xSubPuBio(PredictionUnit& pu, PelUnitBuf& predBuf, const R
       motionCompensation(subPu, subPredBuf, eRefPicList);
     }
   }
-  JVET_J0090_SET_CACHE_ENABLE(true);
 }
 
 void InterPrediction::xPredInterUni(const PredictionUnit &pu, const RefPicList &eRefPicList, PelUnitBuf &pcYuvPred,
@@ -675,7 +665,6 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
                                      , int32_t srcPadStride
                                     )
 {
-  JVET_J0090_SET_REF_PICTURE( refPic, compID );
   const ChromaFormat  chFmt = pu.chromaFormat;
   const bool          rndRes = !bi;
 
@@ -690,6 +679,7 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
   }
 
   bool useAltHpelIf = pu.cu->imv == IMV_HPEL;
+  const int numTaps = bilinearMC || useAltHpelIf ? NTAPS_LUMA : m_approxMcNumTaps[toChannelType( compID )];
 
   if( !isIBC && xPredInterBlkRPR( scalingRatio, *pu.cs->pps, CompArea( compID, chFmt, pu.blocks[compID], Size( dstPic.bufs[compID].width, dstPic.bufs[compID].height ) ), refPic, mv, dstPic.bufs[compID].buf, dstPic.bufs[compID].stride, bi, wrapRef, clpRng, 0, useAltHpelIf ) )
   {
@@ -703,7 +693,6 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
     if (isIBC)
     {
       xFrac = yFrac = 0;
-      JVET_J0090_SET_CACHE_ENABLE(false);
     }
 
     PelBuf & dstBuf = dstPic.bufs[compID];
@@ -733,6 +722,11 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
       width  = dmvrWidth;
       height = dmvrHeight;
     }
+    if (xIsRefAccessTracked() && NULL == srcPadBuf && !isIBC && !wrapRef)
+    {
+      const int filterSize = bilinearMC ? NTAPS_BILINEAR : xGetMcFilterSize(compID, numTaps);
+      xCacheAccess(pu, refPic, compID, refBuf.buf, refBuf.stride, width, height, xFrac ? filterSize : 1, yFrac ? filterSize : 1);
+    }
     // backup data
     int  backupWidth        = width;
     int  backupHeight       = height;
@@ -752,12 +746,12 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
     if (yFrac == 0)
     {
       m_if.filterHor(compID, (Pel *) refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
-                     xFrac, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+                     xFrac, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf, numTaps);
     }
     else if (xFrac == 0)
     {
       m_if.filterVer(compID, (Pel *) refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
-                     yFrac, true, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+                     yFrac, true, rndRes, chFmt, clpRng, bilinearMC, bilinearMC, useAltHpelIf, numTaps);
     }
     else
     {
@@ -768,23 +762,18 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
         tmpBuf.stride = dstBuf.stride;
       }
 
-      int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+      int vFilterSize = xGetMcFilterSize(compID, numTaps);
       if (bilinearMC)
       {
         vFilterSize = NTAPS_BILINEAR;
       }
       m_if.filterHor(compID, (Pel *) refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tmpBuf.buf,
                      tmpBuf.stride, backupWidth, backupHeight + vFilterSize - 1, xFrac, false, chFmt, clpRng,
-                     bilinearMC, bilinearMC, useAltHpelIf);
-      JVET_J0090_SET_CACHE_ENABLE(false);
+                     bilinearMC, bilinearMC, useAltHpelIf, numTaps);
       m_if.filterVer(compID, (Pel *) tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dstBuf.buf,
                      dstBuf.stride, backupWidth, backupHeight, yFrac, false, rndRes, chFmt, clpRng, bilinearMC,
-                     bilinearMC, useAltHpelIf);
+                     bilinearMC, useAltHpelIf, numTaps);
     }
-    JVET_J0090_SET_CACHE_ENABLE(
-      (srcPadStride == 0)
-      && (bioApplied
-          == false));   // Enabled only in non-DMVR-non-BDOF process, In DMVR process, srcPadStride is always non-zero
     if (bioApplied && compID == COMPONENT_Y)
     {
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
@@ -876,7 +865,6 @@ bool InterPrediction::isSubblockVectorSpreadOverLimit( int a, int b, int c, int
 void InterPrediction::xPredAffineBlk(const ComponentID &compID, const PredictionUnit &pu, const Picture *refPic, const Mv *_mv, PelUnitBuf &dstPic, const bool &bi, const ClpRng &clpRng, bool genChromaMv, const std::pair<int, int> scalingRatio)
 {
 
-  JVET_J0090_SET_REF_PICTURE( refPic, compID );
   const ChromaFormat chFmt = pu.chromaFormat;
   int iScaleX = ::getComponentScaleX( compID, chFmt );
   int iScaleY = ::getComponentScaleY( compID, chFmt );
@@ -919,7 +907,8 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
   int iMvScaleVer = mvLT.getVer() << iBit;
   const SPS &sps    = *pu.cs->sps;
 
-  const int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+  const int numTaps     = m_approxMcNumTaps[toChannelType(compID)];
+  const int vFilterSize = xGetMcFilterSize(compID, numTaps);
 
   const int shift = iBit - 4 + MV_FRACTIONAL_BITS_INTERNAL;
   bool      wrapRef = false;
@@ -1172,6 +1161,11 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
         int bw = blockWidth;
         int bh = blockHeight;
 
+        if (xIsRefAccessTracked() && !wrapRef)
+        {
+          xCacheAccess(pu, refPic, compID, ref, refStride, bw, bh, xFrac ? vFilterSize : 1, yFrac ? vFilterSize : 1);
+        }
+
         if (enablePROF)
         {
           dst       = dstExtBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
@@ -1180,20 +1174,18 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
 
         if (yFrac == 0)
         {
-          m_if.filterHor(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, chFmt, clpRng);
+          m_if.filterHor(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, chFmt, clpRng, 0, false, false, numTaps);
         }
         else if (xFrac == 0)
         {
-          m_if.filterVer(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, chFmt, clpRng);
+          m_if.filterVer(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, chFmt, clpRng, 0, false, false, numTaps);
         }
         else
         {
           m_if.filterHor(compID, (Pel *) ref - ((vFilterSize >> 1) - 1) * refStride, refStride, tmpBuf.buf,
-                         tmpBuf.stride, bw, bh + vFilterSize - 1, xFrac, false, chFmt, clpRng);
-          JVET_J0090_SET_CACHE_ENABLE(false);
+                         tmpBuf.stride, bw, bh + vFilterSize - 1, xFrac, false, chFmt, clpRng, 0, false, false, numTaps);
           m_if.filterVer(compID, tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dst, dstStride,
-                         bw, bh, yFrac, false, isLast, chFmt, clpRng);
-          JVET_J0090_SET_CACHE_ENABLE(true);
+                         bw, bh, yFrac, false, isLast, chFmt, clpRng, 0, false, false, numTaps);
         }
         if (enablePROF)
         {
@@ -1727,6 +1719,10 @@ void InterPrediction::xPrefetch(PredictionUnit& pu, PelUnitBuf &pcPad, RefPicLis
       refBuf = refPic->getRecoBuf(CompArea((ComponentID)compID, pu.chromaFormat, Rec_offset, pu.blocks[compID].size()), wrapRef);
       PelBuf &dstBuf = pcPad.bufs[compID];
       g_pelBufOP.copyBuffer((Pel *)refBuf.buf, refBuf.stride, ((Pel *)dstBuf.buf) + offset, dstBuf.stride, width, height);
+      if (xIsRefAccessTracked() && !wrapRef)
+      {
+        xCacheAccess(pu, refPic, (ComponentID) compID, refBuf.buf, refBuf.stride, width, height, 1, 1);
+      }
     }
   }
 }
@@ -1927,11 +1923,9 @@ void InterPrediction::xFinalPaddedMCForDMVR(PredictionUnit &pu, PelUnitBuf &pcYu
         offset += (deltaIntMvX);
         srcBufPelPtr = (srcBuf.buf + offset);
       }
-      JVET_J0090_SET_CACHE_ENABLE(false);
       xPredInterBlk((ComponentID) compID, pu, refPic, cMvClipped, pcYUVTemp, true,
                     pu.cs->slice->getClpRngs().comp[compID], bioApplied, false,
                     pu.cu->slice->getScalingRatio(refId, pu.refIdx[refId]), 0, 0, 0, srcBufPelPtr, pcPadstride);
-      JVET_J0090_SET_CACHE_ENABLE(false);
     }
     pcYUVTemp = pcYuvSrc1;
     pcPadTemp = pcPad1;
@@ -2036,47 +2030,6 @@ void InterPrediction::xProcessDMVR(PredictionUnit& pu, PelUnitBuf &pcYuvDst, con
   int            bioEnabledThres = 2 * dy * dx;
   bool           bioAppliedType[MAX_NUM_SUBCU_DMVR];
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  JVET_J0090_SET_CACHE_ENABLE(true);
-  for (int k = 0; k < NUM_REF_PIC_LIST_01; k++)
-  {
-    RefPicList refId = (RefPicList)k;
-    const Picture* refPic = pu.cu->slice->getRefPic(refId, pu.refIdx[refId]);
-    for (int compID = 0; compID < MAX_NUM_COMPONENT; compID++)
-    {
-      Mv cMv = pu.mv[refId];
-      int mvshiftTemp = mvShift + getComponentScaleX((ComponentID)compID, pu.chromaFormat);
-      int filtersize = (compID == (COMPONENT_Y)) ? NTAPS_LUMA : NTAPS_CHROMA;
-      cMv += Mv(-(((filtersize >> 1) - 1) << mvshiftTemp), -(((filtersize >> 1) - 1) << mvshiftTemp));
-      bool wrapRef = false;
-      if ( pu.cs->pps->getWrapAroundEnabledFlag() )
-      {
-        wrapRef = wrapClipMv(cMv, pu.blocks[0].pos(), pu.blocks[0].size(), pu.cs->sps, pu.cs->pps);
-      }
-      else
-      {
-        clipMv(cMv, pu.lumaPos(), pu.lumaSize(), *pu.cs->sps, *pu.cs->pps);
-      }
-
-      int width = pcYuvDst.bufs[compID].width + (filtersize - 1);
-      int height = pcYuvDst.bufs[compID].height + (filtersize - 1);
-
-      CPelBuf refBuf;
-      Position recOffset = pu.blocks[compID].pos().offset(cMv.getHor() >> mvshiftTemp, cMv.getVer() >> mvshiftTemp);
-      refBuf = refPic->getRecoBuf(CompArea((ComponentID)compID, pu.chromaFormat, recOffset, pu.blocks[compID].size()), wrapRef);
-
-      JVET_J0090_SET_REF_PICTURE(refPic, (ComponentID)compID);
-      for (int row = 0; row < height; row++)
-      {
-        for (int col = 0; col < width; col++)
-        {
-          JVET_J0090_CACHE_ACCESS(((Pel *)refBuf.buf) + row * refBuf.stride + col, __FILE__, __LINE__);
-        }
-      }
-    }
-  }
-  JVET_J0090_SET_CACHE_ENABLE(false);
-#endif
 
   {
     int num = 0;
@@ -2214,17 +2167,8 @@ void InterPrediction::xProcessDMVR(PredictionUnit& pu, PelUnitBuf &pcYuvDst, con
       }
     }
   }
-  JVET_J0090_SET_CACHE_ENABLE(true);
 }
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-void InterPrediction::cacheAssign( CacheModel *cache )
-{
-  m_cacheModel = cache;
-  m_if.cacheAssign( cache );
-  m_if.initInterpolationFilter( !cache->isCacheEnable() );
-}
-#endif
 
 void InterPrediction::xFillIBCBuffer(CodingUnit &cu)
 {
@@ -2484,9 +2428,7 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
 
       Pel* tempBuf = buffer + ( yInt - yInt0 ) * tmpStride;
 
-      JVET_J0090_SET_CACHE_ENABLE( false );
       m_if.filterVer( compID, tempBuf + ( ( vFilterSize >> 1 ) - 1 ) * tmpStride, tmpStride, dst + row * dstStride, dstStride, width, 1, yFrac, false, rndRes, chFmt, clpRng, yFilter, false, useAltHpelIf && scalingRatio.second == 1 << SCALE_RATIO_BITS );
-      JVET_J0090_SET_CACHE_ENABLE( true );
     }
   }
 
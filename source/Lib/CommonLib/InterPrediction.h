@@ -41,6 +41,8 @@
 
 // Include files
 #include "InterpolationFilter.h"
+#include "CacheModel.h"
+#include "SearchWindowModel.h"
 #include "WeightPrediction.h"
 
 #include "Buffer.h"
@@ -110,6 +112,7 @@ protected:
   Pel*                 m_gradX1;
   Pel*                 m_gradY1;
   bool                 m_subPuMC;
+  int                  m_approxMcNumTaps[MAX_NUM_CHANNEL_TYPE]; ///< filter taps of luma/chroma MC, below NTAPS_LUMA/NTAPS_CHROMA for encoder-side candidate predictions only
 
   int                  m_IBCBufferWidth;
   PelStorage           m_IBCBuffer;
@@ -140,6 +143,9 @@ protected:
   void xPredAffineBlk           ( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv* _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng, const bool genChromaMv = false, const std::pair<int, int> scalingRatio = SCALE_1X );
 
   static bool xCheckIdenticalMotion( const PredictionUnit& pu );
+  int  xGetMcFilterSize         ( const ComponentID compID, const int numTaps ) const;
+  bool xIsRefAccessTracked      () const { return m_cacheModel || m_searchWindowModel; }
+  void xCacheAccess             ( const PredictionUnit& pu, const Picture* refPic, const ComponentID compID, const Pel* buf, const int stride, const int width, const int height, const int hFilterSize, const int vFilterSize );
 
   void xSubPuMC(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X, const bool luma = true, const bool chroma = true);
   void xSubPuBio(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X, PelUnitBuf* yuvDstTmp = NULL);
@@ -147,9 +153,8 @@ protected:
 
 
   MotionInfo      m_SubPuMiBuf[(MAX_CU_SIZE * MAX_CU_SIZE) >> (MIN_CU_LOG2 << 1)];
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  CacheModel      *m_cacheModel;
-#endif
+  CacheModel      *m_cacheModel;   ///< reference memory access model, nullptr when disabled
+  SearchWindowModel *m_searchWindowModel; ///< luma search window model, nullptr when disabled
   PelStorage       m_colorTransResiBuf[3];  // 0-org; 1-act; 2-tmp
 
 public:
@@ -170,6 +175,9 @@ public:
     , const bool luma = true, const bool chroma = true
   );
 
+  void    setApproxMcNumTaps  ( const int lumaNumTaps, const int chromaNumTaps ) { m_approxMcNumTaps[CHANNEL_TYPE_LUMA] = lumaNumTaps; m_approxMcNumTaps[CHANNEL_TYPE_CHROMA] = chromaNumTaps; }
+  void    resetApproxMcNumTaps()                                                 { setApproxMcNumTaps( NTAPS_LUMA, NTAPS_CHROMA ); }
+
   void    motionCompensationGeo(CodingUnit &cu, MergeCtx &GeoMrgCtx);
   void    weightedGeoBlk(PredictionUnit &pu, const uint8_t splitDir, int32_t channel, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
   void xPrefetch(PredictionUnit& pu, PelUnitBuf &pcPad, RefPicList refId, bool forLuma);
@@ -183,9 +191,8 @@ public:
   void xinitMC(PredictionUnit& pu, const ClpRngs &clpRngs);
   void xProcessDMVR(PredictionUnit& pu, PelUnitBuf &pcYuvDst, const ClpRngs &clpRngs, const bool bioApplied );
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  void    cacheAssign( CacheModel *cache );
-#endif
+  void    cacheAssign( CacheModel *cache ) { m_cacheModel = cache; }
+  void    searchWindowAssign( SearchWindowModel *searchWindow ) { m_searchWindowModel = searchWindow; }
   static bool isSubblockVectorSpreadOverLimit( int a, int b, int c, int d, int predType );
   void xFillIBCBuffer(CodingUnit &cu);
   void resetIBCBuffer(const ChromaFormat chromaFormatIDC, const int ctuSize);
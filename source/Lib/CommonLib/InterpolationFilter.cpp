@@ -45,10 +45,8 @@
 
 #include "ChromaFormat.h"
 #include "LabUCPel.h"
+#include "OpCounter.h"
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-CacheModel* InterpolationFilter::m_cacheModel;
-#endif
 //! \ingroup CommonLib
 //! \{
 
@@ -110,7 +108,47 @@ const TFilterCoeff InterpolationFilter::m_lumaFilter[N_APPROX_FILTERS][LUMA_INTE
   {0,	0,	-4,	  17,	58,	-10,	3,	0},
   {0,	0,	-3,	  13,	60,	-8,	  2,	0},
   {0,	0,	-2,	  8,	62,	-5,	  1,	0},
-  {0,	0,	-1,	  4,	63,	-2,	  0,	0}}
+  {0,	0,	-1,	  4,	63,	-2,	  0,	0}},
+
+// 4-tap, even phases of the chroma DCT-IF
+{
+  {   0,   0,   0,  64,   0,   0,   0,   0 },
+  {   0,   0,  -2,  62,   4,   0,   0,   0 },
+  {   0,   0,  -2,  58,  10,  -2,   0,   0 },
+  {   0,   0,  -4,  56,  14,  -2,   0,   0 },
+  {   0,   0,  -4,  54,  16,  -2,   0,   0 },
+  {   0,   0,  -6,  52,  20,  -2,   0,   0 },
+  {   0,   0,  -6,  46,  28,  -4,   0,   0 },
+  {   0,   0,  -4,  42,  30,  -4,   0,   0 },
+  {   0,   0,  -4,  36,  36,  -4,   0,   0 },
+  {   0,   0,  -4,  30,  42,  -4,   0,   0 },
+  {   0,   0,  -4,  28,  46,  -6,   0,   0 },
+  {   0,   0,  -2,  20,  52,  -6,   0,   0 },
+  {   0,   0,  -2,  16,  54,  -4,   0,   0 },
+  {   0,   0,  -2,  14,  56,  -4,   0,   0 },
+  {   0,   0,  -2,  10,  58,  -2,   0,   0 },
+  {   0,   0,   0,   4,  62,  -2,   0,   0 }
+},
+
+// 2-tap, bilinear
+{
+  {   0,   0,   0,  64,   0,   0,   0,   0 },
+  {   0,   0,   0,  60,   4,   0,   0,   0 },
+  {   0,   0,   0,  56,   8,   0,   0,   0 },
+  {   0,   0,   0,  52,  12,   0,   0,   0 },
+  {   0,   0,   0,  48,  16,   0,   0,   0 },
+  {   0,   0,   0,  44,  20,   0,   0,   0 },
+  {   0,   0,   0,  40,  24,   0,   0,   0 },
+  {   0,   0,   0,  36,  28,   0,   0,   0 },
+  {   0,   0,   0,  32,  32,   0,   0,   0 },
+  {   0,   0,   0,  28,  36,   0,   0,   0 },
+  {   0,   0,   0,  24,  40,   0,   0,   0 },
+  {   0,   0,   0,  20,  44,   0,   0,   0 },
+  {   0,   0,   0,  16,  48,   0,   0,   0 },
+  {   0,   0,   0,  12,  52,   0,   0,   0 },
+  {   0,   0,   0,   8,  56,   0,   0,   0 },
+  {   0,   0,   0,   4,  60,   0,   0,   0 }
+}
 };
 
 // 1.5x
@@ -352,6 +390,7 @@ const TFilterCoeff InterpolationFilter::m_bilinearFilterPrec4[LUMA_INTERPOLATION
 // ====================================================================================================================
 
 InterpolationFilter::InterpolationFilter()
+  : m_approxFilterBank( &ApproxFilterBank::getDefault() )
 {
   m_filterHor[0][0][0] = filter<8, false, false, false>;
   m_filterHor[0][0][1] = filter<8, false, false, true>;
@@ -368,6 +407,11 @@ InterpolationFilter::InterpolationFilter()
   m_filterHor[2][1][0] = filter<2, false, true, false>;
   m_filterHor[2][1][1] = filter<2, false, true, true>;
 
+  m_filterHor[3][0][0] = filter<6, false, false, false>;
+  m_filterHor[3][0][1] = filter<6, false, false, true>;
+  m_filterHor[3][1][0] = filter<6, false, true, false>;
+  m_filterHor[3][1][1] = filter<6, false, true, true>;
+
   m_filterVer[0][0][0] = filter<8, true, false, false>;
   m_filterVer[0][0][1] = filter<8, true, false, true>;
   m_filterVer[0][1][0] = filter<8, true, true, false>;
@@ -383,6 +427,11 @@ InterpolationFilter::InterpolationFilter()
   m_filterVer[2][1][0] = filter<2, true, true, false>;
   m_filterVer[2][1][1] = filter<2, true, true, true>;
 
+  m_filterVer[3][0][0] = filter<6, true, false, false>;
+  m_filterVer[3][0][1] = filter<6, true, false, true>;
+  m_filterVer[3][1][0] = filter<6, true, true, false>;
+  m_filterVer[3][1][1] = filter<6, true, true, true>;
+
   m_filterCopy[0][0]   = filterCopy<false, false>;
   m_filterCopy[0][1]   = filterCopy<false, true>;
   m_filterCopy[1][0]   = filterCopy<true, false>;
@@ -425,7 +474,6 @@ void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int
       for (col = 0; col < width; col++)
       {
         dst[col] = src[col];
-        JVET_J0090_CACHE_ACCESS( &src[col], __FILE__, __LINE__ );
       }
 
       src += srcStride;
@@ -478,7 +526,6 @@ void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int
       {
         Pel val = leftShift_round(src[col], shift);
         dst[col] = val - (Pel)IF_INTERNAL_OFFS;
-        JVET_J0090_CACHE_ACCESS( &src[col], __FILE__, __LINE__ );
       }
 
       src += srcStride;
@@ -534,7 +581,6 @@ void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int
           val     = rightShift_round((val + IF_INTERNAL_OFFS), shift);
 
           dst[col] = ClipPel(val, clpRng);
-          JVET_J0090_CACHE_ACCESS(&src[col], __FILE__, __LINE__);
         }
 
         src += srcStride;
@@ -639,28 +685,20 @@ void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, int srcSt
 
       sum  = src[ col + 0 * cStride] * c[0];
       sum += src[ col + 1 * cStride] * c[1];
-      JVET_J0090_CACHE_ACCESS( &src[ col + 0 * cStride], __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( &src[ col + 1 * cStride], __FILE__, __LINE__ );
       if ( N >= 4 )
       {
         sum += src[ col + 2 * cStride] * c[2];
         sum += src[ col + 3 * cStride] * c[3];
-        JVET_J0090_CACHE_ACCESS( &src[ col + 2 * cStride], __FILE__, __LINE__ );
-        JVET_J0090_CACHE_ACCESS( &src[ col + 3 * cStride], __FILE__, __LINE__ );
       }
       if ( N >= 6 )
       {
         sum += src[ col + 4 * cStride] * c[4];
         sum += src[ col + 5 * cStride] * c[5];
-        JVET_J0090_CACHE_ACCESS( &src[ col + 4 * cStride], __FILE__, __LINE__ );
-        JVET_J0090_CACHE_ACCESS( &src[ col + 5 * cStride], __FILE__, __LINE__ );
       }
       if ( N == 8 )
       {
         sum += src[ col + 6 * cStride] * c[6];
         sum += src[ col + 7 * cStride] * c[7];
-        JVET_J0090_CACHE_ACCESS( &src[ col + 6 * cStride], __FILE__, __LINE__ );
-        JVET_J0090_CACHE_ACCESS( &src[ col + 7 * cStride], __FILE__, __LINE__ );
       }
 
       Pel val = ( sum + offset ) >> shift;
@@ -693,6 +731,7 @@ void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, int srcSt
 template<int N>
 void InterpolationFilter::filterHor(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR)
 {
+  OP_COUNT( OP_TOOL_INTERP_HOR, N, width * height, N * width * height, N * width * height, width * height );
 //#if ENABLE_SIMD_OPT_MCIF
   if( N == 8 )
   {
@@ -706,6 +745,10 @@ void InterpolationFilter::filterHor(const ClpRng& clpRng, Pel const *src, int sr
   {
     m_filterHor[2][1][isLast](clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
   }
+  else if( N == 6 )
+  {
+    m_filterHor[3][1][isLast](clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
   else
   {
     THROW( "Invalid tap number" );
@@ -730,6 +773,7 @@ void InterpolationFilter::filterHor(const ClpRng& clpRng, Pel const *src, int sr
 template<int N>
 void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR)
 {
+  OP_COUNT( OP_TOOL_INTERP_VER, N, width * height, N * width * height, N * width * height, width * height );
 //#if ENABLE_SIMD_OPT_MCIF
   if( N == 8 )
   {
@@ -743,6 +787,10 @@ void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int sr
   {
     m_filterVer[2][isFirst][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
   }
+  else if( N == 6 )
+  {
+    m_filterVer[3][isFirst][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
   else{
     THROW( "Invalid tap number" );
   }
@@ -769,11 +817,10 @@ void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int sr
  */
 void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf , int n_taps_filter)
 {
-  int n_taps_idx = 4-(n_taps_filter/2);
-
   if( frac == 0 && nFilterIdx < 2 )
   {
     m_filterCopy[true][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+    OP_COUNT( OP_TOOL_INTERP_HOR, 0, width * height, 0, isLast ? 0 : width * height, isLast ? 0 : width * height );
   }
   else if( isLuma( compID ) )
   {
@@ -806,13 +853,24 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, in
     {
       filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_lumaAltHpelIFilter, biMCForDMVR );
     }
+    else if( n_taps_filter != NTAPS_LUMA )
+    {
+      const TFilterCoeff* coeff = m_approxFilterBank->getLumaFilter( n_taps_filter, frac );
+      switch( m_approxFilterBank->getLumaKernelTaps( n_taps_filter ) )
+      {
+      case 2:  filterHor<2>         ( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR ); break;
+      case 4:  filterHor<4>         ( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR ); break;
+      case 6:  filterHor<6>         ( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR ); break;
+      default: filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR ); break;
+      }
+    }
     else if( ( width == 4 && height == 4 ) || ( width == 4 && height == ( 4 + NTAPS_LUMA - 1 ) ) )
     {
       filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilter4x4[frac], biMCForDMVR );
     }
     else
     {
-      filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilter[n_taps_idx][frac], biMCForDMVR );
+      filterHor<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilter[0][frac], biMCForDMVR );
     }
   }
   else
@@ -827,6 +885,18 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, in
     {
       filterHor<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_chromaFilterRPR2[frac << ( 1 - csx )], biMCForDMVR );
     }
+    else if( n_taps_filter < NTAPS_CHROMA )
+    {
+      const TFilterCoeff* coeff = m_approxFilterBank->getChromaFilter( n_taps_filter, frac << ( 1 - csx ) );
+      if( m_approxFilterBank->getChromaKernelTaps( n_taps_filter ) == 2 )
+      {
+        filterHor<2>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR );
+      }
+      else
+      {
+        filterHor<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, coeff, biMCForDMVR );
+      }
+    }
     else
     {
       filterHor<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isLast, m_chromaFilter[frac << ( 1 - csx )], biMCForDMVR );
@@ -853,11 +923,10 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, in
  */
 void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isFirst, bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf , int n_taps_filter)
 {
-  int n_taps_idx = 4-(n_taps_filter/2);
-
   if( frac == 0 && nFilterIdx < 2 )
   {
     m_filterCopy[isFirst][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+    OP_COUNT( OP_TOOL_INTERP_VER, 0, width * height, 0, isFirst == isLast ? 0 : width * height, isFirst == isLast ? 0 : width * height );
   }
   else if( isLuma( compID ) )
   {
@@ -890,13 +959,24 @@ void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, in
     {
       filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaAltHpelIFilter, biMCForDMVR );
     }
+    else if( n_taps_filter != NTAPS_LUMA )
+    {
+      const TFilterCoeff* coeff = m_approxFilterBank->getLumaFilter( n_taps_filter, frac );
+      switch( m_approxFilterBank->getLumaKernelTaps( n_taps_filter ) )
+      {
+      case 2:  filterVer<2>         ( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR ); break;
+      case 4:  filterVer<4>         ( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR ); break;
+      case 6:  filterVer<6>         ( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR ); break;
+      default: filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR ); break;
+      }
+    }
     else if( width == 4 && height == 4 )
     {
       filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilter4x4[frac], biMCForDMVR );
     }
     else
     {
-      filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilter[n_taps_idx][frac], biMCForDMVR );
+      filterVer<NTAPS_LUMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilter[0][frac], biMCForDMVR );
     }
   }
   else
@@ -911,6 +991,18 @@ void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, in
     {
       filterVer<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_chromaFilterRPR2[frac << ( 1 - csy )], biMCForDMVR );
     }
+    else if( n_taps_filter < NTAPS_CHROMA )
+    {
+      const TFilterCoeff* coeff = m_approxFilterBank->getChromaFilter( n_taps_filter, frac << ( 1 - csy ) );
+      if( m_approxFilterBank->getChromaKernelTaps( n_taps_filter ) == 2 )
+      {
+        filterVer<2>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR );
+      }
+      else
+      {
+        filterVer<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, coeff, biMCForDMVR );
+      }
+    }
     else
     {
       filterVer<NTAPS_CHROMA>( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_chromaFilter[frac << ( 1 - csy )], biMCForDMVR );
@@ -40,9 +40,10 @@
 #define __INTERPOLATIONFILTER__
 
 #include "CommonDef.h"
-#include "CacheModel.h"
+#include "Picture.h"
 
 #include "LabUCPel.h"
+#include "ApproxFilterBank.h"
 
 //! \ingroup CommonLib
 //! \{
@@ -89,14 +90,12 @@ public:
   static void xWeightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
   void weightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 protected:
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  static CacheModel* m_cacheModel;
-#endif
+  const ApproxFilterBank* m_approxFilterBank; ///< coefficients used for n_taps_filter below the normative tap count
 public:
   InterpolationFilter();
   ~InterpolationFilter() {}
-  void( *m_filterHor[3][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
-  void( *m_filterVer[3][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
+  void( *m_filterHor[4][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
+  void( *m_filterVer[4][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
   void( *m_filterCopy[2][2] )  ( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR);
   void( *m_weightedGeoBlk )(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 
@@ -108,9 +107,8 @@ public:
 #endif
   void filterHor(const ComponentID compID, Pel const* src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac,               bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx = 0, bool biMCForDMVR = false, bool useAltHpelIf = false , int n_taps_filter =8);
   void filterVer(const ComponentID compID, Pel const* src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isFirst, bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx = 0, bool biMCForDMVR = false, bool useAltHpelIf = false , int n_taps_filter =8);
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  void cacheAssign( CacheModel *cache ) { m_cacheModel = cache; }
-#endif
+  void setApproxFilterBank( const ApproxFilterBank* bank ) { m_approxFilterBank = bank; }
+  const ApproxFilterBank& getApproxFilterBank() const { return *m_approxFilterBank; }
 
   static TFilterCoeff const * const getChromaFilterTable(const int deltaFract) { return m_chromaFilter[deltaFract]; };
 };
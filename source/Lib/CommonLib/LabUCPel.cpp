@@ -1,9 +0,0 @@
-/*
- * To change this license header, choose License Headers in Project Properties.
- * To change this template file, choose Tools | Templates
- * and open the template in the editor.
- */
-
-#include "LabUCPel.h"
-
-int LabUCPel::ntaps_filter;
\ No newline at end of file
@@ -14,12 +14,26 @@
 #ifndef LABUCPEL_H
 #define LABUCPEL_H
 
+#include <string>
 
 #define N_APPROX_FILTERS    4 ///< Number of approximate configus
 
-class LabUCPel{
-public:
-    static int ntaps_filter; 
+/// Approximation settings of one encoder instance. Filled in before EncLib::init() and read-only
+/// afterwards, so it can be shared by all threads of that encoder; mutable per-block state (e.g.
+/// the selected tap count) is kept by the search class using it.
+struct ApproxCfg
+{
+  int         fmeFilterNumTaps;       ///< luma filter taps of the fractional ME interpolation (2, 4, 6 or 8)
+  std::string fmeFilterPolicyFile;    ///< rule file for per-block selection of the FME filter taps, empty: off
+  int         fmePlaneCacheSizeMB;    ///< memory budget of the precomputed fractional reference planes, 0: off
+  std::string fmeFilterBankFile;      ///< coefficient file replacing the built-in approximate filters, empty: built-in
+  int         mcPrescreenLumaNumTaps;   ///< luma filter taps of the merge/affine candidate predictions ranked by SATD (2, 4, 6 or 8)
+  int         mcPrescreenChromaNumTaps; ///< chroma filter taps of the merge/affine candidate predictions ranked by SATD (2 or 4)
+
+  ApproxCfg() : fmeFilterNumTaps( 8 ), fmePlaneCacheSizeMB( 0 ), mcPrescreenLumaNumTaps( 8 ), mcPrescreenChromaNumTaps( 4 ) {}
+
+  /// candidate predictions are approximate, the tested modes need an exact motion compensation
+  bool useApproxMcPrescreen() const { return mcPrescreenLumaNumTaps < 8 || mcPrescreenChromaNumTaps < 4; }
 };
 
 #endif /* LABUCPEL_H */
@@ -44,6 +44,12 @@
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
 
+#if defined( _OPENMP )
+#include <omp.h>
+#include <mutex>
+#include <condition_variable>
+#endif
+
 //! \ingroup CommonLib
 //! \{
 
@@ -93,17 +99,28 @@ static bool isAvailableAbove( const CodingUnit& cu, const CodingUnit& cu2, const
 // ====================================================================================================================
 
 LoopFilter::LoopFilter()
+  : m_enc       ( false )
+  , m_numThreads( 1 )
 {
+  m_filterLumaShort = xFilterLumaShort;
+  m_filterChroma    = xFilterChroma;
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
 {
+  destroy();
 }
 
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
-void LoopFilter::create( const unsigned uiMaxCUDepth )
+void LoopFilter::create( const unsigned uiMaxCUDepth, const int numThreads )
 {
   destroy();
   const unsigned numPartitions = 1 << ( uiMaxCUDepth << 1 );
@@ -113,6 +130,17 @@ void LoopFilter::create( const unsigned uiMaxCUDepth )
     m_aapbEdgeFilter[edgeDir].resize( numPartitions );
   }
   m_enc = false;
+
+#if defined( _OPENMP )
+  m_numThreads = std::max( numThreads, 1 );
+#else
+  m_numThreads = 1;
+#endif
+  for( int i = 1; i < m_numThreads; i++ )
+  {
+    m_threadFilters.push_back( new LoopFilter );
+    m_threadFilters.back()->create( uiMaxCUDepth );
+  }
 }
 
 void LoopFilter::initEncPicYuvBuffer(ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize)
@@ -130,6 +158,13 @@ void LoopFilter::destroy()
     m_aapbEdgeFilter[edgeDir].clear();
   }
   m_encPicYuvBuffer.destroy();
+
+  for( auto& threadFilter : m_threadFilters )
+  {
+    delete threadFilter;
+  }
+  m_threadFilters.clear();
+  m_numThreads = 1;
 }
 
 /**
@@ -157,83 +192,71 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   }
 #endif
 
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+#if defined( _OPENMP )
+  if( m_numThreads > 1 && pcv.heightInCtus > 1 )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    // the vertical edges of a CTU line only touch the samples of that line, its horizontal edges also reach into the
+    // line above, so they are filtered as soon as the vertical edges of both lines are done
+    for( auto& threadFilter : m_threadFilters )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
+      threadFilter->m_shiftHor = m_shiftHor;
+      threadFilter->m_shiftVer = m_shiftVer;
+    }
+    std::vector<int>        verDone( pcv.heightInCtus, 0 );
+    std::mutex              verMutex;
+    std::condition_variable verCond;
 
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads)
+    for( int y = 0; y < pcv.heightInCtus; y++ )
+    {
+      const int   threadIdx = omp_get_thread_num();
+      LoopFilter& filter    = threadIdx == 0 ? *this : *m_threadFilters[threadIdx - 1];
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        xDeblockCU( currCU, EDGE_VER );
+        filter.xDeblockCtu( cs, x, y, EDGE_VER );
       }
-
-      if( CS::isDualITree( cs ) )
       {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
+        std::lock_guard<std::mutex> lock( verMutex );
+        verDone[y] = 1;
+      }
+      verCond.notify_all();
+      if( y > 0 )
+      {
+        std::unique_lock<std::mutex> lock( verMutex );
+        verCond.wait( lock, [&] { return verDone[y - 1] != 0; } );
+      }
 
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
+      for( int x = 0; x < pcv.widthInCtus; x++ )
+      {
+        filter.xDeblockCtu( cs, x, y, EDGE_HOR );
       }
     }
   }
-
-  // Vertical filtering
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+  else
+#endif
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    for( int y = 0; y < pcv.heightInCtus; y++ )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        xDeblockCU( currCU, EDGE_HOR );
+        xDeblockCtu( cs, x, y, EDGE_VER );
       }
+    }
 
-      if( CS::isDualITree( cs ) )
+    for( int y = 0; y < pcv.heightInCtus; y++ )
+    {
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
+        xDeblockCtu( cs, x, y, EDGE_HOR );
       }
     }
   }
 
+  // leave the slice of the last CTU active, as the CTU-wise filtering always did
+  const Position lastCtuPos( ( pcv.widthInCtus - 1 ) << pcv.maxCUWidthLog2, ( pcv.heightInCtus - 1 ) << pcv.maxCUHeightLog2 );
+  cs.slice = cs.getCU( lastCtuPos, CH_L )->slice;
+
   DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
   DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
   DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
@@ -242,6 +265,46 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
 }
 
+void LoopFilter::xDeblockCtu( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+  memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+  memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+  memset( m_transformEdge, false, sizeof(m_transformEdge) );
+  m_ctuXLumaSamples = ctuX << pcv.maxCUWidthLog2;
+  m_ctuYLumaSamples = ctuY << pcv.maxCUHeightLog2;
+
+  const UnitArea ctuArea( pcv.chrFormat, Area( m_ctuXLumaSamples, m_ctuYLumaSamples, pcv.maxCUWidth, pcv.maxCUWidth ) );
+  const Slice&   slice = *cs.getCU( ctuArea.lumaPos(), CH_L )->slice;
+
+  // CS::isDualITree() and CS::getArea() for the slice of the CTU, cs.slice is shared by the filtering threads
+  const bool     isDualITree = slice.isIntra() && !pcv.ISingleTree;
+  const UnitArea lumaArea    = isDualITree || cs.treeType != TREE_D ? ctuArea.singleChan( CH_L ) : ctuArea;
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( lumaArea, CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( isDualITree )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+    memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+    memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+    memset( m_transformEdge, false, sizeof(m_transformEdge) );
+
+    for( auto &currCU : cs.traverseCUs( ctuArea.singleChan( CH_C ), CH_C ) )
+    {
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
+
 void LoopFilter::resetFilterLengths()
 {
   memset(m_aapucBS[EDGE_VER].data(), 0, m_aapucBS[EDGE_VER].byte_size());
@@ -946,7 +1009,7 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   const Slice   &slice    = *(cu.slice);
   const bool    spsPaletteEnabledFlag          = sps.getPLTMode();
   const int     bitDepthLuma                   = sps.getBitDepth(CHANNEL_TYPE_LUMA);
-  const ClpRng& clpRng( cu.cs->slice->clpRng(COMPONENT_Y) );
+  const ClpRng& clpRng( cu.slice->clpRng(COMPONENT_Y) );
 
   int          iQP          = 0;
   unsigned     uiNumParts   = ( ( ( edgeDir == EDGE_VER ) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth ) );
@@ -1167,10 +1230,18 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
                    && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3,
                                           iBeta, iTc);
             }
-            for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+            if (bPartPNoFilter || bPartQNoFilter)
+            {
+              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+              {
+                xPelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, sw,
+                               bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
+              }
+            }
+            else
             {
-              xPelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, sw,
-                             bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
+              m_filterLumaShort(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4), iSrcStep, iOffset,
+                                DEBLOCK_SMALLEST_BLOCK / 2, iTc, sw, iThrCut, bFilterP, bFilterQ, clpRng);
             }
           }
         }
@@ -1311,7 +1382,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
       {
         if ((bS[chromaIdx] == 2) || (largeBoundary && (bS[chromaIdx] == 1)))
         {
-          const ClpRng &clpRng(cu.cs->slice->clpRng(ComponentID(chromaIdx + 1)));
+          const ClpRng &clpRng(cu.slice->clpRng(ComponentID(chromaIdx + 1)));
           Pel *         piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
           const TransformUnit &tuQ = *cuQ.cs->getTU(
@@ -1369,19 +1440,35 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
                                 piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength + ((subSamplingShift == 1) ? 1 : 3)),
                                 iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary);
 
-              for (unsigned step = 0; step < uiLoopLength; step++)
+              if (bPartPNoFilter || bPartQNoFilter)
               {
-                xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, sw,
-                                 bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+                for (unsigned step = 0; step < uiLoopLength; step++)
+                {
+                  xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, sw,
+                                   bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+                }
+              }
+              else
+              {
+                m_filterChroma(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iSrcStep, iOffset, uiLoopLength, iTc,
+                               sw, isChromaHorCTBBoundary, clpRng);
               }
             }
           }
           if (!useLongFilter)
           {
-            for (unsigned step = 0; step < uiLoopLength; step++)
+            if (bPartPNoFilter || bPartQNoFilter)
+            {
+              for (unsigned step = 0; step < uiLoopLength; step++)
+              {
+                xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, false,
+                                 bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+              }
+            }
+            else
             {
-              xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, false,
-                               bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
+              m_filterChroma(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iSrcStep, iOffset, uiLoopLength, iTc,
+                             false, isChromaHorCTBBoundary, clpRng);
             }
           }
         }
@@ -1406,7 +1493,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
+inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc)
 {
   const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1 };
   const char tc3[3] = { 6, 4, 2 };
@@ -1430,7 +1517,7 @@ inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int re
   }
 }
 
-inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
+inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc)
 {
   CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
   Pel* srcP = src-offset;
@@ -1504,7 +1591,7 @@ inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, i
   xBilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
 }
 
-inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ) const
+inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ)
 {
   int delta;
 
@@ -1604,7 +1691,7 @@ inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const
+inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary)
 {
   int delta;
 
@@ -1664,6 +1751,22 @@ inline void LoopFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const in
   }
 }
 
+void LoopFilter::xFilterLumaShort( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  for( int i = 0; i < numLines; i++ )
+  {
+    xPelFilterLuma( src + step * i, offset, tc, sw, false, false, thrCut, filterSecondP, filterSecondQ, clpRng );
+  }
+}
+
+void LoopFilter::xFilterChroma( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const bool isChromaHorCTBBoundary, const ClpRng& clpRng )
+{
+  for( int i = 0; i < numLines; i++ )
+  {
+    xPelFilterChroma( src + step * i, offset, tc, sw, false, false, clpRng, false, isChromaHorCTBBoundary );
+  }
+}
+
 /**
  - Decision between strong and weak filter
  .
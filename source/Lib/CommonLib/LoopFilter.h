@@ -65,6 +65,8 @@ private:
   bool    m_transformEdge[MAX_NUM_COMPONENT][MAX_CU_SIZE][MAX_CU_SIZE];    // transform edge flag for [component][luma/chroma sample distance from left edge of CTU][luma/chroma sample distance from top edge of CTU]
   PelStorage                   m_encPicYuvBuffer;
   bool                         m_enc;
+  int                          m_numThreads;
+  std::vector<LoopFilter*>     m_threadFilters;   ///< CTU state of the additional threads of the CTU-line parallel filtering
 private:
 
   // set / get functions
@@ -81,6 +83,7 @@ private:
                                     const bool            EdgeIdx = false );
   void xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge);
+  void xDeblockCtu                ( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir );
 
 #if LUMA_ADAPTIVE_DEBLOCKING_FILTER_QP_OFFSET
   void deriveLADFShift( const Pel* src, const int stride, int& shift, const DeblockEdgeDir edgeDir, const SPS sps );
@@ -89,10 +92,10 @@ private:
                                                const TransformUnit &currTU, const int firstComponent);
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const;
+  static inline void xBilinearFilter ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma  ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 );
+  static inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary);
   inline bool xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7, bool isChromaHorCTBBoundary = false) const;//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
@@ -110,13 +113,27 @@ public:
   LoopFilter();
   ~LoopFilter();
 
+  /// short luma filter (strong or weak) of numLines lines across an edge, sides without palette coding
+  void( *m_filterLumaShort )( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng );
+  /// chroma filter (strong or weak) of numLines lines across an edge, sides without palette coding
+  void( *m_filterChroma )   ( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const bool isChromaHorCTBBoundary, const ClpRng& clpRng );
+
+  static void xFilterLumaShort( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng );
+  static void xFilterChroma   ( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const bool isChromaHorCTBBoundary, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
+
   /// CU-level deblocking function
   void xDeblockCU(CodingUnit& cu, const DeblockEdgeDir edgeDir);
   void  initEncPicYuvBuffer(ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize);
   PelStorage& getDbEncPicYuvBuffer() { return m_encPicYuvBuffer; }
   void  setEnc(bool b) { m_enc = b; }
 
-  void  create                    ( const unsigned uiMaxCUDepth );
+  void  create                    ( const unsigned uiMaxCUDepth, const int numThreads = 1 );
   void  destroy                   ();
 
   /// picture-level deblocking filter
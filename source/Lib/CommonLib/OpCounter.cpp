@@ -0,0 +1,144 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     OpCounter.cpp
+    \brief    arithmetic operation counters for interpolation, distortion and transforms
+*/
+
+#include "OpCounter.h"
+
+#if ENABLE_OP_COUNTERS
+
+//! \ingroup CommonLib
+//! \{
+
+// energy per operation for 32-bit integer arithmetic in a 45nm process (Horowitz, ISSCC 2014),
+// a shift is assumed to cost as much as an addition
+static const double OP_ENERGY_MUL_PJ   = 3.1;
+static const double OP_ENERGY_ADD_PJ   = 0.1;
+static const double OP_ENERGY_SHIFT_PJ = 0.1;
+
+static const char *OP_TOOL_NAMES[NUM_OP_TOOLS] = { "Interp(H)", "Interp(V)", "SSE", "SAD", "HAD", "Trafo(F)", "Trafo(I)" };
+
+std::atomic<uint64_t> OpCounter::m_frameCount[NUM_OP_TOOLS][MAX_TAPS + 1][NUM_OP_FIELDS];
+uint64_t              OpCounter::m_seqCount  [NUM_OP_TOOLS][MAX_TAPS + 1][NUM_OP_FIELDS] = { { { 0 } } };
+int                   OpCounter::m_numFrames = 0;
+
+void OpCounter::count( OpCounterTool tool, int taps, uint64_t samples, uint64_t muls, uint64_t adds, uint64_t shifts )
+{
+  CHECK( taps < 0 || taps > MAX_TAPS, "Invalid tap configuration" );
+  std::atomic<uint64_t> *cnt = m_frameCount[tool][taps];
+  cnt[OP_CALLS]  .fetch_add( 1,       std::memory_order_relaxed );
+  cnt[OP_SAMPLES].fetch_add( samples, std::memory_order_relaxed );
+  cnt[OP_MULS]   .fetch_add( muls,    std::memory_order_relaxed );
+  cnt[OP_ADDS]   .fetch_add( adds,    std::memory_order_relaxed );
+  cnt[OP_SHIFTS] .fetch_add( shifts,  std::memory_order_relaxed );
+}
+
+double OpCounter::xGetEnergy( const uint64_t *count )
+{
+  return ( count[OP_MULS] * OP_ENERGY_MUL_PJ + count[OP_ADDS] * OP_ENERGY_ADD_PJ + count[OP_SHIFTS] * OP_ENERGY_SHIFT_PJ ) * 1e-6;
+}
+
+void OpCounter::reportFrame()
+{
+  uint64_t frameOps[NUM_OP_TOOLS] = { 0 };
+  uint64_t total   [NUM_OP_FIELDS] = { 0 };
+
+  for( int tool = 0; tool < NUM_OP_TOOLS; tool++ )
+  {
+    for( int taps = 0; taps <= MAX_TAPS; taps++ )
+    {
+      for( int field = 0; field < NUM_OP_FIELDS; field++ )
+      {
+        const uint64_t value = m_frameCount[tool][taps][field].exchange( 0, std::memory_order_relaxed );
+        m_seqCount[tool][taps][field] += value;
+        total[field]                  += value;
+        if( field >= OP_MULS )
+        {
+          frameOps[tool] += value;
+        }
+      }
+    }
+  }
+  m_numFrames++;
+
+  msg( NOTICE, " [OPS Interp %.2fM Dist %.2fM Trafo %.2fM E %.1f uJ]",
+       ( frameOps[OP_TOOL_INTERP_HOR] + frameOps[OP_TOOL_INTERP_VER] ) * 1e-6,
+       ( frameOps[OP_TOOL_DIST_SSE] + frameOps[OP_TOOL_DIST_SAD] + frameOps[OP_TOOL_DIST_HAD] ) * 1e-6,
+       ( frameOps[OP_TOOL_TRANSFORM_FWD] + frameOps[OP_TOOL_TRANSFORM_INV] ) * 1e-6,
+       xGetEnergy( total ) );
+}
+
+void OpCounter::reportSequence()
+{
+  if( m_numFrames == 0 )
+  {
+    return;
+  }
+
+  msg( INFO, "\nOperation counts over %d frames (nominal, per sample operation model)\n", m_numFrames );
+  msg( INFO, "\t     Tool Taps |        Calls   Samples(M)       Mul(M)       Add(M)     Shift(M) |  Energy(uJ)\n" );
+
+  uint64_t total[NUM_OP_FIELDS] = { 0 };
+  for( int tool = 0; tool < NUM_OP_TOOLS; tool++ )
+  {
+    for( int taps = 0; taps <= MAX_TAPS; taps++ )
+    {
+      const uint64_t *count = m_seqCount[tool][taps];
+      if( count[OP_CALLS] == 0 )
+      {
+        continue;
+      }
+      const bool isInterp = tool == OP_TOOL_INTERP_HOR || tool == OP_TOOL_INTERP_VER;
+      const std::string tapsName = !isInterp ? "-" : taps ? std::to_string( taps ) : "copy";
+      msg( INFO, "\t%9s %4s | %12llu %12.3f %12.3f %12.3f %12.3f | %11.1f\n", OP_TOOL_NAMES[tool], tapsName.c_str(),
+           ( unsigned long long ) count[OP_CALLS], count[OP_SAMPLES] * 1e-6, count[OP_MULS] * 1e-6, count[OP_ADDS] * 1e-6, count[OP_SHIFTS] * 1e-6,
+           xGetEnergy( count ) );
+      for( int field = 0; field < NUM_OP_FIELDS; field++ )
+      {
+        total[field] += count[field];
+      }
+    }
+  }
+  msg( INFO, "\t     Total      | %12llu %12.3f %12.3f %12.3f %12.3f | %11.1f\n",
+       ( unsigned long long ) total[OP_CALLS], total[OP_SAMPLES] * 1e-6, total[OP_MULS] * 1e-6, total[OP_ADDS] * 1e-6, total[OP_SHIFTS] * 1e-6,
+       xGetEnergy( total ) );
+  msg( INFO, "\t     Per frame  | %12.0f %12.3f %12.3f %12.3f %12.3f | %11.1f\n",
+       double( total[OP_CALLS] ) / m_numFrames, total[OP_SAMPLES] * 1e-6 / m_numFrames, total[OP_MULS] * 1e-6 / m_numFrames,
+       total[OP_ADDS] * 1e-6 / m_numFrames, total[OP_SHIFTS] * 1e-6 / m_numFrames, xGetEnergy( total ) / m_numFrames );
+}
+
+//! \}
+
+#endif // ENABLE_OP_COUNTERS
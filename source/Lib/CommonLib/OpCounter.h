@@ -0,0 +1,99 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     OpCounter.h
+    \brief    arithmetic operation counters for interpolation, distortion and transforms (header)
+*/
+
+#ifndef __OPCOUNTER__
+#define __OPCOUNTER__
+
+#include "CommonDef.h"
+
+//! \ingroup CommonLib
+//! \{
+
+// function list
+#if !ENABLE_OP_COUNTERS
+#define OP_COUNT( tool, taps, samples, muls, adds, shifts ) /* do nothing */
+#else
+#define OP_COUNT( tool, taps, samples, muls, adds, shifts ) OpCounter::count( tool, taps, samples, muls, adds, shifts )
+
+#include <atomic>
+
+enum OpCounterTool
+{
+  OP_TOOL_INTERP_HOR = 0,
+  OP_TOOL_INTERP_VER,
+  OP_TOOL_DIST_SSE,
+  OP_TOOL_DIST_SAD,
+  OP_TOOL_DIST_HAD,
+  OP_TOOL_TRANSFORM_FWD,
+  OP_TOOL_TRANSFORM_INV,
+  NUM_OP_TOOLS
+};
+
+/// nominal operation counts of the instrumented kernels, accumulated per frame and per sequence
+/// the tap configuration is 0 for sample copies (interpolation) and for tools without taps
+class OpCounter
+{
+public:
+  static const int MAX_TAPS = NTAPS_LUMA;
+
+  static void count( OpCounterTool tool, int taps, uint64_t samples, uint64_t muls, uint64_t adds, uint64_t shifts );
+  static void reportFrame();    ///< append the frame totals to the current POC line and move them to the sequence totals
+  static void reportSequence(); ///< print the per tool and per tap configuration breakdown of the sequence
+
+private:
+  enum OpCounterField
+  {
+    OP_CALLS = 0,
+    OP_SAMPLES,
+    OP_MULS,
+    OP_ADDS,
+    OP_SHIFTS,
+    NUM_OP_FIELDS
+  };
+
+  static double xGetEnergy( const uint64_t *count ); ///< in uJ
+
+  static std::atomic<uint64_t> m_frameCount[NUM_OP_TOOLS][MAX_TAPS + 1][NUM_OP_FIELDS];
+  static uint64_t              m_seqCount  [NUM_OP_TOOLS][MAX_TAPS + 1][NUM_OP_FIELDS];
+  static int                   m_numFrames;
+};
+
+#endif // ENABLE_OP_COUNTERS
+
+//! \}
+
+#endif // __OPCOUNTER__
@@ -41,7 +41,7 @@
 #include "CommonLib/InterpolationFilter.h"
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
 int g_wppThreadId( 0 );
 #pragma omp threadprivate(g_wppThreadId)
@@ -54,9 +54,18 @@ int g_splitJobId( 0 );
 #pragma omp threadprivate(g_splitJobId)
 #endif
 
-Scheduler::Scheduler() :
+Scheduler::Scheduler()
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads( 1 )
+  : m_numSplitThreads( 1 )
+#if ENABLE_WPP_PARALLELISM
+  , m_numWppThreads  ( 1 )
+  , m_ctuXsize       ( 0 )
+  , m_frameDataId    ( 0 )
+#endif
+#elif ENABLE_WPP_PARALLELISM
+  : m_numWppThreads  ( 1 )
+  , m_ctuXsize       ( 0 )
+  , m_frameDataId    ( 0 )
 #endif
 {
 }
@@ -131,6 +140,47 @@ void Scheduler::setSplitThreadId( const int tId )
 
 
 
+#if ENABLE_WPP_PARALLELISM
+unsigned Scheduler::getWppDataId() const
+{
+  return m_numWppThreads > 1 ? g_wppThreadId : 0;
+}
+
+void Scheduler::setWppThreadId( const int tId )
+{
+  g_wppThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+}
+
+void Scheduler::resetLines()
+{
+  std::fill( m_lineDone.begin(), m_lineDone.end(), 0 );
+}
+
+void Scheduler::wait( const int ctuPosX, const int ctuPosY )
+{
+  if( ctuPosY == 0 )
+  {
+    return;
+  }
+
+  // WPP dependency: the top-right CTU has to be finished before the current one can start
+  const int required = std::min( ctuPosX + 2, m_ctuXsize );
+
+  std::unique_lock<std::mutex> lock( m_lineMutex );
+  m_lineCond.wait( lock, [&] { return m_lineDone[ctuPosY - 1] >= required; } );
+}
+
+void Scheduler::setReady( const int ctuPosX, const int ctuPosY )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_lineMutex );
+    m_lineDone[ctuPosY] = ctuPosX + 1;
+  }
+  m_lineCond.notify_all();
+}
+
+#endif
+
 unsigned Scheduler::getDataId() const
 {
 #if ENABLE_SPLIT_PARALLELISM
@@ -139,7 +189,15 @@ unsigned Scheduler::getDataId() const
     return getSplitDataId();
   }
 #endif
+#if ENABLE_WPP_PARALLELISM
+  if( m_numWppThreads > 1 )
+  {
+    return getWppDataId();
+  }
+  return m_frameDataId;
+#else
   return 0;
+#endif
 }
 
 bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads )
@@ -147,6 +205,12 @@ bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppTh
 #if ENABLE_SPLIT_PARALLELISM
   m_numSplitThreads = numSplitThreads;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  m_numWppThreads = numWppThreadsRunning;
+  m_ctuXsize      = ctuXsize;
+  m_lineDone.assign( ctuYsize, 0 );
+  m_frameDataId   = 0;
+#endif
 
   return true;
 }
@@ -382,7 +446,11 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
   }
   else
   {
+#if ENABLE_WPP_PARALLELISM
+    cs = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
+#else
     cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+#endif
     cs->sps = &sps;
     cs->create(chromaFormatIDC, Area(0, 0, iWidth, iHeight), true, (bool)sps.getPLTMode());
   }
@@ -50,7 +50,11 @@
 #include "MCTS.h"
 #include <deque>
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+#include <mutex>
+#if ENABLE_WPP_PARALLELISM
+#include <condition_variable>
+#endif
 
 #define CURR_THREAD_ID -1
 
@@ -69,15 +73,36 @@ public:
   void     finishParallel();
   void     setSplitThreadId( const int tId = CURR_THREAD_ID );
   unsigned getNumSplitThreads() const { return m_numSplitThreads; };
+#endif
+#if ENABLE_WPP_PARALLELISM
+  unsigned getWppDataId  () const;
+  void     setWppThreadId( const int tId = CURR_THREAD_ID );
+  unsigned getNumWppThreads() const { return m_numWppThreads; };
+  void     resetLines    ();
+  void     wait          ( const int ctuPosX, const int ctuPosY );
+  void     setReady      ( const int ctuPosX, const int ctuPosY );
+  void     setFrameDataId( const int dataId ) { m_frameDataId = dataId; }
 #endif
   unsigned getDataId     () const;
   bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads );
   int  getNumPicInstances() const;
+  std::mutex& getCsMutex () { return m_csMutex; }
+
+  std::mutex              m_csMutex;         ///< guards the picture-level coding structure while CTU lines or split jobs write to it
 #if ENABLE_SPLIT_PARALLELISM
 
   int   m_numSplitThreads;
   bool  m_hasParallelBuffer;
 #endif
+#if ENABLE_WPP_PARALLELISM
+
+  int                     m_numWppThreads;
+  int                     m_ctuXsize;
+  std::vector<int>        m_lineDone;        ///< number of finished CTUs per CTU line
+  std::mutex              m_lineMutex;
+  std::condition_variable m_lineCond;
+  int                     m_frameDataId;     ///< CU encoder stack of the frame context compressing the picture
+#endif
 };
 #endif
 
@@ -295,10 +320,13 @@ private:
 public:
   void finishParallelPart   ( const UnitArea& ctuArea );
 #endif
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 public:
   Scheduler                  scheduler;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  XUCache                    m_unitCache;       ///< units of the picture-level coding structure, pictures of a frame batch are compressed concurrently
+#endif
 
 public:
   SAOBlkParam    *getSAO(int id = 0)                        { return &m_sao[id][0]; };
@@ -41,6 +41,7 @@
 
 #include "Rom.h"
 #include "UnitPartitioner.h"
+#include "OpCounter.h"
 
 #include <limits>
 
@@ -50,6 +51,75 @@
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
 
+#if ENABLE_OP_COUNTERS
+// the distortion function table is wrapped by counting trampolines, which forward to the functions installed by init()
+static FpDistFunc g_afpDistortFuncUncounted[DF_TOTAL_FUNCTIONS] = { nullptr, };
+
+static inline int xGetHadButterflyStages( int width, int height )
+{
+  if( width == height )
+  {
+    return ( width & 7 ) == 0 ? 6 : ( width & 3 ) == 0 ? 4 : 2;
+  }
+  const int minSize = std::min( width, height );
+  const int maxSize = std::max( width, height );
+  if( ( minSize & 7 ) == 0 && ( maxSize & 15 ) == 0 )
+  {
+    return 7;
+  }
+  if( ( minSize & 3 ) == 0 && ( maxSize & 7 ) == 0 )
+  {
+    return 5;
+  }
+  return ( minSize & 7 ) == 0 ? 6 : ( minSize & 3 ) == 0 ? 4 : 2;
+}
+
+template<int DF>
+static Distortion xGetDistCounted( const DistParam &rcDtParam )
+{
+  const uint64_t samples = uint64_t( rcDtParam.org.width ) * ( rcDtParam.org.height >> rcDtParam.subShift );
+
+  if( ( DF >= DF_SSE && DF <= DF_SSE16N ) || ( DF >= DF_SSE_WTD && DF <= DF_DEFAULT_ORI ) )
+  {
+    // difference, square, shift to the internal precision and accumulation
+    OP_COUNT( OP_TOOL_DIST_SSE, 0, samples, samples, 2 * samples, samples );
+  }
+  else if( ( DF >= DF_HAD && DF <= DF_HAD16N ) || ( DF >= DF_MRHAD && DF <= DF_MRHAD16N ) )
+  {
+    // difference, 2-D butterflies, absolute value and accumulation
+    const uint64_t stages = xGetHadButterflyStages( rcDtParam.org.width, rcDtParam.org.height >> rcDtParam.subShift );
+    OP_COUNT( OP_TOOL_DIST_HAD, 0, samples, 0, ( 3 + stages ) * samples, 0 );
+  }
+  else
+  {
+    // difference, absolute value and accumulation
+    OP_COUNT( OP_TOOL_DIST_SAD, 0, samples, 0, 3 * samples, 0 );
+  }
+
+  return g_afpDistortFuncUncounted[DF]( rcDtParam );
+}
+
+template<int DF>
+struct DistCounterWrapper
+{
+  static void wrap( FpDistFunc *distortFunc )
+  {
+    if( distortFunc[DF] != nullptr && distortFunc[DF] != xGetDistCounted<DF> )
+    {
+      g_afpDistortFuncUncounted[DF] = distortFunc[DF];
+      distortFunc[DF]               = xGetDistCounted<DF>;
+    }
+    DistCounterWrapper<DF - 1>::wrap( distortFunc );
+  }
+};
+
+template<>
+struct DistCounterWrapper<-1>
+{
+  static void wrap( FpDistFunc * ) {}
+};
+#endif
+
 RdCost::RdCost()
 {
   init();
@@ -220,6 +290,10 @@ void RdCost::init()
 #endif
 #endif
 
+#if ENABLE_OP_COUNTERS
+  DistCounterWrapper<DF_TOTAL_FUNCTIONS - 1>::wrap( m_afpDistortFunc );
+#endif
+
   m_costMode                   = COST_STANDARD_LOSSY;
 
   m_motionLambda               = 0;
@@ -229,7 +303,7 @@ void RdCost::init()
 }
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
 void RdCost::copyState( const RdCost& other )
 {
@@ -293,7 +293,7 @@ public:
     return length;
   }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void copyState( const RdCost& other );
 #endif
 
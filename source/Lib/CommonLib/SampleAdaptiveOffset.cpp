@@ -48,6 +48,10 @@
 #include <stdio.h>
 #include <math.h>
 
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
 //! \ingroup CommonLib
 //! \{
 
@@ -113,6 +117,17 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+  m_numThreads         = 1;
+
+  m_offsetEdgeBlk   = offsetEdgeBlk;
+  m_offsetBandBlk   = offsetBandBlk;
+  m_getEdgeStatsBlk = getEdgeStatsBlk;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
@@ -124,7 +139,7 @@ SampleAdaptiveOffset::~SampleAdaptiveOffset()
   m_signLineBuf2.clear();
 }
 
-void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift )
+void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift, const int numThreads )
 {
   //temporary picture buffer
   UnitArea picArea(format, Area(0, 0, picWidth, picHeight));
@@ -138,6 +153,7 @@ void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat for
     m_offsetStepLog2  [compIdx] = isLuma(ComponentID(compIdx))? lumaBitShift : chromaBitShift;
   }
   m_numberOfComponents = getNumberValidComponents(format);
+  m_numThreads         = numThreads;
 }
 
 void SampleAdaptiveOffset::destroy()
@@ -296,6 +312,18 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
 {
+  if( typeIdx == SAO_TYPE_BO )
+  {
+    m_offsetBandBlk( srcBlk, srcStride, resBlk, resStride, width, height, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, offset, clpRng );
+    return;
+  }
+  if( !isCtuCrossedByVirtualBoundaries )
+  {
+    offsetEdgeBlock( clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                   , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail );
+    return;
+  }
+
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -525,18 +553,60 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       }
     }
     break;
-  case SAO_TYPE_BO:
+  default:
     {
-      const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      THROW("Not a supported SAO types\n");
+    }
+  }
+}
+
+void SampleAdaptiveOffset::offsetEdgeBlock(const ClpRng& clpRng, int typeIdx, const int* offset
+                                          , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height
+                                          , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+  )
+{
+  // without virtual boundaries every sample only depends on its two neighbours, so the sign lines are not needed
+  const int startX = isLeftAvail ? 0 : 1;
+  const int endX   = isRightAvail ? width : (width - 1);
+
+  switch(typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    {
+      m_offsetEdgeBlk( srcBlk, srcStride, resBlk, resStride, -1, 1, startX, endX, height, offset, clpRng );
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const int startY = isAboveAvail ? 0 : 1;
+      const int endY   = isBelowAvail ? height : (height - 1);
+      m_offsetEdgeBlk( srcBlk + startY * srcStride, srcStride, resBlk + startY * resStride, resStride, -srcStride, srcStride, 0, width, endY - startY, offset, clpRng );
+    }
+    break;
+  case SAO_TYPE_EO_135:
+    {
+      const int posA = -srcStride - 1;
+      const int posB =  srcStride + 1;
+      //1st line
+      m_offsetEdgeBlk( srcBlk, srcStride, resBlk, resStride, posA, posB, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, 1, offset, clpRng );
+      //middle lines
+      m_offsetEdgeBlk( srcBlk + srcStride, srcStride, resBlk + resStride, resStride, posA, posB, startX, endX, height - 2, offset, clpRng );
+      //last line
+      m_offsetEdgeBlk( srcBlk + (height - 1) * srcStride, srcStride, resBlk + (height - 1) * resStride, resStride, posA, posB,
+                       isBelowAvail ? startX : (width - 1), isBelowRightAvail ? width : (width - 1), 1, offset, clpRng );
+    }
+    break;
+  case SAO_TYPE_EO_45:
+    {
+      const int posA = -srcStride + 1;
+      const int posB =  srcStride - 1;
+      //first line
+      m_offsetEdgeBlk( srcBlk, srcStride, resBlk, resStride, posA, posB, isAboveAvail ? startX : (width - 1), isAboveRightAvail ? width : (width - 1), 1, offset, clpRng );
+      //middle lines
+      m_offsetEdgeBlk( srcBlk + srcStride, srcStride, resBlk + resStride, resStride, posA, posB, startX, endX, height - 2, offset, clpRng );
+      //last line
+      m_offsetEdgeBlk( srcBlk + (height - 1) * srcStride, srcStride, resBlk + (height - 1) * resStride, resStride, posA, posB,
+                       isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1, 1, offset, clpRng );
     }
     break;
   default:
@@ -546,6 +616,48 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+void SampleAdaptiveOffset::offsetEdgeBlk( const Pel* src, const int srcStride, Pel* res, const int resStride, const int posA, const int posB, const int startX, const int endX, const int height, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x + posA] ) + sgn( src[x] - src[x + posB] ) + 2;
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::offsetBandBlk( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::getEdgeStatsBlk( const Pel* src, const int srcStride, const Pel* org, const int orgStride, const int posA, const int posB, const int startX, const int endX, const int height, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x + posA] ) + sgn( src[x] - src[x + posB] ) + 2;
+      diff [edgeType] += ( org[x] - src[x] );
+      count[edgeType] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs)
 {
   const uint32_t numberOfComponents = getNumberValidComponents( area.chromaFormat );
@@ -567,19 +679,20 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int numHorVirBndry = 0, numVerVirBndry = 0;
   int horVirBndryPos[] = { -1,-1,-1 };
   int verVirBndryPos[] = { -1,-1,-1 };
   int horVirBndryPosComp[] = { -1,-1,-1 };
   int verVirBndryPosComp[] = { -1,-1,-1 };
   bool isCtuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries(area.Y().x, area.Y().y, area.Y().width, area.Y().height, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, cs.picHeader );
+
+  // the sign lines are only used next to virtual boundaries
+  const size_t lineBufferSize = area.Y().width + 1;
+  if (isCtuCrossedByVirtualBoundaries && m_signLineBuf1.size() < lineBufferSize)
+  {
+    m_signLineBuf1.resize(lineBufferSize);
+    m_signLineBuf2.resize(lineBufferSize);
+  }
   for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     const ComponentID compID = ComponentID(compIdx);
@@ -640,18 +753,20 @@ void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
   PelUnitBuf rec = cs.getRecoBuf();
   m_tempBuf.copyFrom( rec );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  // every CTU reads the unfiltered copy and writes its own area, the shared sign lines of the virtual boundary path keep that one serial
+  const int numThreads = cs.picHeader->getVirtualBoundariesPresentFlag() ? 1 : std::min<int>( m_numThreads, pcv.sizeInCtus );
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+#endif
+  for( int ctuRsAddr = 0; ctuRsAddr < (int)pcv.sizeInCtus; ctuRsAddr++ )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const uint32_t xPos   = ( ctuRsAddr % pcv.widthInCtus ) * pcv.maxCUWidth;
+    const uint32_t yPos   = ( ctuRsAddr / pcv.widthInCtus ) * pcv.maxCUHeight;
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
-    }
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
   }
 
   DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
@@ -67,10 +67,27 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
-  void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
+  void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift, const int numThreads = 1 );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+
+  /// edge offset of rows [0,height) columns [startX,endX), the neighbours of a sample are at posA and posB relative to it
+  void( *m_offsetEdgeBlk )  ( const Pel* src, const int srcStride, Pel* res, const int resStride, const int posA, const int posB, const int startX, const int endX, const int height, const int* offset, const ClpRng& clpRng );
+  /// band offset of a width x height block
+  void( *m_offsetBandBlk )  ( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  /// edge offset statistics (org - src sums and sample counts per edge class) of rows [0,height) columns [startX,endX)
+  void( *m_getEdgeStatsBlk )( const Pel* src, const int srcStride, const Pel* org, const int orgStride, const int posA, const int posB, const int startX, const int endX, const int height, int64_t* diff, int64_t* count );
+
+  static void offsetEdgeBlk  ( const Pel* src, const int srcStride, Pel* res, const int resStride, const int posA, const int posB, const int startX, const int endX, const int height, const int* offset, const ClpRng& clpRng );
+  static void offsetBandBlk  ( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  static void getEdgeStatsBlk( const Pel* src, const int srcStride, const Pel* org, const int orgStride, const int posA, const int posB, const int startX, const int endX, const int height, int64_t* diff, int64_t* count );
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -87,6 +104,9 @@ protected:
                   , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                   , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
     );
+  void offsetEdgeBlock(const ClpRng& clpRng, int typeIdx, const int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height
+                      , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+    );
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
@@ -119,6 +139,7 @@ protected:
   uint32_t m_offsetStepLog2[MAX_NUM_COMPONENT]; //offset step
   PelStorage m_tempBuf;
   uint32_t m_numberOfComponents;
+  int      m_numThreads;
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
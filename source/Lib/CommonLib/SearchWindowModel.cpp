@@ -0,0 +1,195 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010 - 2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** \file     SearchWindowModel.cpp
+    \brief    reference search window buffer model
+
+    Hardware motion estimation typically keeps a search window of each reference picture on chip. The window covers the
+    current CTU plus a margin and slides with the CTU, so that horizontally adjacent CTUs only load the new columns. Reads
+    outside of the window are counted as separate external memory fetches.
+*/
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "SearchWindowModel.h"
+
+// intersection of two rectangles, empty areas have zero size
+static Area xIntersect( const Area &a, const Area &b )
+{
+  const int left   = std::max( a.x, b.x );
+  const int top    = std::max( a.y, b.y );
+  const int right  = std::min( a.x + (int) a.width,  b.x + (int) b.width );
+  const int bottom = std::min( a.y + (int) a.height, b.y + (int) b.height );
+
+  if( right <= left || bottom <= top )
+  {
+    return Area();
+  }
+  return Area( left, top, right - left, bottom - top );
+}
+
+SearchWindowModel::SearchWindowModel()
+  : m_bytesPerSample( 1 )
+  , m_refPic( nullptr )
+  , m_base( nullptr )
+  , m_stride( 0 )
+  , m_margin( 0 )
+  , m_frameCount( 0 )
+{
+}
+
+void SearchWindowModel::create( const SearchWindowCfg &cfg, int searchRange, int ctuSize, int bitDepth )
+{
+  m_cfg = cfg;
+  if( !m_cfg.enable )
+  {
+    return;
+  }
+  // the fractional refinement around a search result at the range limit reads the filter support beyond it
+  if( m_cfg.marginHor == 0 )
+  {
+    m_cfg.marginHor = searchRange + NTAPS_LUMA;
+  }
+  if( m_cfg.marginVer == 0 )
+  {
+    m_cfg.marginVer = searchRange + NTAPS_LUMA;
+  }
+  m_ctuSize        = Size( ctuSize, ctuSize );
+  m_bytesPerSample = bitDepth > 8 ? 2 : 1;
+  m_seqStats       = SearchWindowStats();
+  m_frameCount     = 0;
+  clear();
+}
+
+// invalidate all windows, called at the end of each frame
+void SearchWindowModel::clear()
+{
+  m_window.clear();
+  m_frameStats.clear();
+}
+
+Area SearchWindowModel::getWindow( const Position &ctuPos ) const
+{
+  return Area( ctuPos.x - m_cfg.marginHor, ctuPos.y - m_cfg.marginVer, m_ctuSize.width + 2 * m_cfg.marginHor, m_ctuSize.height + 2 * m_cfg.marginVer );
+}
+
+void SearchWindowModel::setRefPicture( const Picture *refPic )
+{
+  if( refPic != m_refPic )
+  {
+    m_refPic  = refPic;
+    m_base    = refPic->getOrigin( PIC_RECONSTRUCTION, COMPONENT_Y );
+    m_stride  = refPic->getRecoBuf( COMPONENT_Y ).stride;
+    m_margin  = refPic->margin;
+    m_picArea = Area( 0, 0, refPic->lwidth(), refPic->lheight() );
+  }
+}
+
+// account a luma block read of the current reference picture
+void SearchWindowModel::blockAccess( const Pel *buf, int width, int height )
+{
+  const ptrdiff_t offset = buf - m_base;
+  CHECKD( offset < 0, "Access outside of the padded reference picture" );
+
+  // samples in the padding are replicated on chip, only the picture area is fetched
+  const Area block = xIntersect( Area( int( offset % m_stride ) - m_margin, int( offset / m_stride ) - m_margin, width, height ), m_picArea );
+  const Area window = xIntersect( getWindow( m_ctuPos ), m_picArea );
+
+  const int refPoc = m_refPic->getPOC();
+  SearchWindowStats &stats = m_frameStats[refPoc];
+  Area &held = m_window[refPoc];
+
+  // the window of a reference picture is loaded on its first use in a CTU
+  if( held != window )
+  {
+    stats.loaded += window.area() - ( m_cfg.ctuReuse ? xIntersect( held, window ).area() : 0 );
+    held = window;
+  }
+
+  stats.access  += block.area();
+  stats.outside += block.area() - xIntersect( block, window ).area();
+}
+
+SearchWindowStats SearchWindowModel::xGetFrameStats() const
+{
+  SearchWindowStats frameStats;
+  for( const auto &refStats : m_frameStats )
+  {
+    frameStats.add( refStats.second );
+  }
+  return frameStats;
+}
+
+void SearchWindowModel::accumulateFrame()
+{
+  if( m_cfg.enable )
+  {
+    m_seqStats.add( xGetFrameStats() );
+    m_frameCount++;
+  }
+}
+
+void SearchWindowModel::reportFrame( int poc )
+{
+  if( m_cfg.enable )
+  {
+    const SearchWindowStats frameStats = xGetFrameStats();
+    const double kb = m_bytesPerSample / 1024.0;
+
+    fprintf( stdout, "Search window POC %d: window load %.1f [KB] out-of-window %.1f [KB] (%.2f %% of reads) external %.1f [KB]\n", poc,
+             frameStats.loaded * kb, frameStats.outside * kb, 100.0 * frameStats.outside / std::max<int64_t>( 1, frameStats.access ), frameStats.getExternal() * kb );
+    for( const auto &ref : m_frameStats )
+    {
+      fprintf( stdout, "  ref POC %4d: access %10" PRIi64 " window load %10" PRIi64 " out-of-window %10" PRIi64 "\n", ref.first,
+               ref.second.access, ref.second.loaded, ref.second.outside );
+    }
+  }
+}
+
+void SearchWindowModel::reportSequence() const
+{
+  if( m_cfg.enable )
+  {
+    const double mbPerFrame = m_bytesPerSample / ( 1024.0 * 1024.0 * std::max( 1, m_frameCount ) );
+
+    fprintf( stdout, "Search window config\n" );
+    fprintf( stdout, "CTU margin %d x %d, window %d x %d, CTU reuse %d, search clamped to window %d\n\n", m_cfg.marginHor, m_cfg.marginVer,
+             m_ctuSize.width + 2 * m_cfg.marginHor, m_ctuSize.height + 2 * m_cfg.marginVer, m_cfg.ctuReuse, m_cfg.clampSearch );
+
+    fprintf( stdout, "Search window statistics in total\n" );
+    fprintf( stdout, "Luma samples read %" PRIi64 ", out-of-window %" PRIi64 " (%.2f %%)\n", m_seqStats.access, m_seqStats.outside,
+             100.0 * m_seqStats.outside / std::max<int64_t>( 1, m_seqStats.access ) );
+    fprintf( stdout, "Window load %.2f [MB] / frame\n", m_seqStats.loaded * mbPerFrame );
+    fprintf( stdout, "External bandwidth %.2f [MB] / frame\n", m_seqStats.getExternal() * mbPerFrame );
+  }
+}
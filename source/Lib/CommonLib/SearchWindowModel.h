@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010 - 2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** \file     SearchWindowModel.h
+    \brief    reference search window buffer model (header)
+*/
+
+#ifndef _SEARCHWINDOWMODEL_H_
+#define _SEARCHWINDOWMODEL_H_
+#include "Picture.h"
+
+#include <map>
+
+// settings of the search window model
+struct SearchWindowCfg
+{
+  bool enable;        ///< track the luma reference reads against an on-chip search window per CTU
+  int  marginHor;     ///< window extension left and right of the CTU in luma samples, 0: search range + filter taps
+  int  marginVer;     ///< window extension above and below the CTU in luma samples, 0: search range + filter taps
+  bool ctuReuse;      ///< keep the overlap with the window of the previous CTU instead of reloading it
+  bool clampSearch;   ///< restrict the motion search to the window
+
+  SearchWindowCfg() : enable( false ), marginHor( 0 ), marginVer( 0 ), ctuReuse( true ), clampSearch( false ) {}
+};
+
+// counters in luma samples
+struct SearchWindowStats
+{
+  int64_t access;     // samples read by motion estimation and compensation
+  int64_t outside;    // samples read outside the window, each read is fetched from external memory
+  int64_t loaded;     // samples loaded into the window
+
+  SearchWindowStats() : access( 0 ), outside( 0 ), loaded( 0 ) {}
+  void add( const SearchWindowStats &other )
+  {
+    access  += other.access;
+    outside += other.outside;
+    loaded  += other.loaded;
+  }
+  int64_t getExternal() const { return outside + loaded; }
+};
+
+class SearchWindowModel
+{
+private:
+  SearchWindowCfg m_cfg;
+  int             m_bytesPerSample;
+  // current access
+  Position        m_ctuPos;
+  Size            m_ctuSize;
+  const Picture*  m_refPic;
+  const Pel*      m_base;          // top-left of the padded reference buffer
+  int             m_stride;
+  int             m_margin;
+  Area            m_picArea;
+  // window held for each reference picture
+  std::map<int, Area> m_window;
+  // stastical infromation per reference picture in a frame, and for a sequence
+  std::map<int, SearchWindowStats> m_frameStats;
+  SearchWindowStats m_seqStats;
+  int             m_frameCount;
+
+public:
+  SearchWindowModel();
+  void create( const SearchWindowCfg &cfg, int searchRange, int ctuSize, int bitDepth );
+  bool isEnabled() const { return m_cfg.enable; }
+  const SearchWindowCfg& getCfg() const { return m_cfg; }
+  void clear();
+  void reportFrame( int poc );
+  void reportSequence() const;
+  void accumulateFrame();
+  void setCurrentCtu( const Position &ctuPos ) { m_ctuPos = ctuPos; }
+  void setRefPicture( const Picture *refPic );
+  void blockAccess( const Pel *buf, int width, int height );
+  Area getWindow( const Position &ctuPos ) const;   ///< window of a CTU in luma samples, not limited to the picture
+
+protected:
+  SearchWindowStats xGetFrameStats() const;
+};
+
+#endif // _SEARCHWINDOWMODEL_H_
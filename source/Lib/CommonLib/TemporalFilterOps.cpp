@@ -0,0 +1,200 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of TemporalFilterOps class
+ */
+
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "TemporalFilterOps.h"
+
+#include <cmath>
+
+//! \ingroup CommonLib
+//! \{
+
+TemporalFilterOps::TemporalFilterOps()
+{
+  m_motionErrorInt      = xMotionErrorInt;
+  m_motionErrorFrac     = xMotionErrorFrac;
+  m_applyMotion         = xApplyMotion;
+  m_bilateralFilterRow  = xBilateralFilterRow;
+
+#if ENABLE_SIMD_OPT_TEMPORAL_FILTER
+#ifdef TARGET_SIMD_X86
+  initTemporalFilterOpsX86();
+#endif
+#endif
+}
+
+int TemporalFilterOps::xMotionErrorInt( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int besterror )
+{
+  int error = 0;
+  for( int y1 = 0; y1 < bs; y1++ )
+  {
+    const Pel* origRowStart   = org + y1 * orgStride;
+    const Pel* bufferRowStart = buf + y1 * bufStride;
+    for( int x1 = 0; x1 < bs; x1 += 2 )
+    {
+      int diff = origRowStart[x1] - bufferRowStart[x1];
+      error += diff * diff;
+      diff = origRowStart[x1 + 1] - bufferRowStart[x1 + 1];
+      error += diff * diff;
+    }
+    if( error > besterror )
+    {
+      return error;
+    }
+  }
+  return error;
+}
+
+int TemporalFilterOps::xMotionErrorFrac( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int* xFilter, const int* yFilter, const int maxValue, const int besterror )
+{
+  int tempArray[64 + 8][64];
+
+  int sum;
+  for( int y1 = 1; y1 < bs + 7; y1++ )
+  {
+    const Pel* sourceRow = buf + y1 * bufStride;
+    for( int x1 = 0; x1 < bs; x1++ )
+    {
+      const Pel* rowStart = sourceRow + x1;
+
+      sum  = xFilter[1] * rowStart[1];
+      sum += xFilter[2] * rowStart[2];
+      sum += xFilter[3] * rowStart[3];
+      sum += xFilter[4] * rowStart[4];
+      sum += xFilter[5] * rowStart[5];
+      sum += xFilter[6] * rowStart[6];
+
+      tempArray[y1][x1] = sum;
+    }
+  }
+
+  int error = 0;
+  for( int y1 = 0; y1 < bs; y1++ )
+  {
+    const Pel* origRow = org + y1 * orgStride;
+    for( int x1 = 0; x1 < bs; x1++ )
+    {
+      sum  = yFilter[1] * tempArray[y1 + 1][x1];
+      sum += yFilter[2] * tempArray[y1 + 2][x1];
+      sum += yFilter[3] * tempArray[y1 + 3][x1];
+      sum += yFilter[4] * tempArray[y1 + 4][x1];
+      sum += yFilter[5] * tempArray[y1 + 5][x1];
+      sum += yFilter[6] * tempArray[y1 + 6][x1];
+
+      sum = ( sum + ( 1 << 11 ) ) >> 12;
+      sum = sum < 0 ? 0 : ( sum > maxValue ? maxValue : sum );
+
+      error += ( sum - origRow[x1] ) * ( sum - origRow[x1] );
+    }
+    if( error > besterror )
+    {
+      return error;
+    }
+  }
+  return error;
+}
+
+void TemporalFilterOps::xApplyMotion( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* xFilter, const int* yFilter, const int maxValue )
+{
+  int tempArray[8 + 7][8];
+
+  for( int by = 1; by < height + 7; by++ )
+  {
+    const Pel* sourceRow = src + by * srcStride;
+    for( int bx = 0; bx < width; bx++ )
+    {
+      const Pel* rowStart = sourceRow + bx;
+
+      int sum = 0;
+      sum += xFilter[1] * rowStart[1];
+      sum += xFilter[2] * rowStart[2];
+      sum += xFilter[3] * rowStart[3];
+      sum += xFilter[4] * rowStart[4];
+      sum += xFilter[5] * rowStart[5];
+      sum += xFilter[6] * rowStart[6];
+
+      tempArray[by][bx] = sum;
+    }
+  }
+
+  for( int by = 0; by < height; by++, dst += dstStride )
+  {
+    for( int bx = 0; bx < width; bx++ )
+    {
+      int sum = 0;
+      sum += yFilter[1] * tempArray[by + 1][bx];
+      sum += yFilter[2] * tempArray[by + 2][bx];
+      sum += yFilter[3] * tempArray[by + 3][bx];
+      sum += yFilter[4] * tempArray[by + 4][bx];
+      sum += yFilter[5] * tempArray[by + 5][bx];
+      sum += yFilter[6] * tempArray[by + 6][bx];
+
+      sum = ( sum + ( 1 << 11 ) ) >> 12;
+      sum = sum < 0 ? 0 : ( sum > maxValue ? maxValue : sum );
+      dst[bx] = sum;
+    }
+  }
+}
+
+/** expLut is indexed by the difference between the motion-compensated reference and the original sample
+ */
+void TemporalFilterOps::xBilateralFilterRow( const Pel* org, Pel* dst, const int width, const Pel* const* corrected, const int numRefs, const double* refWeights, const double* expLut, const int maxValue )
+{
+  for( int x = 0; x < width; x++ )
+  {
+    const int orgVal = (int) org[x];
+    double temporalWeightSum = 1.0;
+    double newVal = (double) orgVal;
+    for( int i = 0; i < numRefs; i++ )
+    {
+      const int refVal = (int) corrected[i][x];
+      const double weight = refWeights[i] * expLut[refVal - orgVal];
+      newVal += weight * refVal;
+      temporalWeightSum += weight;
+    }
+    newVal /= temporalWeightSum;
+    Pel sampleVal = (Pel)round(newVal);
+    sampleVal = ( sampleVal < 0 ? 0 : ( sampleVal > maxValue ? maxValue : sampleVal ) );
+    dst[x] = sampleVal;
+  }
+}
+
+//! \}
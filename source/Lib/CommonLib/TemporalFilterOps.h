@@ -0,0 +1,79 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Declaration of TemporalFilterOps class
+ */
+
+#ifndef __TEMPORALFILTEROPS__
+#define __TEMPORALFILTEROPS__
+
+#include "CommonDef.h"
+
+//! \ingroup CommonLib
+//! \{
+
+/// sample kernels of the GOP based temporal filter, the interpolating kernels get the source pointer 3 samples above and left of the integer position
+class TemporalFilterOps
+{
+public:
+  int ( *m_motionErrorInt ) ( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int besterror );
+
+  int ( *m_motionErrorFrac ) ( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int* xFilter, const int* yFilter, const int maxValue, const int besterror );
+
+  void( *m_applyMotion ) ( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* xFilter, const int* yFilter, const int maxValue );
+
+  void( *m_bilateralFilterRow ) ( const Pel* org, Pel* dst, const int width, const Pel* const* corrected, const int numRefs, const double* refWeights, const double* expLut, const int maxValue );
+
+  static int  xMotionErrorInt( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int besterror );
+
+  static int  xMotionErrorFrac( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int* xFilter, const int* yFilter, const int maxValue, const int besterror );
+
+  static void xApplyMotion( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* xFilter, const int* yFilter, const int maxValue );
+
+  static void xBilateralFilterRow( const Pel* org, Pel* dst, const int width, const Pel* const* corrected, const int numRefs, const double* refWeights, const double* expLut, const int maxValue );
+
+  TemporalFilterOps();
+  ~TemporalFilterOps() {}
+
+#ifdef TARGET_SIMD_X86
+  void initTemporalFilterOpsX86();
+  template <X86_VEXT vext>
+  void _initTemporalFilterOpsX86();
+#endif
+};
+
+//! \}
+
+#endif
@@ -43,6 +43,7 @@
 #include "CodingStructure.h"
 
 #include "dtrace_buffer.h"
+#include "OpCounter.h"
 
 #include <stdlib.h>
 #include <limits>
@@ -208,7 +209,7 @@ TrQuant::~TrQuant()
   }
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void TrQuant::copyState( const TrQuant& other )
 {
   m_quant->copyState( *other.m_quant );
@@ -802,6 +803,17 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
   }
 #endif
 
+#if ENABLE_OP_COUNTERS
+  {
+    // matrix multiplication equivalent of both stages, zeroed-out outputs are not computed
+    const uint64_t nzWidth  = width  - skipWidth;
+    const uint64_t nzHeight = height - skipHeight;
+    const uint64_t macs     = ( width  > 1 ? height  * nzWidth * width  : 0 ) + ( height > 1 ? nzWidth * nzHeight * height : 0 );
+    const uint64_t shifts   = ( width  > 1 ? height  * nzWidth          : 0 ) + ( height > 1 ? nzWidth * nzHeight          : 0 );
+    OP_COUNT( OP_TOOL_TRANSFORM_FWD, 0, width * height, macs, macs, shifts );
+  }
+#endif
+
   ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff block[MAX_TB_SIZEY * MAX_TB_SIZEY] );
 
   const Pel *resiBuf    = resi.buf;
@@ -874,6 +886,17 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
     }
   }
 
+#if ENABLE_OP_COUNTERS
+  {
+    // matrix multiplication equivalent of both stages, zeroed-out inputs are skipped
+    const uint64_t nzWidth  = width  - skipWidth;
+    const uint64_t nzHeight = height - skipHeight;
+    const uint64_t macs     = ( height > 1 ? nzWidth * height * nzHeight : 0 ) + ( width  > 1 ? height * width * nzWidth : 0 );
+    const uint64_t shifts   = ( height > 1 ? nzWidth * height            : 0 ) + ( width  > 1 ? height * width           : 0 );
+    OP_COUNT( OP_TOOL_TRANSFORM_INV, 0, width * height, macs, macs, shifts );
+  }
+#endif
+
   TCoeff *block = ( TCoeff * ) alloca( width * height * sizeof( TCoeff ) );
 
   if( width > 1 && height > 1 ) //2-D transform
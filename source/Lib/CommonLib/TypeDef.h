@@ -234,8 +234,8 @@ typedef std::pair<int, int>  TrCost;
 #define REUSE_CU_RESULTS_WITH_MULTIPLE_TUS                1
 #endif
 
-#ifndef JVET_J0090_MEMORY_BANDWITH_MEASURE
-#define JVET_J0090_MEMORY_BANDWITH_MEASURE                0
+#ifndef ENABLE_OP_COUNTERS
+#define ENABLE_OP_COUNTERS                                0   ///< count nominal arithmetic operations of interpolation, distortion and transforms (see OpCounter.h)
 #endif
 
 #ifndef EXTENSION_360_VIDEO
@@ -262,6 +262,10 @@ typedef std::pair<int, int>  TrCost;
 
 #endif
 
+#ifndef ENABLE_WPP_PARALLELISM
+#define ENABLE_WPP_PARALLELISM                            0
+#endif
+
 // clang-format on
 
 // ====================================================================================================================
@@ -348,6 +352,9 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_TEMPORAL_FILTER                 ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the GOP based temporal filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_DEBLOCK                         ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for SAO offsets and statistics, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
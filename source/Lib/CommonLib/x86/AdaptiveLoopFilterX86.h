@@ -681,12 +681,75 @@ static void simdFilter7x7Blk(AlfClassifier **classifier, const PelUnitBuf &recDs
   }
 }
 
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+static void simdUpdateCovariance( double* E, double* y, const Pel* eLocal, const int eLocalStride, const int numCoeff, const int numBins, const double yLocal, const double weight )
+{
+  constexpr int maxBins = AdaptiveLoopFilter::MaxAlfNumClippingValues;
+
+  // transpose to [bin][coeff], so that a row of E is updated from consecutive coefficients
+  double eT[maxBins][MAX_NUM_ALF_LUMA_COEFF];
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int b = 0; b < numBins; b++ )
+    {
+      eT[b][k] = eLocal[k * eLocalStride + b];
+    }
+  }
+
+  // every element is updated once with the same operations as the scalar code, so the sums stay bit-exact
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int b0 = 0; b0 < numBins; b0++ )
+    {
+      const double a = eT[b0][k];
+#ifdef USE_AVX2
+      const __m256d vw4 = _mm256_set1_pd( weight );
+      const __m256d va4 = _mm256_set1_pd( a );
+#endif
+      const __m128d vw2 = _mm_set1_pd( weight );
+      const __m128d va2 = _mm_set1_pd( a );
+
+      for( int b1 = 0; b1 < numBins; b1++ )
+      {
+        double*       e  = E + ( ( b0 * maxBins + b1 ) * MAX_NUM_ALF_LUMA_COEFF + k ) * MAX_NUM_ALF_LUMA_COEFF;
+        const double* eb = eT[b1];
+        int l = k;
+#ifdef USE_AVX2
+        for( ; l + 4 <= numCoeff; l += 4 )
+        {
+          const __m256d prod = _mm256_mul_pd( vw4, _mm256_mul_pd( va4, _mm256_loadu_pd( eb + l ) ) );
+          _mm256_storeu_pd( e + l, _mm256_add_pd( _mm256_loadu_pd( e + l ), prod ) );
+        }
+#endif
+        for( ; l + 2 <= numCoeff; l += 2 )
+        {
+          const __m128d prod = _mm_mul_pd( vw2, _mm_mul_pd( va2, _mm_loadu_pd( eb + l ) ) );
+          _mm_storeu_pd( e + l, _mm_add_pd( _mm_loadu_pd( e + l ), prod ) );
+        }
+        for( ; l < numCoeff; l++ )
+        {
+          e[l] += weight * ( a * eb[l] );
+        }
+      }
+    }
+    for( int b = 0; b < numBins; b++ )
+    {
+      y[b * MAX_NUM_ALF_LUMA_COEFF + k] += weight * ( eT[b][k] * yLocal );
+    }
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
 {
   m_deriveClassificationBlk = simdDeriveClassificationBlk<vext>;
   m_filter5x5Blk = simdFilter5x5Blk<vext>;
   m_filter7x7Blk = simdFilter7x7Blk<vext>;
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  m_updateCovariance = simdUpdateCovariance<vext>;
+#endif
 }
 
 template void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86<SIMDX86>();
@@ -222,7 +222,19 @@ static void simdInterpolateHorM4( const int16_t* src, int srcStride, int16_t *ds
   __m128i vzero, vshufc0, vshufc1;
   __m128i vsum;
 
-  if( N != 8 ){
+  __m128i vcoeffp[3];
+
+  if( N == 6 )
+  {
+    // sample pairs ( x, x+1 ) and ( x+2, x+3 ) for four consecutive outputs
+    vshufc0 = _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4, 0x5, 0x4, 0x3, 0x2, 0x3, 0x2, 0x1, 0x0 );
+    vshufc1 = _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0xb, 0xa, 0x9, 0x8, 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4 );
+    for( int i = 0; i < 6; i += 2 )
+    {
+      vcoeffp[i / 2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[i] ), _mm_set1_epi16( coeff[i + 1] ) );
+    }
+  }
+  else if( N != 8 ){
     vcoeffh = _mm_shuffle_epi32( vcoeffh, 0x44 );
     vzero = _mm_setzero_si128();
     vshufc0 = _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x5, 0x4, 0x3, 0x2, 0x7, 0x6, 0x5, 0x4, 0x3, 0x2, 0x1, 0x0 );
@@ -249,6 +261,14 @@ static void simdInterpolateHorM4( const int16_t* src, int srcStride, int16_t *ds
         }
         vsum = _mm_hadd_epi32( vtmp[0], vtmp[1] );
       }
+      else if( N == 6 )
+      {
+        __m128i vsrc0 = _mm_lddqu_si128( ( __m128i const * )&src[col] );
+        __m128i vsrc1 = _mm_lddqu_si128( ( __m128i const * )&src[col + 4] );
+        vsum = _mm_madd_epi16( _mm_shuffle_epi8( vsrc0, vshufc0 ), vcoeffp[0] );
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_shuffle_epi8( vsrc0, vshufc1 ), vcoeffp[1] ) );
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_shuffle_epi8( vsrc1, vshufc0 ), vcoeffp[2] ) );
+      }
       else
       {
         __m128i vtmp0, vtmp1;
@@ -295,8 +315,19 @@ static void simdInterpolateHorM8( const int16_t* src, int srcStride, int16_t *ds
 
   __m128i vshufc0, vshufc1;
   __m128i vsum, vsuma, vsumb;
+  __m128i vcoeffp[3];
 
-  if( N != 8 ){
+  if( N == 6 )
+  {
+    // sample pairs ( x, x+1 ) and ( x+2, x+3 ) for four consecutive outputs
+    vshufc0 = _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4, 0x5, 0x4, 0x3, 0x2, 0x3, 0x2, 0x1, 0x0 );
+    vshufc1 = _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0xb, 0xa, 0x9, 0x8, 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4 );
+    for( int i = 0; i < 6; i += 2 )
+    {
+      vcoeffp[i / 2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[i] ), _mm_set1_epi16( coeff[i + 1] ) );
+    }
+  }
+  else if( N != 8 ){
     vcoeffh = _mm_shuffle_epi32( vcoeffh, 0x44 );
     vshufc0 = _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x5, 0x4, 0x3, 0x2, 0x7, 0x6, 0x5, 0x4, 0x3, 0x2, 0x1, 0x0 );
     vshufc1 = _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0x9, 0x8, 0x7, 0x6, 0xb, 0xa, 0x9, 0x8, 0x7, 0x6, 0x5, 0x4 );
@@ -322,6 +353,19 @@ static void simdInterpolateHorM8( const int16_t* src, int srcStride, int16_t *ds
         vsuma = _mm_hadd_epi32( vtmp[0], vtmp[1] );
         vsumb = _mm_hadd_epi32( vtmp[2], vtmp[3] );
       }
+      else if( N == 6 )
+      {
+        __m128i vsrc0 = _mm_lddqu_si128( ( __m128i const * )&src[col] );
+        __m128i vsrc1 = _mm_lddqu_si128( ( __m128i const * )&src[col + 4] );
+        __m128i vsrc2 = _mm_lddqu_si128( ( __m128i const * )&src[col + 8] );
+
+        vsuma = _mm_madd_epi16( _mm_shuffle_epi8( vsrc0, vshufc0 ), vcoeffp[0] );
+        vsumb = _mm_madd_epi16( _mm_shuffle_epi8( vsrc1, vshufc0 ), vcoeffp[0] );
+        vsuma = _mm_add_epi32( vsuma, _mm_madd_epi16( _mm_shuffle_epi8( vsrc0, vshufc1 ), vcoeffp[1] ) );
+        vsumb = _mm_add_epi32( vsumb, _mm_madd_epi16( _mm_shuffle_epi8( vsrc1, vshufc1 ), vcoeffp[1] ) );
+        vsuma = _mm_add_epi32( vsuma, _mm_madd_epi16( _mm_shuffle_epi8( vsrc1, vshufc0 ), vcoeffp[2] ) );
+        vsumb = _mm_add_epi32( vsumb, _mm_madd_epi16( _mm_shuffle_epi8( vsrc2, vshufc0 ), vcoeffp[2] ) );
+      }
       else
       {
         __m128i vtmp00, vtmp01, vtmp10, vtmp11;
@@ -417,6 +461,19 @@ static void simdInterpolateHorM8_AVX2( const int16_t* src, int srcStride, int16_
           vsum  = _mm256_add_epi32( vsum, _mm256_add_epi32( _mm256_madd_epi16( vsrca0, vcoeff[2*i] ), _mm256_madd_epi16( vsrca1, vcoeff[2*i+1] ) ) );
         }
       }
+      else if( N==6 )
+      {
+        __m128i vsrc[3];
+        for( int i=0; i<3; i++ )
+        {
+          vsrc[i] = _mm_loadu_si128( ( const __m128i * )&src[col+i*4] );
+        }
+        __m256i vsrc0 = _mm256_inserti128_si256( _mm256_castsi128_si256( vsrc[0] ), vsrc[1], 1 );
+        __m256i vsrc1 = _mm256_inserti128_si256( _mm256_castsi128_si256( vsrc[1] ), vsrc[2], 1 );
+        vsum = _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc0, vshuf0 ), vcoeff[0] );
+        vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc0, vshuf1 ), vcoeff[1] ) );
+        vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc1, vshuf0 ), vcoeff[2] ) );
+      }
       else
       {
         __m256i vtmp02, vtmp13;
@@ -514,6 +571,15 @@ static void simdInterpolateHorM16_AVX2( const int16_t* src, int srcStride, int16
           vsumb  = _mm256_add_epi32( vsumb, _mm256_add_epi32( _mm256_madd_epi16( vsrcb0, vcoeff[2*i] ), _mm256_madd_epi16( vsrcb1, vcoeff[2*i+1] ) ) );
         }
       }
+      else if( N==6 )
+      {
+        vsuma = _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[0], vshuf0 ), vcoeff[0] );
+        vsumb = _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[1], vshuf0 ), vcoeff[0] );
+        vsuma = _mm256_add_epi32( vsuma, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[0], vshuf1 ), vcoeff[1] ) );
+        vsumb = _mm256_add_epi32( vsumb, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[1], vshuf1 ), vcoeff[1] ) );
+        vsuma = _mm256_add_epi32( vsuma, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[1], vshuf0 ), vcoeff[2] ) );
+        vsumb = _mm256_add_epi32( vsumb, _mm256_madd_epi16( _mm256_shuffle_epi8( vsrc[2], vshuf0 ), vcoeff[2] ) );
+      }
       else
       {
         __m256i vtmp00, vtmp01, vtmp10, vtmp11;
@@ -1257,6 +1323,34 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
         simdInterpolateVerM4<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
       return;
     }
+    else if( N == 6 && !( width & 0x03 ) )
+    {
+      if( !isVertical )
+      {
+        if( ( width % 8 ) == 0 )
+        {
+          if( vext>= AVX2 )
+            simdInterpolateHorM8_AVX2<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+          else
+            simdInterpolateHorM8<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        }
+        else
+          simdInterpolateHorM4<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      }
+      else
+      {
+        if( ( width % 8 ) == 0 )
+        {
+          if( vext>= AVX2 )
+            simdInterpolateVerM8_AVX2<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+          else
+            simdInterpolateVerM8<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        }
+        else
+          simdInterpolateVerM4<vext, 6, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      }
+      return;
+    }
     else if( N == 4 && !( width & 0x03 ) )
     {
       if( !isVertical )
@@ -1272,7 +1366,17 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
           simdInterpolateHorM4<vext, 4, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
       }
       else
-        simdInterpolateVerM4<vext, 4, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      {
+        if( ( width % 8 ) == 0 )
+        {
+          if( vext>= AVX2 )
+            simdInterpolateVerM8_AVX2<vext, 4, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+          else
+            simdInterpolateVerM8<vext, 4, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        }
+        else
+          simdInterpolateVerM4<vext, 4, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      }
       return;
     }
     else if (biMCForDMVR)
@@ -1566,7 +1670,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
 template <X86_VEXT vext>
 void InterpolationFilter::_initInterpolationFilterX86()
 {
-  // [taps][bFirst][bLast]
+  // [taps: 8, 4, 2, 6][bFirst][bLast]
   m_filterHor[0][0][0] = simdFilter<vext, 8, false, false, false>;
   m_filterHor[0][0][1] = simdFilter<vext, 8, false, false, true>;
   m_filterHor[0][1][0] = simdFilter<vext, 8, false, true, false>;
@@ -1582,6 +1686,11 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterHor[2][1][0] = simdFilter<vext, 2, false, true, false>;
   m_filterHor[2][1][1] = simdFilter<vext, 2, false, true, true>;
 
+  m_filterHor[3][0][0] = simdFilter<vext, 6, false, false, false>;
+  m_filterHor[3][0][1] = simdFilter<vext, 6, false, false, true>;
+  m_filterHor[3][1][0] = simdFilter<vext, 6, false, true, false>;
+  m_filterHor[3][1][1] = simdFilter<vext, 6, false, true, true>;
+
   m_filterVer[0][0][0] = simdFilter<vext, 8, true, false, false>;
   m_filterVer[0][0][1] = simdFilter<vext, 8, true, false, true>;
   m_filterVer[0][1][0] = simdFilter<vext, 8, true, true, false>;
@@ -1597,6 +1706,11 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterVer[2][1][0] = simdFilter<vext, 2, true, true, false>;
   m_filterVer[2][1][1] = simdFilter<vext, 2, true, true, true>;
 
+  m_filterVer[3][0][0] = simdFilter<vext, 6, true, false, false>;
+  m_filterVer[3][0][1] = simdFilter<vext, 6, true, false, true>;
+  m_filterVer[3][1][0] = simdFilter<vext, 6, true, true, false>;
+  m_filterVer[3][1][1] = simdFilter<vext, 6, true, true, true>;
+
   m_filterCopy[0][0]   = simdFilterCopy<vext, false, false>;
   m_filterCopy[0][1]   = simdFilterCopy<vext, false, true>;
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
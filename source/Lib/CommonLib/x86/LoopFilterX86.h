@@ -0,0 +1,351 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the LoopFilter edge filters
+ */
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+/** loads the samples p3..q3 (m[0]..m[7]) across the edge of 2 or 4 lines, one line per 32 bit lane,
+ *  horizontal edges only load the rows first..last
+ */
+static inline void simdLoadLines( const Pel* src, const int step, const int offset, const int numLines, const int first, const int last, __m128i* m )
+{
+  if( offset == 1 )
+  {
+    const __m128i l0 = _mm_loadu_si128( ( const __m128i* ) ( src - 4 ) );
+    const __m128i l1 = _mm_loadu_si128( ( const __m128i* ) ( src + step - 4 ) );
+    const __m128i l2 = numLines > 2 ? _mm_loadu_si128( ( const __m128i* ) ( src + 2 * step - 4 ) ) : l0;
+    const __m128i l3 = numLines > 2 ? _mm_loadu_si128( ( const __m128i* ) ( src + 3 * step - 4 ) ) : l1;
+
+    const __m128i t0 = _mm_unpacklo_epi16( l0, l1 );
+    const __m128i t1 = _mm_unpackhi_epi16( l0, l1 );
+    const __m128i t2 = _mm_unpacklo_epi16( l2, l3 );
+    const __m128i t3 = _mm_unpackhi_epi16( l2, l3 );
+    const __m128i u0 = _mm_unpacklo_epi32( t0, t2 );
+    const __m128i u1 = _mm_unpackhi_epi32( t0, t2 );
+    const __m128i u2 = _mm_unpacklo_epi32( t1, t3 );
+    const __m128i u3 = _mm_unpackhi_epi32( t1, t3 );
+
+    m[0] = _mm_cvtepi16_epi32( u0 );
+    m[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+    m[2] = _mm_cvtepi16_epi32( u1 );
+    m[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+    m[4] = _mm_cvtepi16_epi32( u2 );
+    m[5] = _mm_cvtepi16_epi32( _mm_srli_si128( u2, 8 ) );
+    m[6] = _mm_cvtepi16_epi32( u3 );
+    m[7] = _mm_cvtepi16_epi32( _mm_srli_si128( u3, 8 ) );
+  }
+  else
+  {
+    for( int k = first; k <= last; k++ )
+    {
+      const Pel* row = src + ( k - 4 ) * offset;
+      m[k] = _mm_cvtepi16_epi32( numLines > 2 ? _mm_loadl_epi64( ( const __m128i* ) row ) : _mm_cvtsi32_si128( *( const int32_t* ) row ) );
+    }
+  }
+}
+
+/** writes back the samples of simdLoadLines, vertical edges store the whole lines p3..q3,
+ *  horizontal edges only the rows first..last
+ */
+static inline void simdStoreLines( Pel* src, const int step, const int offset, const int numLines, const int first, const int last, const __m128i* m )
+{
+  if( offset == 1 )
+  {
+    const __m128i u0 = _mm_packs_epi32( m[0], m[1] );
+    const __m128i u1 = _mm_packs_epi32( m[2], m[3] );
+    const __m128i u2 = _mm_packs_epi32( m[4], m[5] );
+    const __m128i u3 = _mm_packs_epi32( m[6], m[7] );
+
+    const __m128i w0 = _mm_unpacklo_epi16( u0, u1 );
+    const __m128i w1 = _mm_unpackhi_epi16( u0, u1 );
+    const __m128i w2 = _mm_unpacklo_epi16( u2, u3 );
+    const __m128i w3 = _mm_unpackhi_epi16( u2, u3 );
+    const __m128i x0 = _mm_unpacklo_epi16( w0, w1 );
+    const __m128i x1 = _mm_unpackhi_epi16( w0, w1 );
+    const __m128i y0 = _mm_unpacklo_epi16( w2, w3 );
+    const __m128i y1 = _mm_unpackhi_epi16( w2, w3 );
+
+    _mm_storeu_si128( ( __m128i* ) ( src - 4 ),        _mm_unpacklo_epi64( x0, y0 ) );
+    _mm_storeu_si128( ( __m128i* ) ( src + step - 4 ), _mm_unpackhi_epi64( x0, y0 ) );
+    if( numLines > 2 )
+    {
+      _mm_storeu_si128( ( __m128i* ) ( src + 2 * step - 4 ), _mm_unpacklo_epi64( x1, y1 ) );
+      _mm_storeu_si128( ( __m128i* ) ( src + 3 * step - 4 ), _mm_unpackhi_epi64( x1, y1 ) );
+    }
+  }
+  else
+  {
+    for( int k = first; k <= last; k++ )
+    {
+      Pel* row = src + ( k - 4 ) * offset;
+      const __m128i v = _mm_packs_epi32( m[k], m[k] );
+      if( numLines > 2 )
+      {
+        _mm_storel_epi64( ( __m128i* ) row, v );
+      }
+      else
+      {
+        *( int32_t* ) row = _mm_cvtsi128_si32( v );
+      }
+    }
+  }
+}
+
+static inline __m128i simdClip3( const __m128i minVal, const __m128i maxVal, const __m128i a )
+{
+  return _mm_min_epi32( _mm_max_epi32( minVal, a ), maxVal );
+}
+
+/** Clip3( m - tc, m + tc, ( sum + 4 ) >> 3 ), the strong filter output of a sample
+ */
+static inline __m128i simdStrongTap( const __m128i m, const __m128i tc, const __m128i sum, const __m128i round, const int shift )
+{
+  return simdClip3( _mm_sub_epi32( m, tc ), _mm_add_epi32( m, tc ), _mm_srai_epi32( _mm_add_epi32( sum, round ), shift ) );
+}
+
+template<X86_VEXT vext>
+static void simdFilterLumaShort( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  if( numLines != 2 && numLines != 4 )
+  {
+    LoopFilter::xFilterLumaShort( src, step, offset, numLines, tc, sw, thrCut, filterSecondP, filterSecondQ, clpRng );
+    return;
+  }
+
+  __m128i m[8];
+  __m128i r[8];
+
+  if( sw )
+  {
+    simdLoadLines( src, step, offset, numLines, 0, 7, m );
+
+    const __m128i vtc  = _mm_set1_epi32( tc );
+    const __m128i vtc2 = _mm_add_epi32( vtc, vtc );
+    const __m128i vtc3 = _mm_add_epi32( vtc2, vtc );
+    const __m128i two  = _mm_set1_epi32( 2 );
+    const __m128i four = _mm_set1_epi32( 4 );
+
+    const __m128i m34  = _mm_add_epi32( m[3], m[4] );
+
+    // p0, q0: ( m1 + 2 * m2 + 2 * m3 + 2 * m4 + m5 + 4 ) >> 3 and the mirrored taps
+    __m128i sum = _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( m[2], m34 ), 1 ), _mm_add_epi32( m[1], m[5] ) );
+    r[3] = simdStrongTap( m[3], vtc3, sum, four, 3 );
+    sum  = _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( m[5], m34 ), 1 ), _mm_add_epi32( m[2], m[6] ) );
+    r[4] = simdStrongTap( m[4], vtc3, sum, four, 3 );
+
+    // p1, q1: ( m1 + m2 + m3 + m4 + 2 ) >> 2
+    r[2] = simdStrongTap( m[2], vtc2, _mm_add_epi32( m[1], _mm_add_epi32( m[2], m34 ) ), two, 2 );
+    r[5] = simdStrongTap( m[5], vtc2, _mm_add_epi32( m[6], _mm_add_epi32( m[5], m34 ) ), two, 2 );
+
+    // p2, q2: ( 2 * m0 + 3 * m1 + m2 + m3 + m4 + 4 ) >> 3
+    sum  = _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( m[0], 1 ), _mm_add_epi32( _mm_slli_epi32( m[1], 1 ), m[1] ) ), _mm_add_epi32( m[2], m34 ) );
+    r[1] = simdStrongTap( m[1], vtc, sum, four, 3 );
+    sum  = _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( m[7], 1 ), _mm_add_epi32( _mm_slli_epi32( m[6], 1 ), m[6] ) ), _mm_add_epi32( m[5], m34 ) );
+    r[6] = simdStrongTap( m[6], vtc, sum, four, 3 );
+
+    r[0] = m[0];
+    r[7] = m[7];
+    simdStoreLines( src, step, offset, numLines, 1, 6, r );
+  }
+  else
+  {
+    simdLoadLines( src, step, offset, numLines, filterSecondP ? 1 : 2, filterSecondQ ? 6 : 5, m );
+
+    const __m128i vtc    = _mm_set1_epi32( tc );
+    const __m128i vtcNeg = _mm_set1_epi32( -tc );
+    const __m128i minVal = _mm_set1_epi32( clpRng.min );
+    const __m128i maxVal = _mm_set1_epi32( clpRng.max );
+    const __m128i one    = _mm_set1_epi32( 1 );
+
+    // delta = ( 9 * ( m4 - m3 ) - 3 * ( m5 - m2 ) + 8 ) >> 4
+    const __m128i d43 = _mm_sub_epi32( m[4], m[3] );
+    const __m128i d52 = _mm_sub_epi32( m[5], m[2] );
+    __m128i delta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( d43, 3 ), d43 ), _mm_add_epi32( _mm_add_epi32( d52, d52 ), d52 ) );
+    delta = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 8 ) ), 4 );
+
+    const __m128i mask = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( thrCut ) );
+    delta = simdClip3( vtcNeg, vtc, delta );
+
+    r[3] = _mm_blendv_epi8( m[3], simdClip3( minVal, maxVal, _mm_add_epi32( m[3], delta ) ), mask );
+    r[4] = _mm_blendv_epi8( m[4], simdClip3( minVal, maxVal, _mm_sub_epi32( m[4], delta ) ), mask );
+    r[2] = m[2];
+    r[5] = m[5];
+
+    const __m128i vtc2    = _mm_set1_epi32( tc >> 1 );
+    const __m128i vtc2Neg = _mm_set1_epi32( -( tc >> 1 ) );
+    if( filterSecondP )
+    {
+      // Clip3( -tc2, tc2, ( ( ( m1 + m3 + 1 ) >> 1 ) - m2 + delta ) >> 1 )
+      __m128i delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[1], m[3] ), one ), 1 );
+      delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( delta1, m[2] ), delta ), 1 );
+      delta1 = simdClip3( vtc2Neg, vtc2, delta1 );
+      r[2] = _mm_blendv_epi8( m[2], simdClip3( minVal, maxVal, _mm_add_epi32( m[2], delta1 ) ), mask );
+    }
+    if( filterSecondQ )
+    {
+      // Clip3( -tc2, tc2, ( ( ( m6 + m4 + 1 ) >> 1 ) - m5 - delta ) >> 1 )
+      __m128i delta2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[6], m[4] ), one ), 1 );
+      delta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( delta2, m[5] ), delta ), 1 );
+      delta2 = simdClip3( vtc2Neg, vtc2, delta2 );
+      r[5] = _mm_blendv_epi8( m[5], simdClip3( minVal, maxVal, _mm_add_epi32( m[5], delta2 ) ), mask );
+    }
+
+    if( offset == 1 )
+    {
+      r[0] = m[0];
+      r[1] = m[1];
+      r[6] = m[6];
+      r[7] = m[7];
+    }
+    simdStoreLines( src, step, offset, numLines, filterSecondP ? 2 : 3, filterSecondQ ? 5 : 4, r );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterChroma( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const bool isChromaHorCTBBoundary, const ClpRng& clpRng )
+{
+  if( numLines != 2 && numLines != 4 )
+  {
+    LoopFilter::xFilterChroma( src, step, offset, numLines, tc, sw, isChromaHorCTBBoundary, clpRng );
+    return;
+  }
+
+  __m128i m[8];
+  __m128i r[8];
+  const __m128i vtc  = _mm_set1_epi32( tc );
+  const __m128i four = _mm_set1_epi32( 4 );
+
+  if( sw )
+  {
+    const int first = isChromaHorCTBBoundary ? 2 : 0;
+    simdLoadLines( src, step, offset, numLines, first, 7, m );
+
+    const __m128i m34  = _mm_add_epi32( m[3], m[4] );
+    const __m128i m345 = _mm_add_epi32( m34, m[5] );
+    const __m128i m7x2 = _mm_slli_epi32( m[7], 1 );
+
+    // q1: ( m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7 + 4 ) >> 3, q2: ( m3 + m4 + m5 + 2 * m6 + 3 * m7 + 4 ) >> 3
+    __m128i sum = _mm_add_epi32( _mm_add_epi32( m[2], m345 ), _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), m7x2 ) );
+    r[5] = simdStrongTap( m[5], vtc, sum, four, 3 );
+    sum  = _mm_add_epi32( _mm_add_epi32( m345, _mm_slli_epi32( m[6], 1 ) ), _mm_add_epi32( m7x2, m[7] ) );
+    r[6] = simdStrongTap( m[6], vtc, sum, four, 3 );
+
+    if( isChromaHorCTBBoundary )
+    {
+      // p0: ( 3 * m2 + 2 * m3 + m4 + m5 + m6 + 4 ) >> 3, q0: ( 2 * m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4 ) >> 3
+      const __m128i m2x2 = _mm_slli_epi32( m[2], 1 );
+      sum  = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( m2x2, m[2] ), _mm_slli_epi32( m[3], 1 ) ), _mm_add_epi32( _mm_add_epi32( m[4], m[5] ), m[6] ) );
+      r[3] = simdStrongTap( m[3], vtc, sum, four, 3 );
+      sum  = _mm_add_epi32( _mm_add_epi32( m2x2, m345 ), _mm_add_epi32( _mm_add_epi32( m[4], m[6] ), m[7] ) );
+      r[4] = simdStrongTap( m[4], vtc, sum, four, 3 );
+
+      r[0] = m[0];
+      r[1] = m[1];
+      r[2] = m[2];
+    }
+    else
+    {
+      // p2: ( 3 * m0 + 2 * m1 + m2 + m3 + m4 + 4 ) >> 3, p1: ( 2 * m0 + m1 + 2 * m2 + m3 + m4 + m5 + 4 ) >> 3
+      const __m128i m0x2 = _mm_slli_epi32( m[0], 1 );
+      sum  = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( m0x2, m[0] ), _mm_slli_epi32( m[1], 1 ) ), _mm_add_epi32( m[2], m34 ) );
+      r[1] = simdStrongTap( m[1], vtc, sum, four, 3 );
+      sum  = _mm_add_epi32( _mm_add_epi32( m0x2, m[1] ), _mm_add_epi32( _mm_slli_epi32( m[2], 1 ), m345 ) );
+      r[2] = simdStrongTap( m[2], vtc, sum, four, 3 );
+      // p0: ( m0 + m1 + m2 + 2 * m3 + m4 + m5 + m6 + 4 ) >> 3, q0: ( m1 + m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4 ) >> 3
+      const __m128i m12 = _mm_add_epi32( m[1], m[2] );
+      sum  = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( m[0], m12 ), _mm_add_epi32( m345, m[3] ) ), m[6] );
+      r[3] = simdStrongTap( m[3], vtc, sum, four, 3 );
+      sum  = _mm_add_epi32( _mm_add_epi32( m12, _mm_add_epi32( m345, m[4] ) ), _mm_add_epi32( m[6], m[7] ) );
+      r[4] = simdStrongTap( m[4], vtc, sum, four, 3 );
+
+      r[0] = m[0];
+    }
+    r[7] = m[7];
+    simdStoreLines( src, step, offset, numLines, isChromaHorCTBBoundary ? 3 : 1, 6, r );
+  }
+  else
+  {
+    simdLoadLines( src, step, offset, numLines, 2, 5, m );
+
+    // delta = Clip3( -tc, tc, ( ( ( m4 - m3 ) << 2 ) + m2 - m5 + 4 ) >> 3 )
+    __m128i delta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( m[4], m[3] ), 2 ), _mm_sub_epi32( m[2], m[5] ) );
+    delta = simdClip3( _mm_set1_epi32( -tc ), vtc, _mm_srai_epi32( _mm_add_epi32( delta, four ), 3 ) );
+
+    const __m128i minVal = _mm_set1_epi32( clpRng.min );
+    const __m128i maxVal = _mm_set1_epi32( clpRng.max );
+    r[3] = simdClip3( minVal, maxVal, _mm_add_epi32( m[3], delta ) );
+    r[4] = simdClip3( minVal, maxVal, _mm_sub_epi32( m[4], delta ) );
+
+    if( offset == 1 )
+    {
+      r[0] = m[0];
+      r[1] = m[1];
+      r[2] = m[2];
+      r[5] = m[5];
+      r[6] = m[6];
+      r[7] = m[7];
+    }
+    simdStoreLines( src, step, offset, numLines, 3, 4, r );
+  }
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaShort = simdFilterLumaShort<vext>;
+  m_filterChroma    = simdFilterChroma<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
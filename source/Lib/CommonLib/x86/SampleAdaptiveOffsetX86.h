@@ -0,0 +1,292 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the SAO edge/band offset and edge statistics kernels
+ */
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+/** edge class of 8 samples minus 2, i.e. sgn(c - a) + sgn(c - b)
+ */
+static inline __m128i simdEdgeSign( const __m128i c, const __m128i a, const __m128i b )
+{
+  const __m128i signA = _mm_sub_epi16( _mm_cmpgt_epi16( a, c ), _mm_cmpgt_epi16( c, a ) );
+  const __m128i signB = _mm_sub_epi16( _mm_cmpgt_epi16( b, c ), _mm_cmpgt_epi16( c, b ) );
+  return _mm_add_epi16( signA, signB );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdEdgeSign( const __m256i c, const __m256i a, const __m256i b )
+{
+  const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( a, c ), _mm256_cmpgt_epi16( c, a ) );
+  const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( b, c ), _mm256_cmpgt_epi16( c, b ) );
+  return _mm256_add_epi16( signA, signB );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdOffsetEdgeBlk( const Pel* src, const int srcStride, Pel* res, const int resStride, const int posA, const int posB, const int startX, const int endX, const int height, const int* offset, const ClpRng& clpRng )
+{
+  // the five edge class offsets as 16 bit table, looked up by a byte shuffle with the control 2 * idx | ( 2 * idx + 1 ) << 8,
+  // which is ( e + 2 ) * 0x0202 + 0x0100 for the edge sign sum e
+  const __m128i table   = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i ctrlMul = _mm_set1_epi16( 0x0202 );
+  const __m128i ctrlAdd = _mm_set1_epi16( 0x0504 );
+  const __m128i minVal  = _mm_set1_epi16( clpRng.min );
+  const __m128i maxVal  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i table256   = _mm256_broadcastsi128_si256( table );
+  const __m256i ctrlMul256 = _mm256_broadcastsi128_si256( ctrlMul );
+  const __m256i ctrlAdd256 = _mm256_broadcastsi128_si256( ctrlAdd );
+  const __m256i minVal256  = _mm256_broadcastsi128_si256( minVal );
+  const __m256i maxVal256  = _mm256_broadcastsi128_si256( maxVal );
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i c    = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+      const __m256i a    = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posA ) );
+      const __m256i b    = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posB ) );
+      const __m256i ctrl = _mm256_add_epi16( _mm256_mullo_epi16( simdEdgeSign( c, a, b ), ctrlMul256 ), ctrlAdd256 );
+      const __m256i r    = _mm256_add_epi16( c, _mm256_shuffle_epi8( table256, ctrl ) );
+      _mm256_storeu_si256( ( __m256i* ) ( res + x ), _mm256_min_epi16( _mm256_max_epi16( r, minVal256 ), maxVal256 ) );
+    }
+#endif
+    for( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i c    = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      const __m128i a    = _mm_loadu_si128( ( const __m128i* ) ( src + x + posA ) );
+      const __m128i b    = _mm_loadu_si128( ( const __m128i* ) ( src + x + posB ) );
+      const __m128i ctrl = _mm_add_epi16( _mm_mullo_epi16( simdEdgeSign( c, a, b ), ctrlMul ), ctrlAdd );
+      const __m128i r    = _mm_add_epi16( c, _mm_shuffle_epi8( table, ctrl ) );
+      _mm_storeu_si128( ( __m128i* ) ( res + x ), _mm_min_epi16( _mm_max_epi16( r, minVal ), maxVal ) );
+    }
+    if( x < endX )
+    {
+      SampleAdaptiveOffset::offsetEdgeBlk( src, srcStride, res, resStride, posA, posB, x, endX, 1, offset, clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdOffsetBandBlk( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  // the 32 band offsets in four tables of eight, the lower three bits of the band select the entry, the upper two bits the table
+  __m128i table[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    const int* o = offset + 8 * i;
+    table[i] = _mm_setr_epi16( o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7] );
+  }
+  const __m128i shift   = _mm_cvtsi32_si128( shiftBits );
+  const __m128i seven   = _mm_set1_epi16( 7 );
+  const __m128i one     = _mm_set1_epi16( 1 );
+  const __m128i two     = _mm_set1_epi16( 2 );
+  const __m128i three   = _mm_set1_epi16( 3 );
+  const __m128i ctrlMul = _mm_set1_epi16( 0x0202 );
+  const __m128i ctrlAdd = _mm_set1_epi16( 0x0100 );
+  const __m128i minVal  = _mm_set1_epi16( clpRng.min );
+  const __m128i maxVal  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  __m256i table256[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    table256[i] = _mm256_broadcastsi128_si256( table[i] );
+  }
+  const __m256i seven256   = _mm256_broadcastsi128_si256( seven );
+  const __m256i one256     = _mm256_broadcastsi128_si256( one );
+  const __m256i two256     = _mm256_broadcastsi128_si256( two );
+  const __m256i three256   = _mm256_broadcastsi128_si256( three );
+  const __m256i ctrlMul256 = _mm256_broadcastsi128_si256( ctrlMul );
+  const __m256i ctrlAdd256 = _mm256_broadcastsi128_si256( ctrlAdd );
+  const __m256i minVal256  = _mm256_broadcastsi128_si256( minVal );
+  const __m256i maxVal256  = _mm256_broadcastsi128_si256( maxVal );
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i c    = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+      const __m256i band = _mm256_srl_epi16( c, shift );
+      const __m256i ctrl = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_and_si256( band, seven256 ), ctrlMul256 ), ctrlAdd256 );
+      const __m256i tIdx = _mm256_srli_epi16( band, 3 );
+      __m256i o = _mm256_shuffle_epi8( table256[0], ctrl );
+      o = _mm256_blendv_epi8( o, _mm256_shuffle_epi8( table256[1], ctrl ), _mm256_cmpeq_epi16( tIdx, one256 ) );
+      o = _mm256_blendv_epi8( o, _mm256_shuffle_epi8( table256[2], ctrl ), _mm256_cmpeq_epi16( tIdx, two256 ) );
+      o = _mm256_blendv_epi8( o, _mm256_shuffle_epi8( table256[3], ctrl ), _mm256_cmpeq_epi16( tIdx, three256 ) );
+      const __m256i r = _mm256_add_epi16( c, o );
+      _mm256_storeu_si256( ( __m256i* ) ( res + x ), _mm256_min_epi16( _mm256_max_epi16( r, minVal256 ), maxVal256 ) );
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i c    = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      const __m128i band = _mm_srl_epi16( c, shift );
+      const __m128i ctrl = _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( band, seven ), ctrlMul ), ctrlAdd );
+      const __m128i tIdx = _mm_srli_epi16( band, 3 );
+      __m128i o = _mm_shuffle_epi8( table[0], ctrl );
+      o = _mm_blendv_epi8( o, _mm_shuffle_epi8( table[1], ctrl ), _mm_cmpeq_epi16( tIdx, one ) );
+      o = _mm_blendv_epi8( o, _mm_shuffle_epi8( table[2], ctrl ), _mm_cmpeq_epi16( tIdx, two ) );
+      o = _mm_blendv_epi8( o, _mm_shuffle_epi8( table[3], ctrl ), _mm_cmpeq_epi16( tIdx, three ) );
+      const __m128i r = _mm_add_epi16( c, o );
+      _mm_storeu_si128( ( __m128i* ) ( res + x ), _mm_min_epi16( _mm_max_epi16( r, minVal ), maxVal ) );
+    }
+    for( ; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdGetEdgeStatsBlk( const Pel* src, const int srcStride, const Pel* org, const int orgStride, const int posA, const int posB, const int startX, const int endX, const int height, int64_t* diff, int64_t* count )
+{
+  // per edge class the masked org - src differences are summed in 32 bit lanes and the samples counted in 16 bit lanes,
+  // which cannot overflow for blocks up to the maximum CTU size
+  const int numClasses = 5;
+  const __m128i ones = _mm_set1_epi16( 1 );
+  __m128i diffAcc[numClasses], countAcc[numClasses], edgeClass[numClasses];
+  for( int k = 0; k < numClasses; k++ )
+  {
+    diffAcc  [k] = _mm_setzero_si128();
+    countAcc [k] = _mm_setzero_si128();
+    edgeClass[k] = _mm_set1_epi16( k - 2 );
+  }
+#ifdef USE_AVX2
+  const __m256i ones256 = _mm256_set1_epi16( 1 );
+  __m256i diffAcc256[numClasses], countAcc256[numClasses], edgeClass256[numClasses];
+  for( int k = 0; k < numClasses; k++ )
+  {
+    diffAcc256  [k] = _mm256_setzero_si256();
+    countAcc256 [k] = _mm256_setzero_si256();
+    edgeClass256[k] = _mm256_set1_epi16( k - 2 );
+  }
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i c = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+      const __m256i a = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posA ) );
+      const __m256i b = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posB ) );
+      const __m256i d = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( org + x ) ), c );
+      const __m256i e = simdEdgeSign( c, a, b );
+      for( int k = 0; k < numClasses; k++ )
+      {
+        const __m256i mask = _mm256_cmpeq_epi16( e, edgeClass256[k] );
+        diffAcc256 [k] = _mm256_add_epi32( diffAcc256[k], _mm256_madd_epi16( _mm256_and_si256( d, mask ), ones256 ) );
+        countAcc256[k] = _mm256_sub_epi16( countAcc256[k], mask );
+      }
+    }
+#endif
+    for( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i c = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      const __m128i a = _mm_loadu_si128( ( const __m128i* ) ( src + x + posA ) );
+      const __m128i b = _mm_loadu_si128( ( const __m128i* ) ( src + x + posB ) );
+      const __m128i d = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( org + x ) ), c );
+      const __m128i e = simdEdgeSign( c, a, b );
+      for( int k = 0; k < numClasses; k++ )
+      {
+        const __m128i mask = _mm_cmpeq_epi16( e, edgeClass[k] );
+        diffAcc [k] = _mm_add_epi32( diffAcc[k], _mm_madd_epi16( _mm_and_si128( d, mask ), ones ) );
+        countAcc[k] = _mm_sub_epi16( countAcc[k], mask );
+      }
+    }
+    if( x < endX )
+    {
+      SampleAdaptiveOffset::getEdgeStatsBlk( src, srcStride, org, orgStride, posA, posB, x, endX, 1, diff, count );
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+
+  for( int k = 0; k < numClasses; k++ )
+  {
+    __m128i sumDiff  = diffAcc[k];
+    __m128i sumCount = _mm_madd_epi16( countAcc[k], ones );
+#ifdef USE_AVX2
+    sumDiff  = _mm_add_epi32( sumDiff, _mm_add_epi32( _mm256_castsi256_si128( diffAcc256[k] ), _mm256_extracti128_si256( diffAcc256[k], 1 ) ) );
+    const __m256i count256 = _mm256_madd_epi16( countAcc256[k], ones256 );
+    sumCount = _mm_add_epi32( sumCount, _mm_add_epi32( _mm256_castsi256_si128( count256 ), _mm256_extracti128_si256( count256, 1 ) ) );
+#endif
+    sumDiff  = _mm_hadd_epi32( _mm_hadd_epi32( sumDiff, sumDiff ), sumDiff );
+    sumCount = _mm_hadd_epi32( _mm_hadd_epi32( sumCount, sumCount ), sumCount );
+    diff [k] += _mm_cvtsi128_si32( sumDiff );
+    count[k] += _mm_cvtsi128_si32( sumCount );
+  }
+}
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetEdgeBlk   = simdOffsetEdgeBlk<vext>;
+  m_offsetBandBlk   = simdOffsetBandBlk<vext>;
+  m_getEdgeStatsBlk = simdGetEdgeStatsBlk<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
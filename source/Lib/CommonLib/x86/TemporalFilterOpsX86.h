@@ -0,0 +1,321 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of TemporalFilterOps class
+ */
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "CommonDefX86.h"
+#include "../TemporalFilterOps.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+static inline int simdHorizontalSum( __m128i v )
+{
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0xb1 ) );
+  return _mm_cvtsi128_si32( v );
+}
+
+/** horizontal 6-tap pass of the interpolation, rows 1 to height + 6 of src go to the same rows of dst
+ */
+template<X86_VEXT vext>
+static void simdFilterHor( const Pel* src, const int srcStride, int* dst, const int dstStride, const int width, const int height, const int* xFilter )
+{
+  const __m128i c12 = _mm_set_epi16( xFilter[2], xFilter[1], xFilter[2], xFilter[1], xFilter[2], xFilter[1], xFilter[2], xFilter[1] );
+  const __m128i c34 = _mm_set_epi16( xFilter[4], xFilter[3], xFilter[4], xFilter[3], xFilter[4], xFilter[3], xFilter[4], xFilter[3] );
+  const __m128i c56 = _mm_set_epi16( xFilter[6], xFilter[5], xFilter[6], xFilter[5], xFilter[6], xFilter[5], xFilter[6], xFilter[5] );
+#ifdef USE_AVX2
+  const __m256i c12x2 = _mm256_broadcastsi128_si256( c12 );
+  const __m256i c34x2 = _mm256_broadcastsi128_si256( c34 );
+  const __m256i c56x2 = _mm256_broadcastsi128_si256( c56 );
+#endif
+
+  for( int y1 = 1; y1 < height + 7; y1++ )
+  {
+    const Pel* row    = src + y1 * srcStride;
+    int*       dstRow = dst + y1 * dstStride;
+    int        x1     = 0;
+#ifdef USE_AVX2
+    for( ; x1 + 8 <= width; x1 += 8 )
+    {
+      // pair the taps in the 16-bit halves of each 32-bit lane
+      __m256i r[6];
+      for( int k = 0; k < 6; k++ )
+      {
+        r[k] = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( row + x1 + k + 1 ) ) );
+      }
+      __m256i sum = _mm256_madd_epi16( _mm256_blend_epi16( r[0], _mm256_slli_epi32( r[1], 16 ), 0xAA ), c12x2 );
+      sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_blend_epi16( r[2], _mm256_slli_epi32( r[3], 16 ), 0xAA ), c34x2 ) );
+      sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_blend_epi16( r[4], _mm256_slli_epi32( r[5], 16 ), 0xAA ), c56x2 ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dstRow + x1 ), sum );
+    }
+#endif
+    for( ; x1 < width; x1 += 4 )
+    {
+      __m128i r[6];
+      for( int k = 0; k < 6; k++ )
+      {
+        r[k] = _mm_loadl_epi64( ( const __m128i* ) ( row + x1 + k + 1 ) );
+      }
+      __m128i sum = _mm_madd_epi16( _mm_unpacklo_epi16( r[0], r[1] ), c12 );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_unpacklo_epi16( r[2], r[3] ), c34 ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_unpacklo_epi16( r[4], r[5] ), c56 ) );
+      _mm_storeu_si128( ( __m128i* ) ( dstRow + x1 ), sum );
+    }
+  }
+}
+
+/** vertical 6-tap pass for 4 samples, src points to the intermediate row above the first tap
+ */
+static inline __m128i simdFilterVer4( const int* src, const int srcStride, const __m128i* cy, const __m128i vmax )
+{
+  __m128i sum = _mm_setzero_si128();
+  for( int k = 1; k <= 6; k++ )
+  {
+    sum = _mm_add_epi32( sum, _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) ( src + k * srcStride ) ), cy[k - 1] ) );
+  }
+  sum = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 1 << 11 ) ), 12 );
+  return _mm_min_epi32( _mm_max_epi32( sum, _mm_setzero_si128() ), vmax );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdFilterVer8( const int* src, const int srcStride, const __m256i* cy, const __m256i vmax )
+{
+  __m256i sum = _mm256_setzero_si256();
+  for( int k = 1; k <= 6; k++ )
+  {
+    sum = _mm256_add_epi32( sum, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) ( src + k * srcStride ) ), cy[k - 1] ) );
+  }
+  sum = _mm256_srai_epi32( _mm256_add_epi32( sum, _mm256_set1_epi32( 1 << 11 ) ), 12 );
+  return _mm256_min_epi32( _mm256_max_epi32( sum, _mm256_setzero_si256() ), vmax );
+}
+#endif
+
+template<X86_VEXT vext>
+static int simdMotionErrorInt( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int besterror )
+{
+  if( bs & 7 )
+  {
+    return TemporalFilterOps::xMotionErrorInt( org, orgStride, buf, bufStride, bs, besterror );
+  }
+
+  int error = 0;
+  for( int y1 = 0; y1 < bs; y1++, org += orgStride, buf += bufStride )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int     x1   = 0;
+#ifdef USE_AVX2
+    __m256i vsum256 = _mm256_setzero_si256();
+    for( ; x1 + 16 <= bs; x1 += 16 )
+    {
+      const __m256i diff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( org + x1 ) ), _mm256_loadu_si256( ( const __m256i* ) ( buf + x1 ) ) );
+      vsum256 = _mm256_add_epi32( vsum256, _mm256_madd_epi16( diff, diff ) );
+    }
+    vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) );
+#endif
+    for( ; x1 < bs; x1 += 8 )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( org + x1 ) ), _mm_loadu_si128( ( const __m128i* ) ( buf + x1 ) ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( diff, diff ) );
+    }
+    error += simdHorizontalSum( vsum );
+    if( error > besterror )
+    {
+      return error;
+    }
+  }
+  return error;
+}
+
+template<X86_VEXT vext>
+static int simdMotionErrorFrac( const Pel* org, const int orgStride, const Pel* buf, const int bufStride, const int bs, const int* xFilter, const int* yFilter, const int maxValue, const int besterror )
+{
+  if( ( bs & 3 ) || bs > 64 )
+  {
+    return TemporalFilterOps::xMotionErrorFrac( org, orgStride, buf, bufStride, bs, xFilter, yFilter, maxValue, besterror );
+  }
+
+  int tempArray[( 64 + 8 ) * 64];
+  simdFilterHor<vext>( buf, bufStride, tempArray, bs, bs, bs, xFilter );
+
+  __m128i cy[6];
+  for( int k = 0; k < 6; k++ )
+  {
+    cy[k] = _mm_set1_epi32( yFilter[k + 1] );
+  }
+  const __m128i vmax = _mm_set1_epi32( maxValue );
+#ifdef USE_AVX2
+  __m256i cy256[6];
+  for( int k = 0; k < 6; k++ )
+  {
+    cy256[k] = _mm256_set1_epi32( yFilter[k + 1] );
+  }
+  const __m256i vmax256 = _mm256_set1_epi32( maxValue );
+#endif
+
+  int error = 0;
+  for( int y1 = 0; y1 < bs; y1++, org += orgStride )
+  {
+    const int* tempRow = tempArray + y1 * bs;
+    __m128i    vsum    = _mm_setzero_si128();
+    int        x1      = 0;
+#ifdef USE_AVX2
+    __m256i vsum256 = _mm256_setzero_si256();
+    for( ; x1 + 8 <= bs; x1 += 8 )
+    {
+      const __m256i diff = _mm256_sub_epi32( simdFilterVer8( tempRow + x1, bs, cy256, vmax256 ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( org + x1 ) ) ) );
+      vsum256 = _mm256_add_epi32( vsum256, _mm256_mullo_epi32( diff, diff ) );
+    }
+    vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) );
+#endif
+    for( ; x1 < bs; x1 += 4 )
+    {
+      const __m128i diff = _mm_sub_epi32( simdFilterVer4( tempRow + x1, bs, cy, vmax ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( org + x1 ) ) ) );
+      vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( diff, diff ) );
+    }
+    error += simdHorizontalSum( vsum );
+    if( error > besterror )
+    {
+      return error;
+    }
+  }
+  return error;
+}
+
+template<X86_VEXT vext>
+static void simdApplyMotion( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* xFilter, const int* yFilter, const int maxValue )
+{
+  if( ( width & 3 ) || width > 8 || height > 8 )
+  {
+    TemporalFilterOps::xApplyMotion( src, srcStride, dst, dstStride, width, height, xFilter, yFilter, maxValue );
+    return;
+  }
+
+  int tempArray[( 8 + 7 ) * 8];
+  simdFilterHor<vext>( src, srcStride, tempArray, width, width, height, xFilter );
+
+  __m128i cy[6];
+  for( int k = 0; k < 6; k++ )
+  {
+    cy[k] = _mm_set1_epi32( yFilter[k + 1] );
+  }
+  const __m128i vmax = _mm_set1_epi32( maxValue );
+
+  for( int by = 0; by < height; by++, dst += dstStride )
+  {
+    const int* tempRow = tempArray + by * width;
+    for( int bx = 0; bx < width; bx += 4 )
+    {
+      const __m128i val = simdFilterVer4( tempRow + bx, width, cy, vmax );
+      _mm_storel_epi64( ( __m128i* ) ( dst + bx ), _mm_packs_epi32( val, val ) );
+    }
+  }
+}
+
+#ifdef USE_AVX2
+/** the weights are gathered from the exponential table, all double operations are done in the order of the scalar version
+ */
+template<X86_VEXT vext>
+static void simdBilateralFilterRow( const Pel* org, Pel* dst, const int width, const Pel* const* corrected, const int numRefs, const double* refWeights, const double* expLut, const int maxValue )
+{
+  int x = 0;
+  for( ; x + 4 <= width; x += 4 )
+  {
+    const __m128i orgVal    = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( org + x ) ) );
+    __m256d       newVal    = _mm256_cvtepi32_pd( orgVal );
+    __m256d       weightSum = _mm256_set1_pd( 1.0 );
+    for( int i = 0; i < numRefs; i++ )
+    {
+      const __m128i refVal = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( corrected[i] + x ) ) );
+      const __m256d weight = _mm256_mul_pd( _mm256_set1_pd( refWeights[i] ), _mm256_i32gather_pd( expLut, _mm_sub_epi32( refVal, orgVal ), 8 ) );
+      newVal    = _mm256_add_pd( newVal, _mm256_mul_pd( weight, _mm256_cvtepi32_pd( refVal ) ) );
+      weightSum = _mm256_add_pd( weightSum, weight );
+    }
+    double val[4];
+    _mm256_storeu_pd( val, _mm256_div_pd( newVal, weightSum ) );
+    for( int k = 0; k < 4; k++ )
+    {
+      Pel sampleVal = (Pel)round(val[k]);
+      dst[x + k] = ( sampleVal < 0 ? 0 : ( sampleVal > maxValue ? maxValue : sampleVal ) );
+    }
+  }
+  for( ; x < width; x++ )
+  {
+    const int orgVal = (int) org[x];
+    double temporalWeightSum = 1.0;
+    double newVal = (double) orgVal;
+    for( int i = 0; i < numRefs; i++ )
+    {
+      const int refVal = (int) corrected[i][x];
+      const double weight = refWeights[i] * expLut[refVal - orgVal];
+      newVal += weight * refVal;
+      temporalWeightSum += weight;
+    }
+    newVal /= temporalWeightSum;
+    Pel sampleVal = (Pel)round(newVal);
+    dst[x] = ( sampleVal < 0 ? 0 : ( sampleVal > maxValue ? maxValue : sampleVal ) );
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void TemporalFilterOps::_initTemporalFilterOpsX86()
+{
+  m_motionErrorInt  = simdMotionErrorInt<vext>;
+  m_motionErrorFrac = simdMotionErrorFrac<vext>;
+  m_applyMotion     = simdApplyMotion<vext>;
+#ifdef USE_AVX2
+  m_bilateralFilterRow = simdBilateralFilterRow<vext>;
+#endif
+}
+
+template void TemporalFilterOps::_initTemporalFilterOpsX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -0,0 +1 @@
+#include "../TemporalFilterOpsX86.h"
@@ -87,11 +87,7 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
       pcDecLib->create();
 
       // initialize decoder class
-      pcDecLib->init(
-#if  JVET_J0090_MEMORY_BANDWITH_MEASURE
-        ""
-#endif
-      );
+      pcDecLib->init();
 
       pcDecLib->setDebugCTU( debugCTU );
       pcDecLib->setDebugPOC( debugPOC );
@@ -415,9 +411,7 @@ DecLib::DecLib()
   , m_cLoopFilter()
   , m_cSAO()
   , m_cReshaper()
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
-#endif
   , m_pcPic(NULL)
   , m_prevLayerID(MAX_INT)
   , m_prevPOC(MAX_INT)
@@ -440,6 +434,7 @@ DecLib::DecLib()
 #endif
   , m_decodedPictureHashSEIEnabled(false)
   , m_numberOfChecksumErrorsDetected(0)
+  , m_numLoopFilterThreads(1)
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
   , m_debugPOC( -1 )
@@ -501,18 +496,15 @@ void DecLib::destroy()
   m_cSliceDecoder.destroy();
 }
 
-void DecLib::init(
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  const std::string& cacheCfgFileName
-#endif
-)
+void DecLib::init( const std::string& cacheCfgFileName )
 {
   m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
-  m_cInterPred.cacheAssign( &m_cacheModel );
-#endif
+  if( m_cacheModel.isCacheEnable() )
+  {
+    m_cInterPred.cacheAssign( &m_cacheModel );
+  }
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
@@ -532,10 +524,8 @@ void DecLib::deletePicBuffer ( )
   m_cALF.destroy();
   m_cSAO.destroy();
   m_cLoopFilter.destroy();
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.reportSequence( );
   m_cacheModel.destroy( );
-#endif
   m_cCuDecoder.destoryDecCuReshaprBuf();
   m_cReshaper.destroy();
 }
@@ -772,11 +762,9 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
 
   msg( msgl, "\n");
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-    m_cacheModel.reportFrame();
-    m_cacheModel.accumulateFrame();
-    m_cacheModel.clear();
-#endif
+  m_cacheModel.reportFrame( pcSlice->getPOC() );
+  m_cacheModel.accumulateFrame();
+  m_cacheModel.clear();
 
   m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
 #if JVET_R0270
@@ -1606,8 +1594,8 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
                    sps->getChromaFormatIdc(),
                    sps->getMaxCUWidth(), sps->getMaxCUHeight(),
                    maxDepth,
-                   log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
-    m_cLoopFilter.create(maxDepth);
+                   log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma, m_numLoopFilterThreads );
+    m_cLoopFilter.create(maxDepth, m_numLoopFilterThreads);
     m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
     m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc(), sps->getMaxCUHeight() );
     if (sps->getUseLmcs())
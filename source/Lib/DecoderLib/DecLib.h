@@ -118,9 +118,7 @@ private:
   HRD                     m_HRD;
   // decoder side RD cost computation
   RdCost                  m_cRdCost;                      ///< RD cost computation class
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel              m_cacheModel;
-#endif
   bool isRandomAccessSkipPicture(int& iSkipFrame,  int& iPOCLastDisplay);
   Picture*                m_pcPic;
   uint32_t                m_uiSliceSegmentIdx;
@@ -147,6 +145,7 @@ private:
 
   int                     m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   uint32_t                m_numberOfChecksumErrorsDetected;
+  int                     m_numLoopFilterThreads;
 
   bool                    m_warningMessageSkipPicture;
 
@@ -206,12 +205,9 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setNumLoopFilterThreads(int n)               { m_numLoopFilterThreads = n; }
 
-  void  init(
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-    const std::string& cacheCfgFileName
-#endif
-  );
+  void  init( const std::string& cacheCfgFileName = "" );
   bool  decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay, int iTargetOlsIdx);
   void  deletePicBuffer();
 
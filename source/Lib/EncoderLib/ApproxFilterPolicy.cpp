@@ -0,0 +1,213 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ApproxFilterPolicy.cpp
+    \brief    per-block selection of approximate fractional ME filters
+*/
+
+#include "ApproxFilterPolicy.h"
+
+#include "CommonLib/Unit.h"
+#include "CommonLib/Slice.h"
+#include "CommonLib/CodingStructure.h"
+
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+//! \ingroup EncoderLib
+//! \{
+
+ApproxFilterPolicy::ApproxFilterPolicy()
+  : m_defaultNumTaps( NTAPS_LUMA )
+{
+  memset( m_histogram, 0, sizeof( m_histogram ) );
+}
+
+void ApproxFilterPolicy::init( const ApproxCfg& approxCfg )
+{
+  m_ruleFileName   = approxCfg.fmeFilterPolicyFile;
+  m_defaultNumTaps = approxCfg.fmeFilterNumTaps;
+  m_rules.clear();
+  memset( m_histogram, 0, sizeof( m_histogram ) );
+
+  if( !m_ruleFileName.empty() )
+  {
+    xParseRuleFile( m_ruleFileName );
+  }
+}
+
+/**
+ * The rule file holds one rule per line as a list of Key=Value pairs, '#' starts a comment.
+ * Taps is mandatory, all other keys bound the rule (inclusive) and default to "don't care":
+ *
+ *   Taps=8 MinArea=1024 MaxQP=27
+ *   Taps=4 MinTId=3
+ *
+ * Rules are evaluated in file order and the first matching rule wins. Blocks matching
+ * no rule use the fme_filter_ntaps setting.
+ */
+void ApproxFilterPolicy::xParseRuleFile( const std::string& fileName )
+{
+  std::ifstream file( fileName );
+  if( !file.is_open() )
+  {
+    THROW( "Cannot open approximate filter rule file " << fileName );
+  }
+
+  std::string line;
+  int lineNum = 0;
+  while( std::getline( file, line ) )
+  {
+    lineNum++;
+    const size_t commentPos = line.find( '#' );
+    if( commentPos != std::string::npos )
+    {
+      line.erase( commentPos );
+    }
+
+    ApproxFilterRule rule;
+    rule.numTaps = 0;
+    rule.minArea = 0;
+    rule.maxArea = std::numeric_limits<int>::max();
+    rule.minTId  = 0;
+    rule.maxTId  = std::numeric_limits<int>::max();
+    rule.minQp   = std::numeric_limits<int>::min();
+    rule.maxQp   = std::numeric_limits<int>::max();
+    rule.minCost = 0;
+    rule.maxCost = std::numeric_limits<Distortion>::max();
+
+    std::istringstream tokens( line );
+    std::string token;
+    bool hasToken = false;
+    while( tokens >> token )
+    {
+      hasToken = true;
+      const size_t sep = token.find( '=' );
+      CHECK( sep == std::string::npos || sep + 1 == token.size(), "Malformed entry '" << token << "' in line " << lineNum << " of " << fileName );
+
+      const std::string key = token.substr( 0, sep );
+      std::istringstream valueStream( token.substr( sep + 1 ) );
+      int64_t value;
+      valueStream >> value;
+      CHECK( valueStream.fail() || !valueStream.eof(), "Invalid value in '" << token << "' in line " << lineNum << " of " << fileName );
+
+      if     ( key == "Taps"    ) { rule.numTaps = int( value ); }
+      else if( key == "MinArea" ) { rule.minArea = int( value ); }
+      else if( key == "MaxArea" ) { rule.maxArea = int( value ); }
+      else if( key == "MinTId"  ) { rule.minTId  = int( value ); }
+      else if( key == "MaxTId"  ) { rule.maxTId  = int( value ); }
+      else if( key == "MinQP"   ) { rule.minQp   = int( value ); }
+      else if( key == "MaxQP"   ) { rule.maxQp   = int( value ); }
+      else if( key == "MinCost" ) { rule.minCost = Distortion( value ); }
+      else if( key == "MaxCost" ) { rule.maxCost = Distortion( value ); }
+      else
+      {
+        THROW( "Unknown key '" << key << "' in line " << lineNum << " of " << fileName );
+      }
+    }
+
+    if( hasToken )
+    {
+      CHECK( rule.numTaps < 2 || rule.numTaps > NTAPS_LUMA || ( rule.numTaps & 1 ), "Taps shall be 2, 4, 6 or 8 in line " << lineNum << " of " << fileName );
+      m_rules.push_back( rule );
+    }
+  }
+
+  CHECK( m_rules.empty(), "No rule found in approximate filter rule file " << fileName );
+}
+
+int ApproxFilterPolicy::selectNumTaps( const PredictionUnit& pu, const Distortion intMeCost )
+{
+  const int        area          = pu.lwidth() * pu.lheight();
+  const int        tid           = pu.cs->slice->getTLayer();
+  const int        qp            = pu.cu->qp;
+  const Distortion costPerSample = intMeCost / area;
+
+  int numTaps = m_defaultNumTaps;
+  for( const ApproxFilterRule& rule : m_rules )
+  {
+    if( area >= rule.minArea && area <= rule.maxArea
+     && tid  >= rule.minTId  && tid  <= rule.maxTId
+     && qp   >= rule.minQp   && qp   <= rule.maxQp
+     && costPerSample >= rule.minCost && costPerSample <= rule.maxCost )
+    {
+      numTaps = rule.numTaps;
+      break;
+    }
+  }
+
+  m_histogram[floorLog2( area )][4 - ( numTaps >> 1 )]++;
+
+  return numTaps;
+}
+
+void ApproxFilterPolicy::addHistogram( const ApproxFilterPolicy& other )
+{
+  for( int log2Area = 0; log2Area < NUM_AREA_CLASSES; log2Area++ )
+  {
+    for( int i = 0; i < N_APPROX_FILTERS; i++ )
+    {
+      m_histogram[log2Area][i] += other.m_histogram[log2Area][i];
+    }
+  }
+}
+
+void ApproxFilterPolicy::printHistogram() const
+{
+  if( !isEnabled() )
+  {
+    return;
+  }
+
+  msg( INFO, "\nApproximate FME filter usage (%s)\n", m_ruleFileName.c_str() );
+  msg( INFO, "\t    Area |     8-tap     6-tap     4-tap     2-tap\n" );
+
+  uint64_t total[N_APPROX_FILTERS] = { 0 };
+  for( int log2Area = 0; log2Area < NUM_AREA_CLASSES; log2Area++ )
+  {
+    const uint64_t *count = m_histogram[log2Area];
+    if( count[0] + count[1] + count[2] + count[3] == 0 )
+    {
+      continue;
+    }
+    msg( INFO, "\t%8d | %9llu %9llu %9llu %9llu\n", 1 << log2Area, ( unsigned long long ) count[0], ( unsigned long long ) count[1], ( unsigned long long ) count[2], ( unsigned long long ) count[3] );
+    for( int i = 0; i < N_APPROX_FILTERS; i++ )
+    {
+      total[i] += count[i];
+    }
+  }
+  msg( INFO, "\t   Total | %9llu %9llu %9llu %9llu\n", ( unsigned long long ) total[0], ( unsigned long long ) total[1], ( unsigned long long ) total[2], ( unsigned long long ) total[3] );
+}
+
+//! \}
@@ -0,0 +1,95 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ApproxFilterPolicy.h
+    \brief    per-block selection of approximate fractional ME filters (header)
+*/
+
+#ifndef __APPROXFILTERPOLICY__
+#define __APPROXFILTERPOLICY__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/LabUCPel.h"
+
+#include <string>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+struct PredictionUnit;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// condition/tap-count pair of the approximate filter rule file, all bounds are inclusive
+struct ApproxFilterRule
+{
+  int        numTaps;
+  int        minArea;
+  int        maxArea;
+  int        minTId;
+  int        maxTId;
+  int        minQp;
+  int        maxQp;
+  Distortion minCost;   ///< integer-pel ME cost per luma sample
+  Distortion maxCost;
+};
+
+/// selects the luma filter tap count used by the fractional-pel refinement of each PU
+class ApproxFilterPolicy
+{
+public:
+  ApproxFilterPolicy();
+
+  void init                ( const ApproxCfg& approxCfg );
+  bool isEnabled           () const { return !m_rules.empty(); }
+  int  selectNumTaps       ( const PredictionUnit& pu, const Distortion intMeCost );
+  void addHistogram        ( const ApproxFilterPolicy& other );
+  void printHistogram      () const;
+
+private:
+  void xParseRuleFile      ( const std::string& fileName );
+
+  static const int NUM_AREA_CLASSES = 2 * MAX_CU_DEPTH + 1;
+
+  std::string                   m_ruleFileName;
+  std::vector<ApproxFilterRule> m_rules;
+  int                           m_defaultNumTaps;
+  uint64_t                      m_histogram[NUM_AREA_CLASSES][N_APPROX_FILTERS];  ///< [log2 PU area][tap index]
+};
+
+//! \}
+
+#endif // __APPROXFILTERPOLICY__
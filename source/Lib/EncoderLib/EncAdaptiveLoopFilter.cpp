@@ -39,6 +39,10 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
 
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
 #define AlfCtx(c) SubCtx( Ctx::Alf, c)
 std::vector<double> EncAdaptiveLoopFilter::m_lumaLevelToWeightPLUT;
 
@@ -580,6 +584,12 @@ void EncAdaptiveLoopFilter::create( const EncCfg* encCfg, const int picWidth, co
   m_buf                   = new PelBuf( m_bufOrigin, picWidth >> getComponentScaleX(COMPONENT_Cb,chromaFormatIDC), picWidth >> getComponentScaleX(COMPONENT_Cb,chromaFormatIDC), picHeight >> getComponentScaleY(COMPONENT_Cb,chromaFormatIDC) );
   m_lumaSwingGreaterThanThresholdCount = new uint64_t[m_numCTUsInPic];
   m_chromaSampleCountNearMidPoint = new uint64_t[m_numCTUsInPic];
+
+  m_ctuStatsBuf.resize( encCfg->getNumLoopFilterThreads() );
+  for( auto& buf : m_ctuStatsBuf )
+  {
+    buf.create( chromaFormatIDC, Area( 0, 0, maxCUWidth + ( MAX_ALF_PADDING_SIZE << 1 ), maxCUHeight + ( MAX_ALF_PADDING_SIZE << 1 ) ), maxCUWidth, MAX_ALF_PADDING_SIZE, 0, false );
+  }
 }
 
 void EncAdaptiveLoopFilter::destroy()
@@ -790,6 +800,12 @@ void EncAdaptiveLoopFilter::destroy()
     m_chromaSampleCountNearMidPoint = nullptr;
   }
 
+  for( auto& buf : m_ctuStatsBuf )
+  {
+    buf.destroy();
+  }
+  m_ctuStatsBuf.clear();
+
   AdaptiveLoopFilter::destroy();
 }
 
@@ -2078,7 +2094,6 @@ void EncAdaptiveLoopFilter::getFrameStat( AlfCovariance* frameCov, AlfCovariance
 
 void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnitBuf& recYuv, CodingStructure& cs )
 {
-  int ctuRsAddr = 0;
   const int numberOfComponents = getNumberValidComponents( m_chromaFormat );
 
   // init CTU stats buffers
@@ -2120,135 +2135,142 @@ void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnit
     }
   }
 
+  // every CTU gathers into its own accumulators, the frame statistics are summed up in raster order afterwards
+  const int numThreads = std::min( m_encCfg->getNumLoopFilterThreads(), m_numCTUsInPic );
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+#endif
+  for( int ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++ )
+  {
+#if defined( _OPENMP )
+    PelStorage& tempBuf = m_ctuStatsBuf[omp_get_thread_num()];
+#else
+    PelStorage& tempBuf = m_ctuStatsBuf[0];
+#endif
+    deriveCtuStatsForFiltering( orgYuv, recYuv, cs, tempBuf, ctuRsAddr );
+  }
+
+  for( int ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++ )
+  {
+    for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+    {
+      const ComponentID compID = ComponentID( compIdx );
+      const ChannelType chType = toChannelType( compID );
+      const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
+
+      for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
+      {
+        for( int classIdx = 0; classIdx < numClasses; classIdx++ )
+        {
+          m_alfCovarianceFrame[chType][shape][isLuma( compID ) ? classIdx : 0] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
+        }
+      }
+    }
+  }
+}
+
+void EncAdaptiveLoopFilter::deriveCtuStatsForFiltering( PelUnitBuf& orgYuv, PelUnitBuf& recYuv, CodingStructure& cs, PelStorage& tempBuf, const int ctuRsAddr )
+{
+  const int numberOfComponents = getNumberValidComponents( m_chromaFormat );
   const PreCalcValues& pcv = *cs.pcv;
   bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
   int numHorVirBndry = 0, numVerVirBndry = 0;
   int horVirBndryPos[] = { 0, 0, 0 };
   int verVirBndryPos[] = { 0, 0, 0 };
 
-  for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
-  {
-    for( int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth )
-    {
-      const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
-      const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
-      int rasterSliceAlfPad = 0;
-      if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+  const int yPos = ( ctuRsAddr / m_numCTUsInWidth ) * m_maxCUHeight;
+  const int xPos = ( ctuRsAddr % m_numCTUsInWidth ) * m_maxCUWidth;
+  const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
+  const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
+  int rasterSliceAlfPad = 0;
+  if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+  {
+    int yStart = yPos;
+    for( int i = 0; i <= numHorVirBndry; i++ )
+    {
+      const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+      const int h = yEnd - yStart;
+      const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+      const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+      int xStart = xPos;
+      for( int j = 0; j <= numVerVirBndry; j++ )
       {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
+        const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+        const int w = xEnd - xStart;
+        const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+        const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+        const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+        const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+        PelUnitBuf recBuf = tempBuf.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+        recBuf.copyFrom( recYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
+        // pad top-left unavailable samples for raster slice
+        if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
         {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
-          {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf recBuf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            recBuf.copyFrom( recYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-            {
-              recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
-            }
-
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-            {
-              recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
-            }
-            recBuf.extendBorderPel( MAX_ALF_PADDING_SIZE );
-            recBuf = recBuf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
-
-            const UnitArea area( m_chromaFormat, Area( 0, 0, w, h ) );
-            const UnitArea areaDst( m_chromaFormat, Area( xStart, yStart, w, h ) );
-            for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
-            {
-              const ComponentID compID = ComponentID( compIdx );
-              const CompArea& compArea = area.block( compID );
-
-              int  recStride = recBuf.get( compID ).stride;
-              Pel* rec = recBuf.get( compID ).bufAt( compArea );
-
-              int  orgStride = orgYuv.get(compID).stride;
-              Pel* org = orgYuv.get(compID).bufAt(xStart >> ::getComponentScaleX(compID, m_chromaFormat), yStart >> ::getComponentScaleY(compID, m_chromaFormat));
-              ChannelType chType = toChannelType( compID );
-
-              for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
-              {
-                const CompArea &compAreaDst = areaDst.block(compID);
-                getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
-                            compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compAreaDst, compArea,
-                            chType, ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
-                            (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
-              }
-            }
-
-            xStart = xEnd;
-          }
+          recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+        }
 
-          yStart = yEnd;
+        // pad bottom-right unavailable samples for raster slice
+        if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+        {
+          recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
         }
+        recBuf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+        recBuf = recBuf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
 
+        const UnitArea area( m_chromaFormat, Area( 0, 0, w, h ) );
+        const UnitArea areaDst( m_chromaFormat, Area( xStart, yStart, w, h ) );
         for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
         {
           const ComponentID compID = ComponentID( compIdx );
+          const CompArea& compArea = area.block( compID );
+
+          int  recStride = recBuf.get( compID ).stride;
+          Pel* rec = recBuf.get( compID ).bufAt( compArea );
 
+          int  orgStride = orgYuv.get(compID).stride;
+          Pel* org = orgYuv.get(compID).bufAt(xStart >> ::getComponentScaleX(compID, m_chromaFormat), yStart >> ::getComponentScaleY(compID, m_chromaFormat));
           ChannelType chType = toChannelType( compID );
 
           for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
           {
-            const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
-
-            for( int classIdx = 0; classIdx < numClasses; classIdx++ )
-            {
-              m_alfCovarianceFrame[chType][shape][isLuma( compID ) ? classIdx : 0] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
-            }
+            const CompArea &compAreaDst = areaDst.block(compID);
+            getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
+                        compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compAreaDst, compArea,
+                        chType, ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
+                        (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
           }
         }
-      }
-      else
-      {
-        const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
 
-        for (int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-        {
-          const ComponentID compID   = ComponentID(compIdx);
-          const CompArea &  compArea = area.block(compID);
+        xStart = xEnd;
+      }
 
-          int  recStride = recYuv.get(compID).stride;
-          Pel *rec       = recYuv.get(compID).bufAt(compArea);
+      yStart = yEnd;
+    }
+  }
+  else
+  {
+    const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
 
-          int  orgStride = orgYuv.get(compID).stride;
-          Pel *org       = orgYuv.get(compID).bufAt(compArea);
+    for (int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+    {
+      const ComponentID compID   = ComponentID(compIdx);
+      const CompArea &  compArea = area.block(compID);
 
-          ChannelType chType = toChannelType(compID);
+      int  recStride = recYuv.get(compID).stride;
+      Pel *rec       = recYuv.get(compID).bufAt(compArea);
 
-          for (int shape = 0; shape != m_filterShapes[chType].size(); shape++)
-          {
-            getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
-                        compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compArea, compArea, chType,
-                        ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
-                        (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
+      int  orgStride = orgYuv.get(compID).stride;
+      Pel *org       = orgYuv.get(compID).bufAt(compArea);
 
-            const int numClasses = isLuma(compID) ? MAX_NUM_ALF_CLASSES : 1;
+      ChannelType chType = toChannelType(compID);
 
-            for (int classIdx = 0; classIdx < numClasses; classIdx++)
-            {
-              m_alfCovarianceFrame[chType][shape][isLuma(compID) ? classIdx : 0] +=
-                m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
-            }
-          }
-        }
+      for (int shape = 0; shape != m_filterShapes[chType].size(); shape++)
+      {
+        getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
+                    compIdx ? nullptr : m_classifier, org, orgStride, rec, recStride, compArea, compArea, chType,
+                    ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
+                    (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
       }
-      ctuRsAddr++;
     }
   }
 }
@@ -2293,6 +2315,9 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
       int yLocal = org[j] - rec[j];
 #endif
       calcCovariance(ELocal, rec + j, recStride, shape, transposeIdx, channel, vbDistance);
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+      m_updateCovariance( alfCovariance[classIdx].E[0][0][0], alfCovariance[classIdx].y[0], ELocal[0], MaxAlfNumClippingValues, shape.numCoeff, numBins, (double)yLocal, weight );
+#else
       for( int k = 0; k < shape.numCoeff; k++ )
       {
         for( int l = k; l < shape.numCoeff; l++ )
@@ -2303,19 +2328,11 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
             {
               if (m_alfWSSD)
               {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-                alfCovariance[classIdx].E[b0][b1][k][l] += weight * (ELocal[k][b0] * (double)ELocal[l][b1]);
-#else
                 alfCovariance[classIdx].E[b0][b1][k][l] += weight * (double)(ELocal[k][b0] * ELocal[l][b1]);
-#endif
               }
               else
               {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-                alfCovariance[classIdx].E[b0][b1][k][l] += ELocal[k][b0] * (double)ELocal[l][b1];
-#else
                 alfCovariance[classIdx].E[b0][b1][k][l] += ELocal[k][b0] * ELocal[l][b1];
-#endif
               }
             }
           }
@@ -2324,22 +2341,15 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariance, const AlfF
         {
           if (m_alfWSSD)
           {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-            alfCovariance[classIdx].y[b][k] += weight * (ELocal[k][b] * (double)yLocal);
-#else
             alfCovariance[classIdx].y[b][k] += weight * (double)(ELocal[k][b] * yLocal);
-#endif
           }
           else
           {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-            alfCovariance[classIdx].y[b][k] += ELocal[k][b] * (double)yLocal;
-#else
             alfCovariance[classIdx].y[b][k] += ELocal[k][b] * yLocal;
-#endif
           }
         }
       }
+#endif
       if (m_alfWSSD)
       {
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
@@ -3986,93 +3996,118 @@ void EncAdaptiveLoopFilter::deriveStatsForCcAlfFiltering(const PelUnitBuf &orgYu
     m_alfCovarianceFrameCcAlf[compIdx - 1][shape][filterIdx].reset();
   }
 
-  int                  ctuRsAddr = 0;
-  const PreCalcValues &pcv       = *cs.pcv;
+  // CTUs not crossed by virtual boundaries gather into their own accumulators in parallel; the raster order pass
+  // sums up the frame statistics and handles the remaining CTUs, which add their partial statistics per sub-block
+  const int numThreads = std::min( m_encCfg->getNumLoopFilterThreads(), m_numCTUsInPic );
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+#endif
+  for (int ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++)
+  {
+    deriveCtuStatsForCcAlfFiltering(orgYuv, recYuv, compIdx, filterIdx, cs, ctuRsAddr, false);
+  }
+
+  for (int ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++)
+  {
+    deriveCtuStatsForCcAlfFiltering(orgYuv, recYuv, compIdx, filterIdx, cs, ctuRsAddr, true);
+  }
+}
+
+void EncAdaptiveLoopFilter::deriveCtuStatsForCcAlfFiltering(const PelUnitBuf &orgYuv, const PelUnitBuf &recYuv,
+                                                            const int compIdx, const int filterIdx, CodingStructure &cs,
+                                                            const int ctuRsAddr, const bool framePass)
+{
+  const PreCalcValues &pcv = *cs.pcv;
   bool                 clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
   int                  numHorVirBndry = 0, numVerVirBndry = 0;
   int                  horVirBndryPos[] = { 0, 0, 0 };
   int                  verVirBndryPos[] = { 0, 0, 0 };
 
-  for (int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight)
+  const int yPos              = (ctuRsAddr / m_numCTUsInWidth) * m_maxCUHeight;
+  const int xPos              = (ctuRsAddr % m_numCTUsInWidth) * m_maxCUWidth;
+  const int width             = (xPos + m_maxCUWidth > m_picWidth) ? (m_picWidth - xPos) : m_maxCUWidth;
+  const int height            = (yPos + m_maxCUHeight > m_picHeight) ? (m_picHeight - yPos) : m_maxCUHeight;
+  int       rasterSliceAlfPad = 0;
+  if (isCrossedByVirtualBoundaries(cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight,
+                                   numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos,
+                                   rasterSliceAlfPad))
   {
-    for (int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth)
+    if (!framePass)
+    {
+      return;
+    }
+    int yStart = yPos;
+    for (int i = 0; i <= numHorVirBndry; i++)
     {
-      const int width             = (xPos + m_maxCUWidth > m_picWidth) ? (m_picWidth - xPos) : m_maxCUWidth;
-      const int height            = (yPos + m_maxCUHeight > m_picHeight) ? (m_picHeight - yPos) : m_maxCUHeight;
-      int       rasterSliceAlfPad = 0;
-      if (isCrossedByVirtualBoundaries(cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight,
-                                       numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos,
-                                       rasterSliceAlfPad))
+      const int  yEnd   = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+      const int  h      = yEnd - yStart;
+      const bool clipT  = (i == 0 && clipTop) || (i > 0) || (yStart == 0);
+      const bool clipB  = (i == numHorVirBndry && clipBottom) || (i < numHorVirBndry) || (yEnd == pcv.lumaHeight);
+      int        xStart = xPos;
+      for (int j = 0; j <= numVerVirBndry; j++)
       {
-        int yStart = yPos;
-        for (int i = 0; i <= numHorVirBndry; i++)
+        const int  xEnd   = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+        const int  w      = xEnd - xStart;
+        const bool clipL  = (j == 0 && clipLeft) || (j > 0) || (xStart == 0);
+        const bool clipR  = (j == numVerVirBndry && clipRight) || (j < numVerVirBndry) || (xEnd == pcv.lumaWidth);
+        const int  wBuf   = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+        const int  hBuf   = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+        PelUnitBuf recBuf = m_tempBuf2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
+        recBuf.copyFrom(recYuv.subBuf(
+          UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE),
+                                              yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
+        // pad top-left unavailable samples for raster slice
+        if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
         {
-          const int  yEnd   = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int  h      = yEnd - yStart;
-          const bool clipT  = (i == 0 && clipTop) || (i > 0) || (yStart == 0);
-          const bool clipB  = (i == numHorVirBndry && clipBottom) || (i < numHorVirBndry) || (yEnd == pcv.lumaHeight);
-          int        xStart = xPos;
-          for (int j = 0; j <= numVerVirBndry; j++)
-          {
-            const int  xEnd   = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int  w      = xEnd - xStart;
-            const bool clipL  = (j == 0 && clipLeft) || (j > 0) || (xStart == 0);
-            const bool clipR  = (j == numVerVirBndry && clipRight) || (j < numVerVirBndry) || (xEnd == pcv.lumaWidth);
-            const int  wBuf   = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int  hBuf   = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf recBuf = m_tempBuf2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
-            recBuf.copyFrom(recYuv.subBuf(
-              UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE),
-                                                  yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
-            // pad top-left unavailable samples for raster slice
-            if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
-            {
-              recBuf.padBorderPel(MAX_ALF_PADDING_SIZE, 1);
-            }
-
-            // pad bottom-right unavailable samples for raster slice
-            if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
-            {
-              recBuf.padBorderPel(MAX_ALF_PADDING_SIZE, 2);
-            }
-            recBuf.extendBorderPel(MAX_ALF_PADDING_SIZE);
-            recBuf = recBuf.subBuf(UnitArea(
-              cs.area.chromaFormat, Area(clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h)));
-
-            const UnitArea area(m_chromaFormat, Area(0, 0, w, h));
-            const UnitArea areaDst(m_chromaFormat, Area(xStart, yStart, w, h));
-
-            const ComponentID compID = ComponentID(compIdx);
-
-            for (int shape = 0; shape != m_filterShapesCcAlf[compIdx - 1].size(); shape++)
-            {
-              getBlkStatsCcAlf(m_alfCovarianceCcAlf[compIdx - 1][0][filterIdx][ctuRsAddr],
-                               m_filterShapesCcAlf[compIdx - 1][shape], orgYuv, recBuf, areaDst, area, compID, yPos);
-              m_alfCovarianceFrameCcAlf[compIdx - 1][shape][filterIdx] +=
-                m_alfCovarianceCcAlf[compIdx - 1][shape][filterIdx][ctuRsAddr];
-            }
-
-            xStart = xEnd;
-          }
+          recBuf.padBorderPel(MAX_ALF_PADDING_SIZE, 1);
+        }
 
-          yStart = yEnd;
+        // pad bottom-right unavailable samples for raster slice
+        if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
+        {
+          recBuf.padBorderPel(MAX_ALF_PADDING_SIZE, 2);
         }
-      }
-      else
-      {
-        const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
+        recBuf.extendBorderPel(MAX_ALF_PADDING_SIZE);
+        recBuf = recBuf.subBuf(UnitArea(
+          cs.area.chromaFormat, Area(clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h)));
+
+        const UnitArea area(m_chromaFormat, Area(0, 0, w, h));
+        const UnitArea areaDst(m_chromaFormat, Area(xStart, yStart, w, h));
 
         const ComponentID compID = ComponentID(compIdx);
 
         for (int shape = 0; shape != m_filterShapesCcAlf[compIdx - 1].size(); shape++)
         {
           getBlkStatsCcAlf(m_alfCovarianceCcAlf[compIdx - 1][0][filterIdx][ctuRsAddr],
-                           m_filterShapesCcAlf[compIdx - 1][shape], orgYuv, recYuv, area, area, compID, yPos);
+                           m_filterShapesCcAlf[compIdx - 1][shape], orgYuv, recBuf, areaDst, area, compID, yPos);
           m_alfCovarianceFrameCcAlf[compIdx - 1][shape][filterIdx] +=
             m_alfCovarianceCcAlf[compIdx - 1][shape][filterIdx][ctuRsAddr];
         }
+
+        xStart = xEnd;
       }
-      ctuRsAddr++;
+
+      yStart = yEnd;
+    }
+  }
+  else if (framePass)
+  {
+    for (int shape = 0; shape != m_filterShapesCcAlf[compIdx - 1].size(); shape++)
+    {
+      m_alfCovarianceFrameCcAlf[compIdx - 1][shape][filterIdx] +=
+        m_alfCovarianceCcAlf[compIdx - 1][shape][filterIdx][ctuRsAddr];
+    }
+  }
+  else
+  {
+    const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
+
+    const ComponentID compID = ComponentID(compIdx);
+
+    for (int shape = 0; shape != m_filterShapesCcAlf[compIdx - 1].size(); shape++)
+    {
+      getBlkStatsCcAlf(m_alfCovarianceCcAlf[compIdx - 1][0][filterIdx][ctuRsAddr],
+                       m_filterShapesCcAlf[compIdx - 1][shape], orgYuv, recYuv, area, area, compID, yPos);
     }
   }
 }
@@ -4131,6 +4166,9 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
 
       calcCovarianceCcAlf( ELocal, rec[COMPONENT_Y] + ( j << getComponentScaleX(compID, m_chromaFormat)), recStride[COMPONENT_Y], shape, vbDistance );
 
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+      m_updateCovariance( alfCovariance.E[0][0][0], alfCovariance.y[0], ELocal[0], 1, shape.numCoeff - 1, numBins, (double)yLocal, weight );
+#else
       for( int k = 0; k < (shape.numCoeff - 1); k++ )
       {
         for( int l = k; l < (shape.numCoeff - 1); l++ )
@@ -4141,19 +4179,11 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
             {
               if (m_alfWSSD)
               {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-                alfCovariance.E[b0][b1][k][l] += weight * (ELocal[k][b0] * (double)ELocal[l][b1]);
-#else
                 alfCovariance.E[b0][b1][k][l] += weight * (double) (ELocal[k][b0] * ELocal[l][b1]);
-#endif
               }
               else
               {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-                alfCovariance.E[b0][b1][k][l] += ELocal[k][b0] * (double)ELocal[l][b1];
-#else
                 alfCovariance.E[b0][b1][k][l] += ELocal[k][b0] * ELocal[l][b1];
-#endif
               }
             }
           }
@@ -4162,22 +4192,15 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
         {
           if (m_alfWSSD)
           {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-            alfCovariance.y[b][k] += weight * (ELocal[k][b] * (double)yLocal);
-#else
             alfCovariance.y[b][k] += weight * (double) (ELocal[k][b] * yLocal);
-#endif
           }
           else
           {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-            alfCovariance.y[b][k] += ELocal[k][b] * (double)yLocal;
-#else
             alfCovariance.y[b][k] += ELocal[k][b] * yLocal;
-#endif
           }
         }
       }
+#endif
       if (m_alfWSSD)
       {
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
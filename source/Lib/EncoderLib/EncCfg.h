@@ -46,6 +46,8 @@
 #include "CommonLib/Slice.h"
 
 #include "CommonLib/Unit.h"
+#include "CommonLib/LabUCPel.h"
+#include "CommonLib/SearchWindowModel.h"
 
 #include "EncCfgParam.h"
 
@@ -457,6 +459,8 @@ protected:
   bool      m_bFastMEAssumingSmootherMVEnabled;
   int       m_minSearchWindow;
   bool      m_bRestrictMESampling;
+  ApproxCfg m_approxCfg;                        ///< settings of the approximate kernels
+  SearchWindowCfg m_searchWindowCfg;            ///< settings of the search window model
 
   //====== Quality control ========
   int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
@@ -747,6 +751,7 @@ protected:
   bool      m_bHarmonizeGopFirstFieldCoupleEnabled;
 
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
+  std::string m_cacheCfgFile;                                 ///< cache model configuration file, empty to disable the model
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
   int       m_ImvMode;
@@ -766,6 +771,13 @@ protected:
   int         m_numSplitThreads;
   bool        m_forceSingleSplitThread;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  int         m_numWppThreads;
+  int         m_numWppExtraLines;
+  bool        m_ensureWppBitEqual;
+  int         m_numFrameThreads;
+#endif
+  int         m_numLoopFilterThreads;
 
   bool        m_alf;                                          ///< Adaptive Loop Filter
   bool        m_ccalf;
@@ -1291,6 +1303,8 @@ public:
   void      setFastMEAssumingSmootherMVEnabled ( bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   void      setMinSearchWindow              ( int   i )      { m_minSearchWindow = i; }
   void      setRestrictMESampling           ( bool  b )      { m_bRestrictMESampling = b; }
+  void      setApproxCfg                    ( const ApproxCfg& cfg ) { m_approxCfg = cfg; }
+  void      setSearchWindowCfg              ( const SearchWindowCfg& cfg ) { m_searchWindowCfg = cfg; }
 
   //====== Quality control ========
   void      setMaxDeltaQP                   ( int   i )      { m_iMaxDeltaQP = i; }
@@ -1405,6 +1419,8 @@ public:
   bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   int       getMinSearchWindow                 () const { return m_minSearchWindow; }
   bool      getRestrictMESampling              () const { return m_bRestrictMESampling; }
+  const ApproxCfg& getApproxCfg                () const { return m_approxCfg; }
+  const SearchWindowCfg& getSearchWindowCfg    () const { return m_searchWindowCfg; }
 
   //==== Quality control ========
   int       getMaxDeltaQP                   () const { return m_iMaxDeltaQP; }
@@ -1955,6 +1971,8 @@ public:
 #endif
   void         setSummaryOutFilename(const std::string &s)           { m_summaryOutFilename = s; }
   const std::string& getSummaryOutFilename() const                   { return m_summaryOutFilename; }
+  void         setCacheCfgFile(const std::string &s)                 { m_cacheCfgFile = s; }
+  const std::string& getCacheCfgFile() const                         { return m_cacheCfgFile; }
   void         setSummaryPicFilenameBase(const std::string &s)       { m_summaryPicFilenameBase = s; }
   const std::string& getSummaryPicFilenameBase() const               { return m_summaryPicFilenameBase; }
 
@@ -1988,6 +2006,18 @@ public:
   void         setForceSingleSplitThread( bool b )                   { m_forceSingleSplitThread = b; }
   int          getForceSingleSplitThread()                     const { return m_forceSingleSplitThread; }
 #endif
+#if ENABLE_WPP_PARALLELISM
+  void         setNumWppThreads( int n )                             { m_numWppThreads = n; }
+  int          getNumWppThreads()                              const { return m_numWppThreads; }
+  void         setNumWppExtraLines( int n )                          { m_numWppExtraLines = n; }
+  int          getNumWppExtraLines()                           const { return m_numWppExtraLines; }
+  void         setEnsureWppBitEqual( bool b )                        { m_ensureWppBitEqual = b; }
+  bool         getEnsureWppBitEqual()                          const { return m_ensureWppBitEqual; }
+  void         setNumFrameThreads( int n )                           { m_numFrameThreads = n; }
+  int          getNumFrameThreads()                            const { return m_numFrameThreads; }
+#endif
+  void         setNumLoopFilterThreads( int n )                      { m_numLoopFilterThreads = n; }
+  int          getNumLoopFilterThreads()                       const { return m_numLoopFilterThreads; }
   void         setUseALF( bool b ) { m_alf = b; }
   bool         getUseALF()                                      const { return m_alf; }
   void         setUseCCALF( bool b )                                  { m_ccalf = b; }
@@ -231,11 +231,21 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
   m_CtxCache           = pcEncLib->getCtxCache( PARL_PARAM0( tId ) );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
+#if ENABLE_WPP_PARALLELISM
+  if( tId >= pcEncLib->getNumCuEncStacks() )
+  {
+    // the QP adaptation resets the lambdas through the slice encoder owning the stack
+    m_pcSliceEncoder   = pcEncLib->getFrameSliceEncoder( tId - pcEncLib->getNumCuEncStacks() );
+  }
+#endif
 #if ENABLE_SPLIT_PARALLELISM
   m_pcEncLib           = pcEncLib;
   m_dataId             = tId;
 #endif
   m_pcLoopFilter       = pcEncLib->getLoopFilter();
+#if ENABLE_WPP_PARALLELISM
+  m_wppCsMutex         = nullptr;
+#endif
   m_GeoCostList.init(GEO_NUM_PARTITION_MODE, m_pcEncCfg->getMaxNumGeoCand());
   m_AFFBestSATDCost = MAX_DOUBLE;
 
@@ -253,9 +263,36 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
 // Public member functions
 // ====================================================================================================================
 
+#if ENABLE_WPP_PARALLELISM
+void EncCu::initCtuLine( const Slice& slice )
+{
+  m_wppMotionLut.lut.resize( 0 );
+  m_wppMotionLut.lutIbc.resize( 0 );
+
+  m_AFFBestSATDCost   = MAX_DOUBLE;
+  m_mergeBestSATDCost = MAX_DOUBLE;
+
+  m_pcInterSearch->resetAffineMVList();
+  m_pcInterSearch->resetUniMvList();
+  m_pcInterSearch->resetReusedUniMvs();
+  if( m_pcEncCfg->getIBCMode() )
+  {
+    m_pcInterSearch->resetIbcSearch();
+  }
+}
+
+#endif
 void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] )
 {
   m_modeCtrl->initCTUEncoding( *cs.slice );
+#if ENABLE_WPP_PARALLELISM
+  // the picture-level structure is shared by all CTU lines, everything else works on CTU-local copies
+  std::unique_lock<std::mutex> csLock;
+  if( m_wppCsMutex )
+  {
+    csLock = std::unique_lock<std::mutex>( *m_wppCsMutex );
+  }
+#endif
   cs.treeType = TREE_D;
 
   cs.slice->m_mapPltCost[0].clear();
@@ -331,8 +368,25 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   tempCS->currQP[CH_L] = bestCS->currQP[CH_L] =
   tempCS->baseQP       = bestCS->baseQP       = currQP[CH_L];
   tempCS->prevQP[CH_L] = bestCS->prevQP[CH_L] = prevQP[CH_L];
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppCsMutex )
+  {
+    tempCS->motionLut = bestCS->motionLut = m_wppMotionLut;
+    csLock.unlock();
+  }
+#endif
 
   xCompressCU(tempCS, bestCS, partitioner);
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppCsMutex )
+  {
+    csLock.lock();
+    if( !cs.slice->isIntra() || cs.sps->getIBCFlag() )
+    {
+      m_wppMotionLut = bestCS->motionLut;
+    }
+  }
+#endif
   cs.slice->m_mapPltCost[0].clear();
   cs.slice->m_mapPltCost[1].clear();
   // all signals were already copied during compression if the CTU was split - at this point only the structures are copied to the top level CS
@@ -351,13 +405,31 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
     tempCS->currQP[CH_C] = bestCS->currQP[CH_C] =
     tempCS->baseQP       = bestCS->baseQP       = currQP[CH_C];
     tempCS->prevQP[CH_C] = bestCS->prevQP[CH_C] = prevQP[CH_C];
+#if ENABLE_WPP_PARALLELISM
+    if( m_wppCsMutex )
+    {
+      csLock.unlock();
+    }
+#endif
 
     xCompressCU(tempCS, bestCS, partitioner);
+#if ENABLE_WPP_PARALLELISM
+    if( m_wppCsMutex )
+    {
+      csLock.lock();
+    }
+#endif
 
     const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
     cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType),
                        copyUnsplitCTUSignals, false, false, copyUnsplitCTUSignals, true);
   }
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppCsMutex )
+  {
+    csLock.unlock();
+  }
+#endif
 
   if (m_pcEncCfg->getUseRateCtrl())
   {
@@ -1059,46 +1131,55 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
 
   Picture* picture = tempCS->picture;
 
-  int numJobs = m_modeCtrl->getNumParallelJobs( *bestCS, partitioner );
+  int  jobQueue[PARL_SPLIT_MAX_NUM_JOBS];
+  int  numJobs = m_modeCtrl->getNumParallelJobs( *bestCS, partitioner );
+  int  numUsed = m_modeCtrl->getParallelJobQueue( *bestCS, partitioner, jobQueue );
 
   bool    jobUsed                            [NUM_RESERVERD_SPLIT_JOBS];
   std::fill( jobUsed, jobUsed + NUM_RESERVERD_SPLIT_JOBS, false );
 
   const UnitArea currArea = CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType );
-  const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread();
-  omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
+  const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread() && numUsed > 1;
+  omp_set_num_threads( std::min( m_pcEncCfg->getNumSplitThreads(), numUsed ) );
 
-#pragma omp parallel for schedule(dynamic,1) if(doParallel)
-  for( int jId = 1; jId <= numJobs; jId++ )
+  // every job is a task of its own, threads running out of work pick up the next pending job
+#pragma omp parallel if(doParallel)
+#pragma omp single
+  for( int i = 0; i < numUsed; i++ )
   {
-    // thread start
-    picture->scheduler.setSplitThreadId();
-    picture->scheduler.setSplitJobId( jId );
+    const int jId = jobQueue[i];
 
-    QTBTPartitioner jobPartitioner;
-    EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
-    auto*        jobBlkCache    = dynamic_cast<CacheBlkInfoCtrl*>( jobCuEnc->m_modeCtrl );
+#pragma omp task firstprivate(jId)
+    {
+      // thread start
+      picture->scheduler.setSplitThreadId();
+      picture->scheduler.setSplitJobId( jId );
+
+      QTBTPartitioner jobPartitioner;
+      EncCu*       jobCuEnc       = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
+      auto*        jobBlkCache    = dynamic_cast<CacheBlkInfoCtrl*>( jobCuEnc->m_modeCtrl );
 #if REUSE_CU_RESULTS
-    auto*        jobBestCache   = dynamic_cast<BestEncInfoCache*>( jobCuEnc->m_modeCtrl );
+      auto*        jobBestCache   = dynamic_cast<BestEncInfoCache*>( jobCuEnc->m_modeCtrl );
 #endif
 
-    jobPartitioner.copyState( partitioner );
-    jobCuEnc      ->copyState( this, jobPartitioner, currArea, true );
+      jobPartitioner.copyState( partitioner );
+      jobCuEnc      ->copyState( this, jobPartitioner, currArea, true );
 
-    if( jobBlkCache  ) { jobBlkCache ->tick(); }
+      if( jobBlkCache  ) { jobBlkCache ->tick(); }
 #if REUSE_CU_RESULTS
-    if( jobBestCache ) { jobBestCache->tick(); }
+      if( jobBestCache ) { jobBestCache->tick(); }
 
 #endif
-    CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
-    CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
+      CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
+      CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
 
-    jobUsed[jId] = true;
+      jobUsed[jId] = true;
 
-    jobCuEnc->xCompressCU( jobTemp, jobBest, jobPartitioner );
+      jobCuEnc->xCompressCU( jobTemp, jobBest, jobPartitioner );
 
-    picture->scheduler.setSplitJobId( 0 );
-    // thread stop
+      picture->scheduler.setSplitJobId( 0 );
+      // thread stop
+    }
   }
   picture->scheduler.setSplitThreadId( 0 );
 
@@ -1196,12 +1277,6 @@ void EncCu::copyState( EncCu* other, Partitioner& partitioner, const UnitArea& c
   m_modeCtrl     ->copyState( *other->m_modeCtrl, partitioner.currArea() );
   m_pcRdCost     ->copyState( *other->m_pcRdCost );
   m_pcTrQuant    ->copyState( *other->m_pcTrQuant );
-  if( m_pcEncCfg->getLmcs() )
-  {
-    EncReshape *encReshapeThis  = dynamic_cast<EncReshape*>(       m_pcReshape);
-    EncReshape *encReshapeOther = dynamic_cast<EncReshape*>(other->m_pcReshape);
-    encReshapeThis->copyState( *encReshapeOther );
-  }
 
   m_CABACEstimator->getCtx() = other->m_CABACEstimator->getCtx();
 }
@@ -1446,6 +1521,10 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       }
     }
     assert( tempCS->treeType == TREE_L );
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    // the luma CUs are parked in the picture-level structure while the chroma CUs are searched
+    std::unique_lock<std::mutex> picCsLock( tempCS->picture->scheduler.getCsMutex() );
+#endif
     uint32_t numCuPuTu[6];
     tempCS->picture->cs->getNumCuPuTuOffset( numCuPuTu );
     tempCS->picture->cs->useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
@@ -1479,6 +1558,9 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       m_CurrCtx--;
     }
     tempCS->picture->cs->clearCuPuTuIdxMap( partitioner.currArea(), numCuPuTu[0], numCuPuTu[1], numCuPuTu[2], numCuPuTu + 3 );
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    picCsLock.unlock();
+#endif
 
 
     //recover luma tree status
@@ -2410,7 +2492,9 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
         pu.mvRefine = true;
         distParam.cur = singleMergeTempBuffer->Y();
         acMergeTmpBuffer[uiMergeCand] = m_acMergeTmpBuffer[uiMergeCand].getBuf(localUnitArea);
+        m_pcInterSearch->setApproxMc( true );
         m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, true, &(acMergeTmpBuffer[uiMergeCand]));
+        m_pcInterSearch->setApproxMc( false );
         acMergeBuffer[uiMergeCand] = m_acRealMergeBuffer[uiMergeCand].getBuf(localUnitArea);
         acMergeBuffer[uiMergeCand].copyFrom(*singleMergeTempBuffer);
         pu.mvRefine = false;
@@ -2543,7 +2627,9 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
           pu.mmvdEncOptMode = (refineStep > 2 ? 2 : 1);
           CHECK(!pu.mmvdMergeFlag, "MMVD merge should be set");
           // Don't do chroma MC here
+          m_pcInterSearch->setApproxMc( true );
           m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, false);
+          m_pcInterSearch->setApproxMc( false );
           pu.mmvdEncOptMode = 0;
           pu.mvRefine = false;
           Distortion uiSad = distParam.distFunc(distParam);
@@ -2708,6 +2794,10 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
         }
         if (pu.ciipFlag)
         {
+          if( m_pcEncCfg->getApproxCfg().useApproxMcPrescreen() )
+          {
+            m_pcInterSearch->motionCompensation( pu, acMergeTmpBuffer[uiMergeCand] );
+          }
           uint32_t bufIdx = 0;
           PelBuf tmpBuf = tempCS->getPredBuf(pu).Y();
           tmpBuf.copyFrom(acMergeTmpBuffer[uiMergeCand].Y());
@@ -2743,6 +2833,13 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
             pu.mmvdEncOptMode = 0;
             m_pcInterSearch->motionCompensation(pu);
           }
+          else if( m_pcEncCfg->getApproxCfg().useApproxMcPrescreen() )
+          {
+            // the buffered candidate prediction is approximate
+            pu.mvRefine = true;
+            m_pcInterSearch->motionCompensation( pu );
+            pu.mvRefine = false;
+          }
           else if (uiNoResidualPass != 0 && RdModeList[uiMrgHADIdx].isCIIP)
           {
             tempCS->getPredBuf().copyFrom(acMergeBuffer[uiMergeCand]);
@@ -2898,7 +2995,9 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
       tempCS->initStructData(encTestMode.qp);
       return;
     }
+    m_pcInterSearch->setApproxMc( true );
     m_pcInterSearch->motionCompensation(pu, geoBuffer[mergeCand]);
+    m_pcInterSearch->setApproxMc( false );
     geoTempBuf[mergeCand] = m_acMergeTmpBuffer[mergeCand].getBuf(localUnitArea);
     geoTempBuf[mergeCand].Y().copyFrom(geoBuffer[mergeCand].Y());
     geoTempBuf[mergeCand].Y().roundToOutputBitdepth(geoTempBuf[mergeCand].Y(), cu.slice->clpRng(COMPONENT_Y));
@@ -3023,6 +3122,27 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
       break;
     }
   }
+  if( m_pcEncCfg->getApproxCfg().useApproxMcPrescreen() )
+  {
+    // the SATD ranking used approximate predictions, redo the ones of the modes tested below
+    bool isExact[MRG_MAX_NUM_CANDS] = { false };
+    for( uint8_t i = 0; i < geoNumMrgSATDCand; i++ )
+    {
+      const uint8_t candidateIdx = geoRdModeList[i];
+      const int     mergeCand[2] = { comboList.list[candidateIdx].mergeIdx0, comboList.list[candidateIdx].mergeIdx1 };
+      for( int j = 0; j < 2; j++ )
+      {
+        if( !isExact[mergeCand[j]] )
+        {
+          mergeCtx.setMergeInfo( pu, mergeCand[j] );
+          PU::spanMotionInfo( pu, mergeCtx );
+          m_pcInterSearch->motionCompensation( pu, geoBuffer[mergeCand[j]] );
+          isExact[mergeCand[j]] = true;
+        }
+      }
+      m_pcInterSearch->weightedGeoBlk( pu, comboList.list[candidateIdx].splitDir, CHANNEL_TYPE_LUMA, geoCombinations[candidateIdx], geoBuffer[mergeCand[0]], geoBuffer[mergeCand[1]] );
+    }
+  }
   for (uint8_t i = 0; i < geoNumMrgSATDCand && isChromaEnabled(pu.chromaFormat); i++)
   {
     uint8_t candidateIdx = geoRdModeList[i];
@@ -3230,7 +3350,9 @@ void EncCu::xCheckRDCostAffineMerge2Nx2N( CodingStructure *&tempCS, CodingStruct
 
         distParam.cur = acMergeBuffer[uiMergeCand].Y();
 
+        m_pcInterSearch->setApproxMc( true );
         m_pcInterSearch->motionCompensation( pu, acMergeBuffer[uiMergeCand], REF_PIC_LIST_X, true, false );
+        m_pcInterSearch->setApproxMc( false );
 
         Distortion uiSad = distParam.distFunc( distParam );
         uint32_t   uiBitsCand = uiMergeCand + 1;
@@ -3321,7 +3443,7 @@ void EncCu::xCheckRDCostAffineMerge2Nx2N( CodingStructure *&tempCS, CodingStruct
         tempCS->initStructData( encTestMode.qp );
         return;
       }
-      if ( mrgTempBufSet )
+      if ( mrgTempBufSet && !m_pcEncCfg->getApproxCfg().useApproxMcPrescreen() )
       {
         tempCS->getPredBuf().copyFrom(acMergeBuffer[uiMergeCand], true, false);   // Copy Luma Only
         m_pcInterSearch->motionCompensation(pu, REF_PIC_LIST_X, false, true);
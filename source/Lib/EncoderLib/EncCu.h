@@ -55,6 +55,10 @@
 #include "InterSearch.h"
 #include "RateCtrl.h"
 #include "EncModeCtrl.h"
+
+#if ENABLE_WPP_PARALLELISM
+#include <mutex>
+#endif
 //! \ingroup EncoderLib
 //! \{
 
@@ -201,6 +205,10 @@ private:
   int                   m_ctuIbcSearchRangeY;
 #if ENABLE_SPLIT_PARALLELISM
   EncLib*               m_pcEncLib;
+#endif
+#if ENABLE_WPP_PARALLELISM
+  std::mutex*           m_wppCsMutex;       ///< guards the picture-level coding structure while CTU lines or tiles are encoded in parallel
+  LutMotionCand         m_wppMotionLut;     ///< HMVP candidates of the CTU line or tile encoded by this instance
 #endif
   int                   m_bestBcwIdx[2];
   double                m_bestBcwCost[2];
@@ -226,6 +234,12 @@ public:
 
   /// CTU analysis function
   void  compressCtu         ( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] );
+#if ENABLE_WPP_PARALLELISM
+  /// reset the search state carried from CTU to CTU at the start of a CTU line
+  void  initCtuLine         ( const Slice& slice );
+  void  setWppCsMutex       ( std::mutex* csMutex ) { m_wppCsMutex = csMutex; }
+  void  resetWppMotionLut   ()                      { m_wppMotionLut.lut.resize( 0 ); m_wppMotionLut.lutIbc.resize( 0 ); }
+#endif
   /// CTU encoding function
   int   updateCtuDataISlice ( const CPelBuf buf );
 
@@ -56,6 +56,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/ProfileLevelTier.h"
+#include "CommonLib/OpCounter.h"
 
 #include "DecoderLib/DecLib.h"
 
@@ -139,6 +140,11 @@ EncGOP::EncGOP()
   m_isUseLTRef = false;
   m_isPrepareLTRef = true;
   m_lastLTRefPoc = 0;
+#if ENABLE_WPP_PARALLELISM
+  m_frameBatchStart = 0;
+  m_frameBatchSize  = 0;
+  m_frameBatchTurn  = 0;
+#endif
 }
 
 EncGOP::~EncGOP()
@@ -1975,6 +1981,15 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
   pcBitstreamRedirect = new OutputBitstream;
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
   Picture* scaledRefPic[MAX_NUM_REF] = {};
+#if ENABLE_WPP_PARALLELISM
+  // a picture of a frame batch runs its setup and finishing stages in GOP order, only the compression overlaps
+  const int  frameCtxId         = m_frameBatchSize > 0 ? picIdInGOP - m_frameBatchStart : -1;
+  PicHeader* sharedPicHeader    = nullptr;
+  if( frameCtxId >= 0 )
+  {
+    xWaitFrameBatchTurn( frameCtxId );
+  }
+#endif
 
   xInitGOP( iPOCLast, iNumPicRcvd, isField, isEncodeLtRef );
 
@@ -2091,8 +2106,12 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
     m_pcSliceEncoder->create( picWidth, picHeight, chromaFormatIDC, maxCUWidth, maxCUHeight, maxTotalCUDepth );
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM && ENABLE_WPP_PARALLELISM
+    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), m_pcCfg->getNumSplitThreads() );
+#elif ENABLE_SPLIT_PARALLELISM
     pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, 1                          , 0                             , m_pcCfg->getNumSplitThreads() );
+#elif ENABLE_WPP_PARALLELISM
+    pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), 1 );
 #endif
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
     pcPic->cs->createCoeffs((bool)pcPic->cs->sps->getPLTMode());
@@ -2828,6 +2847,21 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         pcPic->fillSliceLossyLosslessArray(sliceLosslessArray, mixedLossyLossless);
       }
 
+      EncSlice*    sliceEncoder = m_pcSliceEncoder;
+      EncReshape*  reshaper     = m_pcReshaper;
+      InterSearch* interSearch  = m_pcEncLib->getInterSearch();
+#if ENABLE_WPP_PARALLELISM
+      if( frameCtxId >= 0 )
+      {
+        sharedPicHeader = pcPic->cs->picHeader;
+        xStartFrameCtx( pcPic, frameCtxId );
+        picHeader       = pcPic->cs->picHeader;
+        sliceEncoder    = m_pcEncLib->getFrameSliceEncoder( frameCtxId );
+        reshaper        = m_pcEncLib->getReshaper( m_pcEncLib->getFrameCtxDataId( frameCtxId ) );
+        interSearch     = m_pcEncLib->getInterSearch( m_pcEncLib->getFrameCtxDataId( frameCtxId ) );
+      }
+#endif
+
       for(uint32_t sliceIdx = 0; sliceIdx < pcPic->cs->pps->getNumSlicesInPic(); sliceIdx++ )
       {
         pcSlice->setSliceMap( pcPic->cs->pps->getSliceMap( sliceIdx ) );
@@ -2866,14 +2900,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
             if (pcSlice->getLmcsEnabledFlag())
             {
-              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdLUT());
-              m_pcReshaper->setSrcReshaped(true);
-              m_pcReshaper->setRecReshaped(true);
+              pcPic->getOrigBuf(COMPONENT_Y).rspSignal(reshaper->getFwdLUT());
+              reshaper->setSrcReshaped(true);
+              reshaper->setRecReshaped(true);
             }
             else
             {
-              m_pcReshaper->setSrcReshaped(false);
-              m_pcReshaper->setRecReshaped(false);
+              reshaper->setSrcReshaped(false);
+              reshaper->setRecReshaped(false);
             }
           }
         }
@@ -2883,7 +2917,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           isLossless = pcPic->losslessSlice(sliceIdx);
         }
-        m_pcSliceEncoder->setLosslessSlice(pcPic, isLossless);
+        sliceEncoder->setLosslessSlice(pcPic, isLossless);
 
 #if JVET_S0258_SUBPIC_CONSTRAINTS
         if( pcSlice->getSliceType() != I_SLICE && pcSlice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
@@ -2892,22 +2926,22 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #endif
         {
           clipMv = clipMvInSubpic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(true);
+          interSearch->setClipMvInSubPic(true);
         }
         else
         {
           clipMv = clipMvInPic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(false);
+          interSearch->setClipMvInSubPic(false);
         }
 
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        sliceEncoder->precompressSlice( pcPic );
+        sliceEncoder->compressSlice   ( pcPic, false, false );
 
         if(sliceIdx < pcPic->cs->pps->getNumSlicesInPic() - 1)
         {
           uint32_t independentSliceIdx = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
-          m_pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
+          sliceEncoder->setSliceSegmentIdx          (uiNumSliceSegments);
           // prepare for next slice
           pcSlice = pcPic->slices[uiNumSliceSegments];
           CHECK(!(pcSlice->getPPS() != 0), "Unspecified error");
@@ -2919,6 +2953,18 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         }
       }
 
+#if ENABLE_WPP_PARALLELISM
+      if( frameCtxId >= 0 )
+      {
+        // the finishing stages run on the shared encoder state again, in GOP order
+        xWaitFrameBatchTurn( m_frameBatchSize + frameCtxId );
+        if( pcPic->cs->sps->getUseLmcs() )
+        {
+          m_pcReshaper->copyState( *reshaper );
+        }
+        m_iNumPicCoded = 0;
+      }
+#endif
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
@@ -2966,7 +3012,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         const uint32_t  log2SaoOffsetScaleLuma   = (uint32_t) std::max(0, pcSlice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA  ) - MAX_SAO_TRUNCATED_BITDEPTH);
         const uint32_t  log2SaoOffsetScaleChroma = (uint32_t) std::max(0, pcSlice->getSPS()->getBitDepth(CHANNEL_TYPE_CHROMA) - MAX_SAO_TRUNCATED_BITDEPTH);
 
-        m_pcSAO->create( picWidth, picHeight, chromaFormatIDC, maxCUWidth, maxCUHeight, maxTotalCUDepth, log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
+        m_pcSAO->create( picWidth, picHeight, chromaFormatIDC, maxCUWidth, maxCUHeight, maxTotalCUDepth, log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma, m_pcCfg->getNumLoopFilterThreads() );
         m_pcSAO->destroyEncData();
         m_pcSAO->createEncData( m_pcCfg->getSaoCtuBoundary(), numCtuInFrame );
         m_pcSAO->setReshaper( m_pcReshaper );
@@ -3686,6 +3732,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       m_AUWriterIf->outputAU( accessUnit );
 
       msg( NOTICE, "\n" );
+      CacheModel* cacheModel = m_pcEncLib->getCacheModel();
+      cacheModel->reportFrame( pcSlice->getPOC() );
+      cacheModel->accumulateFrame();
+      cacheModel->clear();
+      SearchWindowModel* searchWindowModel = m_pcEncLib->getSearchWindowModel();
+      searchWindowModel->reportFrame( pcSlice->getPOC() );
+      searchWindowModel->accumulateFrame();
+      searchWindowModel->clear();
       fflush( stdout );
     }
 
@@ -3714,6 +3768,22 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcPic->cs->releaseIntermediateData();
   } // iGOPid-loop
 
+#if ENABLE_WPP_PARALLELISM
+  if( frameCtxId >= 0 )
+  {
+    if( sharedPicHeader )
+    {
+      xMovePicHeader( pcPic, sharedPicHeader );
+    }
+    else
+    {
+      // the picture was not compressed, its turns are passed on all the same
+      xPassFrameBatchTurn();
+      xWaitFrameBatchTurn( m_frameBatchSize + frameCtxId );
+    }
+    xPassFrameBatchTurn();
+  }
+#endif
   delete pcBitstreamRedirect;
 
   CHECK( m_iNumPicCoded > 1, "Unspecified error" );
@@ -3917,6 +3987,124 @@ void EncGOP::xGetBuffer( PicList&                  rcListPic,
   return;
 }
 
+#if ENABLE_WPP_PARALLELISM
+/** number of pictures from picIdInGOP on which are compressed concurrently: none of them may reference another one of the batch,
+ *  and intra pictures are left alone since their compression updates encoder-wide decisions such as the palette mode
+ */
+int EncGOP::getFrameBatchSize( int iPOCLast, int iNumPicRcvd, const int picIdInGOP ) const
+{
+  const int gopSize = m_pcCfg->getGOPSize();
+  const int maxPics = std::min( m_pcCfg->getNumFrameThreads(), omp_get_thread_limit() );
+
+  if( maxPics < 2 || iPOCLast == 0 || iNumPicRcvd != gopSize )
+  {
+    return 1;
+  }
+
+  auto isIntraPic = [&]( const int gopId )
+  {
+    const int pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry( gopId ).m_POC;
+    return m_pcCfg->getGOPEntry( gopId ).m_sliceType == 'I' || ( m_pcCfg->getIntraPeriod() > 0 && pocCurr % m_pcCfg->getIntraPeriod() == 0 );
+  };
+
+  if( isIntraPic( picIdInGOP ) )
+  {
+    return 1;
+  }
+
+  int numPics = 1;
+  while( numPics < maxPics && picIdInGOP + numPics < gopSize && !isIntraPic( picIdInGOP + numPics ) )
+  {
+    const GOPEntry& entry  = m_pcCfg->getGOPEntry( picIdInGOP + numPics );
+    bool            depend = false;
+
+    // all entries of the reference picture lists count, whether active or not
+    for( int gopId = picIdInGOP; gopId < picIdInGOP + numPics; gopId++ )
+    {
+      const int poc = m_pcCfg->getGOPEntry( gopId ).m_POC;
+      for( int i = 0; i < entry.m_numRefPics0; i++ )
+      {
+        depend |= entry.m_POC - entry.m_deltaRefPics0[i] == poc;
+      }
+      for( int i = 0; i < entry.m_numRefPics1; i++ )
+      {
+        depend |= entry.m_POC - entry.m_deltaRefPics1[i] == poc;
+      }
+    }
+    if( depend )
+    {
+      break;
+    }
+    numPics++;
+  }
+
+  return numPics;
+}
+
+/** compress a batch of independent pictures, one thread and frame context per picture
+ */
+void EncGOP::compressFrameBatch( int iPOCLast, int iNumPicRcvd, PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRec,
+                                 const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, const int picIdInGOP, const int numPics )
+{
+  m_frameBatchStart = picIdInGOP;
+  m_frameBatchSize  = numPics;
+  m_frameBatchTurn  = 0;
+
+  // every picture waits for the stages of the preceding ones, so each of them needs a thread of its own
+#pragma omp parallel for schedule(static,1) num_threads( numPics )
+  for( int frameCtxId = 0; frameCtxId < numPics; frameCtxId++ )
+  {
+    compressGOP( iPOCLast, iNumPicRcvd, rcListPic, rcListPicYuvRec, false, false, snr_conversion, printFrameMSE, false, picIdInGOP + frameCtxId );
+  }
+
+  m_frameBatchSize  = 0;
+}
+
+void EncGOP::xWaitFrameBatchTurn( const int turn )
+{
+  std::unique_lock<std::mutex> lock( m_frameBatchMutex );
+  m_frameBatchCond.wait( lock, [&] { return m_frameBatchTurn == turn; } );
+}
+
+void EncGOP::xPassFrameBatchTurn()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_frameBatchMutex );
+    m_frameBatchTurn++;
+  }
+  m_frameBatchCond.notify_all();
+}
+
+/** hand the set-up picture over to a frame context for its compression and let the next picture of the batch start its setup
+ */
+void EncGOP::xStartFrameCtx( Picture* pcPic, const int frameCtxId )
+{
+  // the setups of the following pictures write the shared picture header
+  xMovePicHeader( pcPic, m_pcEncLib->getFramePicHeader( frameCtxId ) );
+  pcPic->scheduler.setFrameDataId( m_pcEncLib->getFrameCtxDataId( frameCtxId ) );
+  m_pcEncLib->getFrameSliceEncoder( frameCtxId )->copyState( *m_pcSliceEncoder, pcPic );
+
+  xPassFrameBatchTurn();
+}
+
+/** move the picture header of a picture to another storage, the slices of the picture follow
+ */
+void EncGOP::xMovePicHeader( Picture* pcPic, PicHeader* picHeader )
+{
+  const PicHeader* prevPicHeader = pcPic->cs->picHeader;
+
+  *picHeader = *prevPicHeader;
+  for( Slice* slice : pcPic->slices )
+  {
+    if( slice->getPicHeader() == prevPicHeader )
+    {
+      slice->setPicHeader( picHeader );
+    }
+  }
+  pcPic->cs->picHeader = picHeader;
+}
+#endif
+
 #if ENABLE_QPA
 
 #ifndef BETA
@@ -4608,6 +4796,9 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     std::cout << "\r\t" << pcSlice->getPOC();
     std::cout.flush();
   }
+#if ENABLE_OP_COUNTERS
+  OpCounter::reportFrame();
+#endif
 }
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
@@ -184,6 +184,15 @@ private:
 
   AUWriterIf*             m_AUWriterIf;
 
+#if ENABLE_WPP_PARALLELISM
+  // frame batch: independent pictures of a GOP compressed concurrently, all other stages run in GOP order
+  int                     m_frameBatchStart;                    ///< GOP index of the first picture of the running batch
+  int                     m_frameBatchSize;                     ///< number of pictures of the running batch, 0 if none is running
+  int                     m_frameBatchTurn;                     ///< serial stage allowed to run: the setups of all pictures, then their finishing stages
+  std::mutex              m_frameBatchMutex;
+  std::condition_variable m_frameBatchCond;
+
+#endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
 
   hdrtoolslib::Frame **m_ppcFrameOrg;
@@ -216,6 +225,11 @@ public:
                     , const int picIdInGOP
   );
   void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, OutputBitstream* pcBitstreamRedirect);
+#if ENABLE_WPP_PARALLELISM
+  int   getFrameBatchSize   ( int iPOCLast, int iNumPicRcvd, const int picIdInGOP ) const;
+  void  compressFrameBatch  ( int iPOCLast, int iNumPicRcvd, PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRec,
+                              const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, const int picIdInGOP, const int numPics );
+#endif
 
 
   int   getGOPSize()          { return  m_iGopSize;  }
@@ -268,6 +282,12 @@ protected:
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                             int iNumPicRcvd, int iTimeOffset, Picture*& rpcPic, int pocCurr, bool isField );
+#if ENABLE_WPP_PARALLELISM
+  void  xWaitFrameBatchTurn ( const int turn );
+  void  xPassFrameBatchTurn ();
+  void  xStartFrameCtx      ( Picture* pcPic, const int frameCtxId );
+  void  xMovePicHeader      ( Picture* pcPic, PicHeader* picHeader );
+#endif
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
   void xCalculateHDRMetrics ( Picture* pcPic, double deltaE[hdrtoolslib::NB_REF_WHITE], double psnrL[hdrtoolslib::NB_REF_WHITE]);
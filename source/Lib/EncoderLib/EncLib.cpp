@@ -43,11 +43,12 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/ChromaFormat.h"
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #include <omp.h>
 #endif
 #include "EncLibCommon.h"
 #include "CommonLib/ProfileLevelTier.h"
+#include "CommonLib/OpCounter.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -63,9 +64,7 @@ EncLib::EncLib( EncLibCommon* encLibCommon )
   , m_ppsMap( encLibCommon->getPpsMap() )
   , m_apsMap( encLibCommon->getApsMap() )
   , m_AUWriterIf( nullptr )
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
-#endif
   , m_lmcsAPS(nullptr)
   , m_scalinglistAPS( nullptr )
   , m_doPlt( true )
@@ -102,12 +101,20 @@ void EncLib::create( const int layerId )
   m_iPOCLast = m_compositeRefEnabled ? -2 : -1;
   // create processing unit classes
   m_cGOPEncoder.        create( );
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if ENABLE_SPLIT_PARALLELISM
   m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
 #else
   m_numCuEncStacks  = 1;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  m_numCuEncStacks *= m_numWppThreads;
+  // each frame context compresses its pictures on a stack of its own, appended behind the ones of the picture-level parallelism
+  m_numFrameCtxs        = m_numFrameThreads > 1 ? m_numFrameThreads : 0;
+  m_numCuEncStacks     += m_numFrameCtxs;
+  m_cFrameSliceEncoder  = new EncSlice           [m_numFrameCtxs];
+  m_framePicHeader      = new PicHeader          [m_numFrameCtxs];
+#endif
 
   m_cCuEncoder      = new EncCu              [m_numCuEncStacks];
   m_cInterSearch    = new InterSearch        [m_numCuEncStacks];
@@ -124,23 +131,41 @@ void EncLib::create( const int layerId )
 #else
   m_cCuEncoder.         create( this );
 #endif
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  m_cInterSearch.cacheAssign( &m_cacheModel );
+  m_cacheModel.create( m_cacheCfgFile );
+  m_cacheModel.clear();
+  if( m_cacheModel.isCacheEnable() )
+  {
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    CHECK( m_numCuEncStacks > 1, "The cache model does not support parallel encoding" );
+    m_cInterSearch[0].cacheAssign( &m_cacheModel );
+#else
+    m_cInterSearch.cacheAssign( &m_cacheModel );
+#endif
+  }
+  m_searchWindowModel.create( m_searchWindowCfg, m_iSearchRange, m_maxCUWidth, m_bitDepth[CHANNEL_TYPE_LUMA] );
+  if( m_searchWindowModel.isEnabled() )
+  {
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    CHECK( m_numCuEncStacks > 1, "The search window model does not support parallel encoding" );
+    m_cInterSearch[0].searchWindowAssign( &m_searchWindowModel );
+#else
+    m_cInterSearch.searchWindowAssign( &m_searchWindowModel );
 #endif
+  }
 
-  m_cLoopFilter.create(floorLog2(m_maxCUWidth) - MIN_CU_LOG2);
+  m_cLoopFilter.create(floorLog2(m_maxCUWidth) - MIN_CU_LOG2, m_numLoopFilterThreads);
 
   if (!m_bLoopFilterDisable && m_encDbOpt)
   {
     m_cLoopFilter.initEncPicYuvBuffer(m_chromaFormatIDC, Size(getSourceWidth(), getSourceHeight()), getMaxCUWidth());
   }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_cReshaper = new EncReshape[m_numCuEncStacks];
 #endif
   if (m_lmcsEnabled)
   {
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for (int jId = 0; jId < m_numCuEncStacks; jId++)
     {
       m_cReshaper[jId].createEnc(getSourceWidth(), getSourceHeight(), m_maxCUWidth, m_maxCUHeight, m_bitDepth[COMPONENT_Y]);
@@ -162,7 +187,13 @@ void EncLib::destroy ()
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
   m_cSliceEncoder.      destroy();
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_WPP_PARALLELISM
+  for( int fId = 0; fId < m_numFrameCtxs; fId++ )
+  {
+    m_cFrameSliceEncoder[fId].destroy();
+  }
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cCuEncoder[jId].destroy();
@@ -170,6 +201,7 @@ void EncLib::destroy ()
 #else
   m_cCuEncoder.         destroy();
 #endif
+  m_cacheModel.destroy();
   if( m_alf )
   {
     m_cEncALF.destroy();
@@ -178,7 +210,7 @@ void EncLib::destroy ()
   m_cEncSAO.            destroy();
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for (int jId = 0; jId < m_numCuEncStacks; jId++)
   {
     m_cReshaper[jId].   destroy();
@@ -186,7 +218,7 @@ void EncLib::destroy ()
 #else
   m_cReshaper.          destroy();
 #endif
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cInterSearch[jId].   destroy();
@@ -197,7 +229,7 @@ void EncLib::destroy ()
   m_cIntraSearch.       destroy();
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   delete[] m_cCuEncoder;
   delete[] m_cInterSearch;
   delete[] m_cIntraSearch;
@@ -206,6 +238,10 @@ void EncLib::destroy ()
   delete[] m_cRdCost;
   delete[] m_CtxCache;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  delete[] m_cFrameSliceEncoder;
+  delete[] m_framePicHeader;
+#endif
 
   return;
 }
@@ -235,7 +271,7 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   xInitVPS( sps0 );
 
   xInitDCI(m_dci, sps0);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   if( omp_get_dynamic() )
   {
     omp_set_dynamic( false );
@@ -254,7 +290,7 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
     m_cRateCtrl.initHrdParam(sps0.getGeneralHrdParameters(), sps0.getOlsHrdParameters(), m_iFrameRate, m_RCInitialCpbFullness);
   }
 #endif
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cRdCost[jId].setCostMode ( m_costMode );
@@ -381,7 +417,13 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
   m_cSliceEncoder.init( this, sps0 );
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_WPP_PARALLELISM
+  for( int fId = 0; fId < m_numFrameCtxs; fId++ )
+  {
+    m_cFrameSliceEncoder[fId].init( this, sps0, getFrameCtxDataId( fId ) );
+  }
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     // precache a few objects
@@ -499,6 +541,25 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   }
 }
 
+void EncLib::xPrintApproxFilterSummary()
+{
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  ApproxFilterPolicy approxFilterPolicy = m_cInterSearch[0].getApproxFilterPolicy();
+  for( int jId = 1; jId < m_numCuEncStacks; jId++ )
+  {
+    approxFilterPolicy.addHistogram( m_cInterSearch[jId].getApproxFilterPolicy() );
+  }
+  approxFilterPolicy.printHistogram();
+#else
+  m_cInterSearch.getApproxFilterPolicy().printHistogram();
+#endif
+#if ENABLE_OP_COUNTERS
+  OpCounter::reportSequence();
+#endif
+  m_cacheModel.reportSequence();
+  m_searchWindowModel.reportSequence();
+}
+
 void EncLib::xInitScalingLists( SPS &sps, APS &aps )
 {
   // Initialise scaling lists
@@ -515,7 +576,7 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
   {
     quant->setFlatScalingList(maxLog2TrDynamicRange, sps.getBitDepths());
     quant->setUseScalingList(false);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
       getTrQuant( jId )->getQuant()->setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
@@ -528,9 +589,10 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     aps.getScalingList().setDefaultScalingList ();
     quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
     quant->setUseScalingList(true);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
+      getTrQuant( jId )->getQuant()->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
       getTrQuant( jId )->getQuant()->setUseScalingList( true );
     }
     sps.setDisableScalingMatrixForLfnstBlks(getDisableScalingMatrixForLfnstBlks());
@@ -548,9 +610,10 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     aps.getScalingList().setChromaScalingListPresentFlag((sps.getChromaFormatIdc()!=CHROMA_400));
     quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
     quant->setUseScalingList(true);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
+      getTrQuant( jId )->getQuant()->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
       getTrQuant( jId )->getQuant()->setUseScalingList( true );
     }
 #endif
@@ -782,6 +845,16 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut, int& iNumEncoded )
 {
   // compress GOP
+#if ENABLE_WPP_PARALLELISM
+  // pictures not referencing each other are compressed concurrently
+  const int numBatchPics = m_cGOPEncoder.getFrameBatchSize( m_iPOCLast, m_iNumPicRcvd, m_picIdInGOP );
+  if( numBatchPics > 1 )
+  {
+    m_cGOPEncoder.compressFrameBatch( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, snrCSC, m_printFrameMSE, m_picIdInGOP, numBatchPics );
+    m_picIdInGOP += numBatchPics - 1;
+  }
+  else
+#endif
   m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
     false, false, snrCSC, m_printFrameMSE, false, m_picIdInGOP );
 
@@ -1029,6 +1102,15 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
     m_cListPic.push_back( rpcPic );
   }
 
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+  {
+    m_cInterSearch[jId].invalidateFracPelPlanes( rpcPic );
+  }
+#else
+  m_cInterSearch.invalidateFracPelPlanes( rpcPic );
+#endif
+
   rpcPic->setBorderExtension( false );
   rpcPic->reconstructed = false;
   rpcPic->referenced = true;
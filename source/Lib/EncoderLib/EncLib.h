@@ -79,7 +79,7 @@ private:
   int                       m_layerId;
 
   // encoder search
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   InterSearch              *m_cInterSearch;                       ///< encoder search class
   IntraSearch              *m_cIntraSearch;                       ///< encoder search class
 #else
@@ -87,7 +87,7 @@ private:
   IntraSearch               m_cIntraSearch;                       ///< encoder search class
 #endif
   // coding tool
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   TrQuant                  *m_cTrQuant;                           ///< transform & quantization class
 #else
   TrQuant                   m_cTrQuant;                           ///< transform & quantization class
@@ -96,13 +96,13 @@ private:
   EncSampleAdaptiveOffset   m_cEncSAO;                            ///< sample adaptive offset class
   EncAdaptiveLoopFilter     m_cEncALF;
   HLSWriter                 m_HLSWriter;                          ///< CAVLC encoder
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   CABACEncoder             *m_CABACEncoder;
 #else
   CABACEncoder              m_CABACEncoder;
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncReshape               *m_cReshaper;                        ///< reshaper class
 #else
   EncReshape                m_cReshaper;                        ///< reshaper class
@@ -111,7 +111,12 @@ private:
   // processing unit
   EncGOP                    m_cGOPEncoder;                        ///< GOP encoder
   EncSlice                  m_cSliceEncoder;                      ///< slice encoder
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_WPP_PARALLELISM
+  EncSlice                 *m_cFrameSliceEncoder;                 ///< slice encoders of the frame contexts
+  PicHeader                *m_framePicHeader;                     ///< picture headers of the frame contexts
+  int                       m_numFrameCtxs;                       ///< number of frame contexts, each owning the last CU encoder stacks
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu                    *m_cCuEncoder;                         ///< CU encoder
 #else
   EncCu                     m_cCuEncoder;                         ///< CU encoder
@@ -122,7 +127,7 @@ private:
   ParameterSetMap<APS>&     m_apsMap;                             ///< APS. This is the base value. This is copied to PicSym
   PicHeader                 m_picHeader;                          ///< picture header
   // RD cost computation
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   RdCost                   *m_cRdCost;                            ///< RD cost computation class
   CtxCache                 *m_CtxCache;                           ///< buffer for temporarily stored context models
 #else
@@ -134,13 +139,12 @@ private:
 
   AUWriterIf*               m_AUWriterIf;
 
-#if ENABLE_SPLIT_PARALLELISM
-  int                       m_numCuEncStacks;
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  int                       m_numCuEncStacks;                     ///< number of allocated CU encoder stacks, including those of the frame contexts
 #endif
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  CacheModel                m_cacheModel;
-#endif
+  CacheModel                m_cacheModel;                 ///< reference memory access model, enabled by CacheCfg
+  SearchWindowModel         m_searchWindowModel;          ///< luma search window buffer model
 
   APS*                      m_apss[ALF_CTB_MAX_NUM_APS];
 
@@ -162,8 +166,9 @@ private:
 public:
   SPS*                      getSPS( int spsId ) { return m_spsMap.getPS( spsId ); };
   APS**                     getApss() { return m_apss; }
-  Ctx                       m_entropyCodingSyncContextState;      ///< leave in addition to vector for compatibility
-  PLTBuf                    m_palettePredictorSyncState;
+#if ENABLE_WPP_PARALLELISM
+  std::vector<Ctx>          m_entropyCodingSyncContextStateVec;   ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+#endif
 
 protected:
   void  xGetNewPicBuffer  ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Picture*& rpcPic, int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
@@ -176,6 +181,7 @@ protected:
   void  xInitScalingLists ( SPS &sps, APS &aps );     ///< initialize scaling lists
   void  xInitPPSforLT(PPS& pps);
   void  xInitHrdParameters(SPS &sps);                 ///< initialize HRDParameters parameters
+  void  xPrintApproxFilterSummary();                 ///< print the FME filter tap usage of all search instances, the operation counts and the memory model statistics
 
   void  xInitRPL(SPS &sps, bool isFieldCoding);           ///< initialize SPS from encoder options
 
@@ -194,7 +200,7 @@ public:
 
   AUWriterIf*             getAUWriterIf         ()              { return   m_AUWriterIf;           }
   PicList*                getListPic            ()              { return  &m_cListPic;             }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   InterSearch*            getInterSearch        ( int jId = 0 ) { return  &m_cInterSearch[jId];    }
   IntraSearch*            getIntraSearch        ( int jId = 0 ) { return  &m_cIntraSearch[jId];    }
 
@@ -211,13 +217,13 @@ public:
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
   EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
   EncHRD*                 getHRD                ()              { return  &m_encHRD;               }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu*                  getCuEncoder          ( int jId = 0 ) { return  &m_cCuEncoder[jId];      }
 #else
   EncCu*                  getCuEncoder          ()              { return  &m_cCuEncoder;           }
 #endif
   HLSWriter*              getHLSWriter          ()              { return  &m_HLSWriter;            }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   CABACEncoder*           getCABACEncoder       ( int jId = 0 ) { return  &m_CABACEncoder[jId];    }
 
   RdCost*                 getRdCost             ( int jId = 0 ) { return  &m_cRdCost[jId];         }
@@ -241,16 +247,26 @@ public:
   const PPS* getPPS( int Id ) { return m_ppsMap.getPS( Id); }
   const APS*             getAPS(int Id) { return m_apsMap.getPS(Id); }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void                   setNumCuEncStacks( int n )             { m_numCuEncStacks = n; }
+#if ENABLE_WPP_PARALLELISM
+  int                    getNumCuEncStacks()              const { return m_numCuEncStacks - m_numFrameCtxs; }
+  int                    getNumFrameCtxs()                const { return m_numFrameCtxs; }
+  int                    getFrameCtxDataId( int fId )     const { return getNumCuEncStacks() + fId; }
+  EncSlice*              getFrameSliceEncoder( int fId )        { return &m_cFrameSliceEncoder[fId]; }
+  PicHeader*             getFramePicHeader( int fId )           { return &m_framePicHeader[fId]; }
+#else
   int                    getNumCuEncStacks()              const { return m_numCuEncStacks; }
 #endif
+#endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncReshape*            getReshaper( int jId = 0 )             { return  &m_cReshaper[jId]; }
 #else
   EncReshape*            getReshaper()                          { return  &m_cReshaper; }
 #endif
+  CacheModel*            getCacheModel()                        { return  &m_cacheModel; }
+  SearchWindowModel*     getSearchWindowModel()                 { return  &m_searchWindowModel; }
 
   ParameterSetMap<APS>*  getApsMap() { return &m_apsMap; }
 
@@ -289,7 +305,7 @@ public:
                int& iNumEncoded, bool isTff );
 
 
-  void printSummary(bool isField) { m_cGOPEncoder.printOutSummary(m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_printHexPsnr, m_resChangeInClvsEnabled, m_spsMap.getFirstPS()->getBitDepths()); }
+  void printSummary(bool isField) { m_cGOPEncoder.printOutSummary(m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_printHexPsnr, m_resChangeInClvsEnabled, m_spsMap.getFirstPS()->getBitDepths()); xPrintApproxFilterSummary(); }
 
   int getLayerId() const { return m_layerId; }
   VPS* getVPS()          { return m_vps;     }
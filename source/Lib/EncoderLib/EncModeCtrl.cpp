@@ -259,6 +259,18 @@ void EncModeCtrl::copyState( const EncModeCtrl& other, const UnitArea& area )
   m_ComprCUCtxList = other.m_ComprCUCtxList;
 }
 
+int EncModeCtrl::getParallelJobQueue( const CodingStructure &cs, Partitioner& partitioner, int jobQueue[] ) const
+{
+  const int numJobs = getNumParallelJobs( cs, partitioner );
+
+  for( int i = 0; i < numJobs; i++ )
+  {
+    jobQueue[i] = i + 1;
+  }
+
+  return numJobs;
+}
+
 #endif
 void CacheBlkInfoCtrl::create()
 {
@@ -1026,14 +1038,27 @@ void BestEncInfoCache::copyState(const BestEncInfoCache &other, const UnitArea &
             {
               if( other.m_bestEncInfo[x][y][wIdx][hIdx]->temporalId > m_bestEncInfo[x][y][wIdx][hIdx]->temporalId )
               {
+                m_bestEncInfo[x][y][wIdx][hIdx]->cu.repositionTo( other.m_bestEncInfo[x][y][wIdx][hIdx]->cu );
+                m_bestEncInfo[x][y][wIdx][hIdx]->pu.repositionTo( other.m_bestEncInfo[x][y][wIdx][hIdx]->pu );
                 m_bestEncInfo[x][y][wIdx][hIdx]->cu       = other.m_bestEncInfo[x][y][wIdx][hIdx]->cu;
                 m_bestEncInfo[x][y][wIdx][hIdx]->pu       = other.m_bestEncInfo[x][y][wIdx][hIdx]->pu;
                 m_bestEncInfo[x][y][wIdx][hIdx]->numTus   = other.m_bestEncInfo[x][y][wIdx][hIdx]->numTus;
                 m_bestEncInfo[x][y][wIdx][hIdx]->poc      = other.m_bestEncInfo[x][y][wIdx][hIdx]->poc;
                 m_bestEncInfo[x][y][wIdx][hIdx]->testMode = other.m_bestEncInfo[x][y][wIdx][hIdx]->testMode;
 
+                // same as in setFromCs, the cached units keep their own buffers and the TUs may differ in size
                 for( int i = 0; i < m_bestEncInfo[x][y][wIdx][hIdx]->numTus; i++ )
-                  m_bestEncInfo[x][y][wIdx][hIdx]->tus[i] = other.m_bestEncInfo[x][y][wIdx][hIdx]->tus[i];
+                {
+                        TransformUnit &tu      =       m_bestEncInfo[x][y][wIdx][hIdx]->tus[i];
+                  const TransformUnit &otherTu = other.m_bestEncInfo[x][y][wIdx][hIdx]->tus[i];
+
+                  tu.repositionTo( otherTu );
+                  tu.resizeTo    ( otherTu );
+                  for( auto &blk : otherTu.blocks )
+                  {
+                    if( blk.valid() ) tu.copyComponentFrom( otherTu, blk.compID );
+                  }
+                }
               }
             }
             else if( y + ( height >> MIN_CU_LOG2 ) > maxPosY + 1 )
@@ -1857,9 +1882,9 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     {
       unsigned idx1, idx2, idx3, idx4;
       getAreaIdx(partitioner.currArea().Y(), *slice.getPPS()->pcv, idx1, idx2, idx3, idx4);
-      if (g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4])
+      if (m_pcInterSearch->isReusedUniMvsFilled(idx1, idx2, idx3, idx4))
       {
-        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), g_reusedUniMVs[idx1][idx2][idx3][idx4]);
+        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), m_pcInterSearch->getReusedUniMvs(idx1, idx2, idx3, idx4));
       }
     }
     if( !bestCS || ( bestCS && isModeSplit( bestMode ) ) )
@@ -2216,6 +2241,29 @@ bool EncModeCtrlMTnoRQT::parallelJobSelector( const EncTestMode& encTestmode, co
   }
 }
 
+int EncModeCtrlMTnoRQT::getParallelJobQueue( const CodingStructure &cs, Partitioner& partitioner, int jobQueue[] ) const
+{
+  // jobs in the order they are handed out to the split threads, the ones searching the largest sub-trees go first
+  static const int       jobOrder[PARL_SPLIT_MAX_NUM_JOBS] = { 2, 4, 3, 6, 5, 1 };
+  static const PartSplit jobSplit[PARL_SPLIT_MAX_NUM_JOBS] = { CU_DONT_SPLIT, CU_QUAD_SPLIT, CU_VERT_SPLIT, CU_HORZ_SPLIT, CU_TRIV_SPLIT, CU_TRIH_SPLIT };
+
+  const int numJobs = getNumParallelJobs( cs, partitioner );
+  int       numUsed = 0;
+
+  for( int i = 0; i < PARL_SPLIT_MAX_NUM_JOBS; i++ )
+  {
+    const int jId = jobOrder[i];
+
+    // a split job without a testable split would only copy the encoder state around
+    if( jId <= numJobs && ( jId == 1 || partitioner.canSplit( jobSplit[jId - 1], cs ) ) )
+    {
+      jobQueue[numUsed++] = jId;
+    }
+  }
+
+  return numUsed;
+}
+
 #endif
 
 
@@ -316,6 +316,7 @@ public:
   virtual int  getNumParallelJobs   ( const CodingStructure &cs, Partitioner& partitioner )                                 const { return 1;     }
   virtual bool isParallelSplit      ( const CodingStructure &cs, Partitioner& partitioner )                                 const { return false; }
   virtual bool parallelJobSelector  ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner ) const { return true;  }
+  virtual int  getParallelJobQueue  ( const CodingStructure &cs, Partitioner& partitioner, int jobQueue[] )              const;
           void setParallelSplit     ( bool val ) { m_runNextInParallel = val; }
 #endif
 
@@ -608,6 +609,7 @@ public:
   virtual int  getNumParallelJobs ( const CodingStructure &cs, Partitioner& partitioner ) const;
   virtual bool isParallelSplit    ( const CodingStructure &cs, Partitioner& partitioner ) const;
   virtual bool parallelJobSelector( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner ) const;
+  virtual int  getParallelJobQueue( const CodingStructure &cs, Partitioner& partitioner, int jobQueue[] ) const;
 #endif
   virtual bool checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner );
 };
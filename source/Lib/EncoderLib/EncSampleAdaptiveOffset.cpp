@@ -47,6 +47,10 @@
 #include <stdio.h>
 #include <math.h>
 
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -273,8 +277,6 @@ void EncSampleAdaptiveOffset::addPreDBFStatistics(std::vector<SAOStatData**>& bl
 
 void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats, PelUnitBuf& orgYuv, PelUnitBuf& srcYuv, CodingStructure& cs, bool isCalculatePreDeblockSamples)
 {
-  bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
-
   const PreCalcValues& pcv = *cs.pcv;
   const int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
@@ -285,59 +287,63 @@ void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
     m_signLineBuf2.resize(lineBufferSize);
   }
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  // every CTU gathers into its own statistics, the shared sign lines of the virtual boundary path keep that one serial
+  const int numThreads = cs.picHeader->getVirtualBoundariesPresentFlag() ? 1 : std::min<int>( m_numThreads, pcv.sizeInCtus );
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+#endif
+  for( int ctuRsAddr = 0; ctuRsAddr < (int)pcv.sizeInCtus; ctuRsAddr++ )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
 
-      deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
+    const uint32_t xPos   = ( ctuRsAddr % pcv.widthInCtus ) * pcv.maxCUWidth;
+    const uint32_t yPos   = ( ctuRsAddr / pcv.widthInCtus ) * pcv.maxCUHeight;
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
-      //For simplicity, here only picture boundaries are considered.
+    deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
 
-      isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
-      isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
-      isAboveRightAvail = ((yPos > 0) && (isRightAvail));
+    //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
+    //For simplicity, here only picture boundaries are considered.
 
-      int numHorVirBndry = 0, numVerVirBndry = 0;
-      int horVirBndryPos[] = { -1,-1,-1 };
-      int verVirBndryPos[] = { -1,-1,-1 };
-      int horVirBndryPosComp[] = { -1,-1,-1 };
-      int verVirBndryPosComp[] = { -1,-1,-1 };
-      bool isCtuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries(xPos, yPos, width, height, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, cs.picHeader );
+    isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
+    isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
+    isAboveRightAvail = ((yPos > 0) && (isRightAvail));
 
-      for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-      {
-        const ComponentID compID = ComponentID(compIdx);
-        const CompArea& compArea = area.block( compID );
+    int numHorVirBndry = 0, numVerVirBndry = 0;
+    int horVirBndryPos[] = { -1,-1,-1 };
+    int verVirBndryPos[] = { -1,-1,-1 };
+    int horVirBndryPosComp[] = { -1,-1,-1 };
+    int verVirBndryPosComp[] = { -1,-1,-1 };
+    bool isCtuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries(xPos, yPos, width, height, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, cs.picHeader );
 
-        int  srcStride  = srcYuv.get(compID).stride;
-        Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
+    for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+    {
+      const ComponentID compID = ComponentID(compIdx);
+      const CompArea& compArea = area.block( compID );
 
-        int  orgStride  = orgYuv.get(compID).stride;
-        Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
+      int  srcStride  = srcYuv.get(compID).stride;
+      Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
 
-        for (int i = 0; i < numHorVirBndry; i++)
-        {
-          horVirBndryPosComp[i] = (horVirBndryPos[i] >> ::getComponentScaleY(compID, area.chromaFormat)) - compArea.y;
-        }
-        for (int i = 0; i < numVerVirBndry; i++)
-        {
-          verVirBndryPosComp[i] = (verVirBndryPos[i] >> ::getComponentScaleX(compID, area.chromaFormat)) - compArea.x;
-        }
+      int  orgStride  = orgYuv.get(compID).stride;
+      Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
 
-        getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
-                  , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
-                  , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
-                  , isCalculatePreDeblockSamples
-                  , isCtuCrossedByVirtualBoundaries, horVirBndryPosComp, verVirBndryPosComp, numHorVirBndry, numVerVirBndry
-                  );
+      for (int i = 0; i < numHorVirBndry; i++)
+      {
+        horVirBndryPosComp[i] = (horVirBndryPos[i] >> ::getComponentScaleY(compID, area.chromaFormat)) - compArea.y;
       }
-      ctuRsAddr++;
+      for (int i = 0; i < numVerVirBndry; i++)
+      {
+        verVirBndryPosComp[i] = (verVirBndryPos[i] >> ::getComponentScaleX(compID, area.chromaFormat)) - compArea.x;
+      }
+
+      getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
+                , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
+                , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                , isCalculatePreDeblockSamples
+                , isCtuCrossedByVirtualBoundaries, horVirBndryPosComp, verVirBndryPosComp, numHorVirBndry, numVerVirBndry
+                );
     }
   }
 }
@@ -1141,6 +1147,13 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
     SAOStatData& statsData= statsDataTypes[typeIdx];
     statsData.reset();
 
+    if (typeIdx != SAO_TYPE_BO && !isCtuCrossedByVirtualBoundaries)
+    {
+      getBlkEdgeStats(compIdx, typeIdx, statsData, srcBlk, orgBlk, srcStride, orgStride, width, height
+                    , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isCalculatePreDeblockSamples);
+      continue;
+    }
+
     srcLine = srcBlk;
     orgLine = orgBlk;
     diff    = statsData.diff;
@@ -1538,6 +1551,91 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   }
 }
 
+void EncSampleAdaptiveOffset::getBlkEdgeStats(const ComponentID compIdx, int typeIdx, SAOStatData& statsData
+                        , const Pel* srcBlk, const Pel* orgBlk, int srcStride, int orgStride, int width, int height
+                        , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail
+                        , bool isCalculatePreDeblockSamples
+                        )
+{
+  // same sample ranges as getBlkStats, without virtual boundaries every edge class only depends on the two neighbours of the sample
+  const int skipLinesR = m_skipLinesR[compIdx][typeIdx];
+  const int skipLinesB = m_skipLinesB[compIdx][typeIdx];
+  int64_t* diff  = statsData.diff;
+  int64_t* count = statsData.count;
+  int startX, endX, endY;
+
+  switch(typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    {
+      endY   = (isBelowAvail) ? (height - skipLinesB) : height;
+      startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
+                                               : (isRightAvail ? (width - skipLinesR) : (width - 1));
+      endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : (width - 1))
+                                               : (isRightAvail ? width : (width - 1));
+      m_getEdgeStatsBlk(srcBlk, srcStride, orgBlk, orgStride, -1, 1, startX, endX, endY, diff, count);
+      if (isCalculatePreDeblockSamples && isBelowAvail)
+      {
+        m_getEdgeStatsBlk(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, -1, 1,
+                          isLeftAvail ? 0 : 1, isRightAvail ? width : (width - 1), skipLinesB, diff, count);
+      }
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const int startY = isAboveAvail ? 0 : 1;
+      endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+      startX = (!isCalculatePreDeblockSamples) ? 0
+                                               : (isRightAvail ? (width - skipLinesR) : width);
+      endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : width)
+                                               : width;
+      m_getEdgeStatsBlk(srcBlk + startY * srcStride, srcStride, orgBlk + startY * orgStride, orgStride, -srcStride, srcStride,
+                        startX, endX, endY - startY, diff, count);
+      if (isCalculatePreDeblockSamples && isBelowAvail)
+      {
+        m_getEdgeStatsBlk(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, -srcStride, srcStride,
+                          0, width, skipLinesB, diff, count);
+      }
+    }
+    break;
+  case SAO_TYPE_EO_135:
+  case SAO_TYPE_EO_45:
+    {
+      const bool isEO135 = typeIdx == SAO_TYPE_EO_135;
+      const int  posA    = isEO135 ? (-srcStride - 1) : (-srcStride + 1);
+      const int  posB    = isEO135 ? ( srcStride + 1) : ( srcStride - 1);
+      endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+      startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
+                                               : (isRightAvail ? (width - skipLinesR) : (width - 1));
+      endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : (width - 1))
+                                               : (isRightAvail ? width : (width - 1));
+
+      //1st line
+      int firstLineStartX = startX;
+      int firstLineEndX   = endX;
+      if (!isCalculatePreDeblockSamples)
+      {
+        firstLineStartX = isEO135 ? (isAboveLeftAvail ? 0 : 1) : (isAboveAvail ? startX : endX);
+        firstLineEndX   = isEO135 ? (isAboveAvail ? endX : 1) : ((!isRightAvail && isAboveRightAvail) ? width : endX);
+      }
+      m_getEdgeStatsBlk(srcBlk, srcStride, orgBlk, orgStride, posA, posB, firstLineStartX, firstLineEndX, 1, diff, count);
+
+      //middle lines
+      m_getEdgeStatsBlk(srcBlk + srcStride, srcStride, orgBlk + orgStride, orgStride, posA, posB, startX, endX, endY - 1, diff, count);
+      if (isCalculatePreDeblockSamples && isBelowAvail)
+      {
+        m_getEdgeStatsBlk(srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, posA, posB,
+                          isLeftAvail ? 0 : 1, isRightAvail ? width : (width - 1), skipLinesB, diff, count);
+      }
+    }
+    break;
+  default:
+    {
+      THROW("Not a supported SAO type");
+    }
+  }
+}
+
 void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const
 {
   bool isLoopFiltAcrossSlicePPS = cs.pps->getLoopFilterAcrossSlicesEnabledFlag();
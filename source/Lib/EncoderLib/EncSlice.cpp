@@ -56,6 +56,13 @@
 
 EncSlice::EncSlice()
  : m_encCABACTableIdx(I_SLICE)
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+ , m_dataId(0)
+#endif
+#if ENABLE_WPP_PARALLELISM
+ , m_wppCtuLines(false)
+ , m_wppTiles(false)
+#endif
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -79,19 +86,22 @@ void EncSlice::destroy()
   m_viRdPicQp.clear();
 }
 
-void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
+void EncSlice::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int dataId ) )
 {
   m_pcCfg             = pcEncLib;
   m_pcLib             = pcEncLib;
   m_pcListPic         = pcEncLib->getListPic();
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  m_dataId            = dataId;
+#endif
 
   m_pcGOPEncoder      = pcEncLib->getGOPEncoder();
-  m_pcCuEncoder       = pcEncLib->getCuEncoder();
-  m_pcInterSearch     = pcEncLib->getInterSearch();
-  m_CABACWriter       = pcEncLib->getCABACEncoder()->getCABACWriter   (&sps);
-  m_CABACEstimator    = pcEncLib->getCABACEncoder()->getCABACEstimator(&sps);
-  m_pcTrQuant         = pcEncLib->getTrQuant();
-  m_pcRdCost          = pcEncLib->getRdCost();
+  m_pcCuEncoder       = pcEncLib->getCuEncoder( PARL_PARAM0( dataId ) );
+  m_pcInterSearch     = pcEncLib->getInterSearch( PARL_PARAM0( dataId ) );
+  m_CABACWriter       = pcEncLib->getCABACEncoder( PARL_PARAM0( dataId ) )->getCABACWriter   (&sps);
+  m_CABACEstimator    = pcEncLib->getCABACEncoder( PARL_PARAM0( dataId ) )->getCABACEstimator(&sps);
+  m_pcTrQuant         = pcEncLib->getTrQuant( PARL_PARAM0( dataId ) );
+  m_pcRdCost          = pcEncLib->getRdCost( PARL_PARAM0( dataId ) );
 
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -100,6 +110,27 @@ void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
   m_pcRateCtrl        = pcEncLib->getRateCtrl();
 }
 
+#if ENABLE_WPP_PARALLELISM
+/** take over the picture-level setup of another slice encoder, so that the picture can be compressed on this encoder's stack
+ */
+void EncSlice::copyState( const EncSlice& other, Picture* pcPic )
+{
+  m_vdRdPicLambda     = other.m_vdRdPicLambda;
+  m_vdRdPicQp         = other.m_vdRdPicQp;
+  m_viRdPicQp         = other.m_viRdPicQp;
+  m_uiSliceSegmentIdx = other.m_uiSliceSegmentIdx;
+#if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
+  m_gopID             = other.m_gopID;
+#endif
+#if ENABLE_QPA
+  m_adaptedLumaQP     = other.m_adaptedLumaQP;
+#endif
+
+  xInitWppCtuEncoder( pcPic, m_pcLib, m_dataId, false );
+}
+
+#endif
+
 void
 EncSlice::setUpLambda( Slice* slice, const double dLambda, int iQP)
 {
@@ -1298,7 +1329,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 
   m_CABACEstimator->initCtxModels( *pcSlice );
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
   {
     CABACWriter* cw = m_pcLib->getCABACEncoder( jId )->getCABACEstimator( pcSlice->getSPS() );
@@ -1353,7 +1384,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
                            (m_pcCfg->getBaseQP() >= 38) || (m_pcCfg->getSourceWidth() <= 512 && m_pcCfg->getSourceHeight() <= 320), m_adaptedLumaQP))
     {
       m_CABACEstimator->initCtxModels (*pcSlice);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
       for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
       {
         CABACWriter* cw = m_pcLib->getCABACEncoder (jId)->getCABACEstimator (pcSlice->getSPS());
@@ -1387,7 +1418,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif
   m_pcInterSearch->resetAffineMVList();
   m_pcInterSearch->resetUniMvList();
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
+  m_pcInterSearch->resetReusedUniMvs();
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
   if (checkPLTRatio) m_pcLib->checkPltStats( pcPic );
 }
@@ -1474,19 +1505,13 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   CodingStructure&  cs            = *pcPic->cs;
   Slice* pcSlice                  = cs.slice;
   const PreCalcValues& pcv        = *cs.pcv;
-  const uint32_t        widthInCtus   = pcv.widthInCtus;
-#if ENABLE_QPA
-  const int iQPIndex              = pcSlice->getSliceQpBase();
-#endif
 
-#if ENABLE_SPLIT_PARALLELISM
-  const int       dataId          = 0;
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  const int       dataId          = m_dataId;
 #endif
-  CABACWriter*    pCABACWriter    = pEncLib->getCABACEncoder( PARL_PARAM0( dataId ) )->getCABACEstimator( pcSlice->getSPS() );
   TrQuant*        pTrQuant        = pEncLib->getTrQuant( PARL_PARAM0( dataId ) );
   RdCost*         pRdCost         = pEncLib->getRdCost( PARL_PARAM0( dataId ) );
   EncCfg*         pCfg            = pEncLib;
-  RateCtrl*       pRateCtrl       = pEncLib->getRateCtrl();
   pRdCost->setLosslessRDCost(pcSlice->isLossless());
 #if RDOQ_CHROMA_LAMBDA
   pTrQuant    ->setLambdas( pcSlice->getLambdas() );
@@ -1518,242 +1543,348 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
   }
 
-  // for every CTU in the slice
-  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder(false, cs);
+    m_pcInterSearch->initWeightIdxBits();
+  }
+  if (pcSlice->getSPS()->getUseLmcs())
   {
-    const int32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper( PARL_PARAM0( dataId ) ), pcSlice->getSPS()->getChromaFormatIdc());
 
-    // update CABAC state
-    const uint32_t ctuXPosInCtus        = ctuRsAddr % widthInCtus;
-    const uint32_t ctuYPosInCtus        = ctuRsAddr / widthInCtus;
+#if ENABLE_SPLIT_PARALLELISM
+    // the reshaper does not change while the slice is encoded, so the split jobs get their copy only once
+    for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
+    {
+      m_pcLib->getReshaper(jId)->copyState(*m_pcLib->getReshaper());
+      m_pcLib->getCuEncoder(jId)->setDecCuReshaperInEncCU(m_pcLib->getReshaper(jId), pcSlice->getSPS()->getChromaFormatIdc());
+    }
+#endif
+  }
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
-    const Position pos (ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight);
-    const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
-    DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+  bool sharedPicCs = false;
+#if ENABLE_SPLIT_PARALLELISM
+  sharedPicCs |= pCfg->getNumSplitThreads() > 1;
+#endif
+#if ENABLE_WPP_PARALLELISM
+  sharedPicCs |= pCfg->getNumWppThreads() > 1;
+#endif
+  if( sharedPicCs )
+  {
+    // neighbouring units are looked up in the picture-level structure while other threads append to it,
+    // so its unit lists get the capacity for the smallest possible units (16 samples) of all components
+    const size_t maxNumUnits = ( cs.area.Y().area() + ( isChromaEnabled( cs.area.chromaFormat ) ? 2 * cs.area.Cb().area() : 0 ) ) >> 4;
+
+    cs.cus.reserve( maxNumUnits );
+    cs.pus.reserve( maxNumUnits );
+    cs.tus.reserve( maxNumUnits );
+  }
+#endif
+
+#if ENABLE_WPP_PARALLELISM
+  m_wppCtuLines = pCfg->getNumWppThreads() > 1 && pEncLib->getEntropyCodingSyncEnabledFlag()
+               && pcSlice->getNumCtuInSlice() == pcv.sizeInCtus && pcSlice->getPPS()->getNumTiles() == 1;
+
+  if( m_wppCtuLines )
+  {
+    const int widthInCtus  = int( pcv.widthInCtus );
+    const int heightInCtus = int( pcv.heightInCtus );
 
-    if( pCfg->getSwitchPOC() != pcPic->poc || -1 == pCfg->getDebugCTU() )
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && cs.pps->ctuIsTileColBd( ctuXPosInCtus ))
+    pEncLib->m_entropyCodingSyncContextStateVec.resize( heightInCtus );
+    pcPic->scheduler.resetLines();
+    for( int jId = 0; jId < pEncLib->getNumCuEncStacks(); jId++ )
     {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
+      xInitWppCtuEncoder( pcPic, pEncLib, jId, bFastDeltaQP );
+      pEncLib->getCuEncoder( jId )->setWppCsMutex( &pcPic->scheduler.getCsMutex() );
     }
 
-    const SubPic &curSubPic = pcSlice->getPPS()->getSubPicFromPos(pos);
-    // padding/restore at slice level
-    if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == 0)
+    omp_set_num_threads( pCfg->getNumWppThreads() );
+
+#pragma omp parallel for schedule(dynamic,1)
+    for( int ctuPosY = 0; ctuPosY < heightInCtus; ctuPosY++ )
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+      pcPic->scheduler.setWppThreadId();
+      const int wppDataId = pcPic->scheduler.getWppDataId();
 
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
-      {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
-        {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+      int linePrevQP[2] = { prevQP[0], prevQP[1] };
+      int lineCurrQP[2] = { currQP[0], currQP[1] };
 
-#if JVET_S0258_SUBPIC_CONSTRAINTS
-          if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
-#else
-          if (!refPic->getSubPicSaved() && refPic->numSubpics > 1)
-#endif
-          {
-            refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(true);
-          }
-        }
+      for( int ctuPosX = 0; ctuPosX < widthInCtus; ctuPosX++ )
+      {
+        pcPic->scheduler.wait( ctuPosX, ctuPosY );
+        xEncodeCtu( pcPic, pEncLib, ctuPosY * widthInCtus + ctuPosX, linePrevQP, lineCurrQP, wppDataId );
+        pcPic->scheduler.setReady( ctuPosX, ctuPosY );
       }
     }
-    if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && cs.pps->ctuIsTileRowBd( ctuYPosInCtus ))
+
+    for( int jId = 0; jId < pEncLib->getNumCuEncStacks(); jId++ )
     {
-      pCABACWriter->initCtxModels( *pcSlice );
-      cs.resetPrevPLT(cs.prevPLT);
-      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      pEncLib->getCuEncoder( jId )->setWppCsMutex( nullptr );
     }
-    else if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag())
+
+    // bits and distortion are only summed up once all CTU lines are done
+    m_uiPicTotalBits = int( cs.fracBits >> SCALE_BITS );
+    m_uiPicDist      = cs.dist;
+    return;
+  }
+
+  // tiles of the slice, given as ranges of CTU indices within the slice
+  std::vector<std::pair<uint32_t, uint32_t>> tileCtus;
+  if( pCfg->getNumWppThreads() > 1 && !pEncLib->getEntropyCodingSyncEnabledFlag() )
+  {
+    for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
     {
-      // reset and then update contexts to the state at the end of the top CTU (if within current slice and tile).
-      pCABACWriter->initCtxModels( *pcSlice );
-      cs.resetPrevPLT(cs.prevPLT);
-      if( cs.getCURestricted( pos.offset(0, -1), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
+      if( ctuIdx == 0 || cs.pps->getTileIdx( pcSlice->getCtuAddrInSlice( ctuIdx ) ) != cs.pps->getTileIdx( pcSlice->getCtuAddrInSlice( ctuIdx - 1 ) ) )
       {
-        // Top is available, we use it.
-        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextState;
-        cs.setPrevPLT(pEncLib->m_palettePredictorSyncState);
+        tileCtus.push_back( std::make_pair( ctuIdx, ctuIdx ) );
       }
-      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      tileCtus.back().second = ctuIdx + 1;
+    }
+  }
+  m_wppTiles = tileCtus.size() > 1;
+
+  if( m_wppTiles )
+  {
+    const Position firstCtuPos( ( pcSlice->getFirstCtuRsAddrInSlice() % pcv.widthInCtus ) * pcv.maxCUWidth, ( pcSlice->getFirstCtuRsAddrInSlice() / pcv.widthInCtus ) * pcv.maxCUHeight );
+    const SubPic&  curSubPic    = pcSlice->getPPS()->getSubPicFromPos( firstCtuPos );
+    const bool     padSubPic    = pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+
+    // the reference borders are shared by all tiles of the slice
+    if( padSubPic )
+    {
+      xPadSubPicRefs( pcSlice, curSubPic );
     }
 
+    for( int jId = 0; jId < pEncLib->getNumCuEncStacks(); jId++ )
+    {
+      xInitWppCtuEncoder( pcPic, pEncLib, jId, bFastDeltaQP );
+      pEncLib->getCuEncoder( jId )->setWppCsMutex( &pcPic->scheduler.getCsMutex() );
+    }
 
-#if RDOQ_CHROMA_LAMBDA && ENABLE_QPA && !ENABLE_QPA_SUB_CTU
-    double oldLambdaArray[MAX_NUM_COMPONENT] = {0.0};
-#endif
-    const double oldLambda = pRdCost->getLambda();
-    if ( pCfg->getUseRateCtrl() )
+    omp_set_num_threads( pCfg->getNumWppThreads() );
+
+#pragma omp parallel for schedule(dynamic,1)
+    for( int tileIdx = 0; tileIdx < int( tileCtus.size() ); tileIdx++ )
     {
-      int estQP        = pcSlice->getSliceQp();
-      double estLambda = -1.0;
-      double bpp       = -1.0;
+      pcPic->scheduler.setWppThreadId();
+      const int wppDataId = pcPic->scheduler.getWppDataId();
 
-      if( ( pcPic->slices[0]->isIRAP() && pCfg->getForceIntraQP() ) || !pCfg->getLCULevelRC() )
+      int tilePrevQP[2] = { prevQP[0], prevQP[1] };
+      int tileCurrQP[2] = { currQP[0], currQP[1] };
+
+      for( uint32_t ctuIdx = tileCtus[tileIdx].first; ctuIdx < tileCtus[tileIdx].second; ctuIdx++ )
       {
-        estQP = pcSlice->getSliceQp();
+        xEncodeCtu( pcPic, pEncLib, ctuIdx, tilePrevQP, tileCurrQP, wppDataId );
       }
-      else
-      {
-        bpp = pRateCtrl->getRCPic()->getLCUTargetBpp(pcSlice->isIRAP());
-        if ( pcPic->slices[0]->isIntra())
-        {
-          estLambda = pRateCtrl->getRCPic()->getLCUEstLambdaAndQP(bpp, pcSlice->getSliceQp(), &estQP);
-        }
-        else
-        {
-          estLambda = pRateCtrl->getRCPic()->getLCUEstLambda( bpp );
-          estQP     = pRateCtrl->getRCPic()->getLCUEstQP    ( estLambda, pcSlice->getSliceQp() );
-        }
+    }
 
-        estQP     = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, estQP );
+    for( int jId = 0; jId < pEncLib->getNumCuEncStacks(); jId++ )
+    {
+      pEncLib->getCuEncoder( jId )->setWppCsMutex( nullptr );
+    }
+    if( padSubPic )
+    {
+      xRestoreSubPicRefs( pcSlice, curSubPic );
+    }
+
+    m_uiPicTotalBits = int( cs.fracBits >> SCALE_BITS );
+    m_uiPicDist      = cs.dist;
+    m_wppTiles       = false;
+    return;
+  }
 
-        pRdCost->setLambda(estLambda, pcSlice->getSPS()->getBitDepths());
-#if WCG_EXT
-        pRdCost->saveUnadjustedLambda();
-#endif
-        for (uint32_t compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
-        {
-          const ComponentID compID = ComponentID(compIdx);
-          int chromaQPOffset = pcSlice->getPPS()->getQpOffset(compID) + pcSlice->getSliceChromaQpDelta(compID);
-          int qpc = pcSlice->getSPS()->getMappedChromaQpValue(compID, estQP) + chromaQPOffset;
-          double tmpWeight = pow(2.0, (estQP - qpc) / 3.0);  // takes into account of the chroma qp mapping and chroma qp Offset
-          if (m_pcCfg->getDepQuantEnabledFlag())
-          {
-            tmpWeight *= (m_pcCfg->getGOPSize() >= 8 ? pow(2.0, 0.1 / 3.0) : pow(2.0, 0.2 / 3.0));  // increase chroma weight for dependent quantization (in order to reduce bit rate shift from chroma to luma)
-          }
-          m_pcRdCost->setDistortionWeight(compID, tmpWeight);
-        }
-#if RDOQ_CHROMA_LAMBDA
-        const double lambdaArray[MAX_NUM_COMPONENT] = {estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Y),
-                                                       estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cb),
-                                                       estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cr)};
-        pTrQuant->setLambdas( lambdaArray );
-#else
-        pTrQuant->setLambda( estLambda );
 #endif
-      }
+  // for every CTU in the slice
+  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    xEncodeCtu( pcPic, pEncLib, ctuIdx, prevQP, currQP PARL_PARAM( dataId ) );
+  }
+
+  // this is wpp exclusive section
 
-      pRateCtrl->setRCQP( estQP );
+//  m_uiPicTotalBits += actualBits;
+//  m_uiPicDist       = cs.dist;
+
+}
+
+#if ENABLE_WPP_PARALLELISM
+/** replicate the slice-level setup of the first CU encoder stack to another stack
+ */
+void EncSlice::xInitWppCtuEncoder( Picture* pcPic, EncLib* pEncLib, const int dataId, const bool bFastDeltaQP )
+{
+  const Slice* pcSlice = pcPic->cs->slice;
+  EncCu*       cuEnc   = pEncLib->getCuEncoder( dataId );
+
+  if( dataId > 0 )
+  {
+    pEncLib->getRdCost( dataId )->copyState( *pEncLib->getRdCost() );
+    pEncLib->getRdCost( dataId )->setLosslessRDCost( pcSlice->isLossless() );
+    pEncLib->getTrQuant( dataId )->copyState( *pEncLib->getTrQuant() );
+    pEncLib->getInterSearch( dataId )->copyState( *pEncLib->getInterSearch() );
+
+    cuEnc->getModeCtrl()->setFastDeltaQp( bFastDeltaQP );
+    cuEnc->getModeCtrl()->setPltEnc( pEncLib->getCuEncoder()->getModeCtrl()->getPltEnc() );
+
+    if( pcSlice->getSPS()->getFpelMmvdEnabledFlag() || ( pcSlice->getSPS()->getIBCFlag() && m_pcCfg->getIBCHashSearch() ) )
+    {
+      cuEnc->getIbcHashMap().destroy();
+      cuEnc->getIbcHashMap().init( pcSlice->getPPS()->getPicWidthInLumaSamples(), pcSlice->getPPS()->getPicHeightInLumaSamples() );
+      cuEnc->getIbcHashMap().rebuildPicHashMap( pcPic->getTrueOrigBuf() );
     }
-#if ENABLE_QPA
-    else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
+    if( pcSlice->getSliceType() == B_SLICE )
     {
-#if ENABLE_QPA_SUB_CTU
-      const int adaptedQP    = applyQPAdaptationSubCtu (cs, ctuArea, ctuRsAddr, m_pcCfg->getLumaLevelToDeltaQPMapping().mode == LUMALVL_TO_DQP_NUM_MODES);
-#else
-      const int adaptedQP    = pcPic->m_iOffsetCtu[ctuRsAddr];
+      pEncLib->getInterSearch( dataId )->initWeightIdxBits();
+    }
+    if( pcSlice->getSPS()->getUseLmcs() )
+    {
+      pEncLib->getReshaper( dataId )->copyState( *pEncLib->getReshaper() );
+      cuEnc->setDecCuReshaperInEncCU( pEncLib->getReshaper( dataId ), pcSlice->getSPS()->getChromaFormatIdc() );
+    }
+  }
+  pEncLib->getRdCost( dataId )->resetStore();
+  pEncLib->getTrQuant( dataId )->resetStore();
+}
+
 #endif
-      const double newLambda = pcSlice->getLambdas()[0] * pow (2.0, double (adaptedQP - iQPIndex) / 3.0);
-      pcPic->m_uEnerHpCtu[ctuRsAddr] = newLambda; // for ALF and SAO
-#if !ENABLE_QPA_SUB_CTU
-#if RDOQ_CHROMA_LAMBDA
-      pTrQuant->getLambdas (oldLambdaArray); // save the old lambdas
-      const double lambdaArray[MAX_NUM_COMPONENT] = {newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Y),
-                                                     newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cb),
-                                                     newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cr)};
-      pTrQuant->setLambdas (lambdaArray);
-#else
-      pTrQuant->setLambda (newLambda);
+/** analyse a single CTU of the slice, ctuIdx is the CTU index within the slice
+ */
+void EncSlice::xEncodeCtu( Picture* pcPic, EncLib* pEncLib, const uint32_t ctuIdx, int ( &prevQP )[2], int ( &currQP )[2] PARL_PARAM( const int dataId ) )
+{
+  CodingStructure&  cs            = *pcPic->cs;
+  Slice* pcSlice                  = cs.slice;
+  const PreCalcValues& pcv        = *cs.pcv;
+  const uint32_t        widthInCtus   = pcv.widthInCtus;
+#if ENABLE_QPA
+  const int iQPIndex              = pcSlice->getSliceQpBase();
 #endif
-      pRdCost->setLambda (newLambda, pcSlice->getSPS()->getBitDepths());
+
+  CABACWriter*    pCABACWriter    = pEncLib->getCABACEncoder( PARL_PARAM0( dataId ) )->getCABACEstimator( pcSlice->getSPS() );
+  TrQuant*        pTrQuant        = pEncLib->getTrQuant( PARL_PARAM0( dataId ) );
+  RdCost*         pRdCost         = pEncLib->getRdCost( PARL_PARAM0( dataId ) );
+  EncCu*          pCuEncoder      = pEncLib->getCuEncoder( PARL_PARAM0( dataId ) );
+  EncCfg*         pCfg            = pEncLib;
+  RateCtrl*       pRateCtrl       = pEncLib->getRateCtrl();
+#if ENABLE_WPP_PARALLELISM
+  // results have to match the CTU-line parallel encoding, so the state carried from CTU to CTU restarts with every line
+  const bool      wppLineReset    = pCfg->getEnsureWppBitEqual() || pCfg->getNumWppThreads() > 1;
 #endif
-      currQP[0] = currQP[1] = adaptedQP;
+
+  const int32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+
+  // update CABAC state
+  const uint32_t ctuXPosInCtus        = ctuRsAddr % widthInCtus;
+  const uint32_t ctuYPosInCtus        = ctuRsAddr / widthInCtus;
+
+  const Position pos (ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight);
+  const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+  DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppTiles )
+  {
+    if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) )
+    {
+      pCuEncoder->resetWppMotionLut();
     }
+  }
+  else if( !m_wppCtuLines )
 #endif
+  if( pCfg->getSwitchPOC() != pcPic->poc || -1 == pCfg->getDebugCTU() )
+  if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && cs.pps->ctuIsTileColBd( ctuXPosInCtus ))
+  {
+    cs.motionLut.lut.resize(0);
+    cs.motionLut.lutIbc.resize(0);
+  }
 
-    bool updateBcwCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuIdx == 0;
-    if( updateBcwCodingOrder )
+  const SubPic &curSubPic = pcSlice->getPPS()->getSubPicFromPos(pos);
+  // padding/restore at slice level
+#if ENABLE_WPP_PARALLELISM
+  if( !m_wppTiles )
+#endif
+  if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == 0)
+  {
+    xPadSubPicRefs( pcSlice, curSubPic );
+  }
+  if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && cs.pps->ctuIsTileRowBd( ctuYPosInCtus ))
+  {
+    pCABACWriter->initCtxModels( *pcSlice );
+#if ENABLE_WPP_PARALLELISM
+    if( wppLineReset )
     {
-      resetBcwCodingOrder(false, cs);
-      m_pcInterSearch->initWeightIdxBits();
+      pCuEncoder->initCtuLine( *pcSlice );
     }
-    if (pcSlice->getSPS()->getUseLmcs())
+    if( !m_wppCtuLines && !m_wppTiles )
+#endif
+    cs.resetPrevPLT(cs.prevPLT);
+    prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+  }
+  else if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag())
+  {
+    // reset and then update contexts to the state at the end of the top CTU (if within current slice and tile).
+    pCABACWriter->initCtxModels( *pcSlice );
+#if ENABLE_WPP_PARALLELISM
+    if( wppLineReset )
     {
-      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
-
-#if ENABLE_SPLIT_PARALLELISM
-      for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
+      pCuEncoder->initCtuLine( *pcSlice );
+    }
+    if( m_wppCtuLines )
+    {
+      if( cs.getCURestricted( pos.offset( 0, -1 ), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
       {
-        m_pcLib->getCuEncoder(jId)->setDecCuReshaperInEncCU(m_pcLib->getReshaper(jId), pcSlice->getSPS()->getChromaFormatIdc());
+        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus - 1];
       }
-#endif
     }
-    if( !cs.slice->isIntra() && pCfg->getMCTSEncConstraint() )
+    else
     {
-      pcPic->mctsInfo.init( &cs, ctuRsAddr );
+#endif
+    cs.resetPrevPLT(cs.prevPLT);
+    if( cs.getCURestricted( pos.offset(0, -1), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
+    {
+      // Top is available, we use it.
+      pCABACWriter->getCtx() = m_ctuSyncContextState;
+      cs.setPrevPLT(m_ctuPaletteSyncState);
+    }
+#if ENABLE_WPP_PARALLELISM
     }
-
-  if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
-    m_pcCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
-
-#if K0149_BLOCK_STATISTICS
-    getAndStoreBlockStatistics(cs, ctuArea);
 #endif
+    prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+  }
 
-    pCABACWriter->resetBits();
-    pCABACWriter->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
-    const int numberOfWrittenBits = int( pCABACWriter->getEstFracBits() >> SCALE_BITS );
 
-#if ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
-#endif
-    pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
-#if ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
+#if RDOQ_CHROMA_LAMBDA && ENABLE_QPA && !ENABLE_QPA_SUB_CTU
+  double oldLambdaArray[MAX_NUM_COMPONENT] = {0.0};
 #endif
+  const double oldLambda = pRdCost->getLambda();
+  if ( pCfg->getUseRateCtrl() )
+  {
+    int estQP        = pcSlice->getSliceQp();
+    double estLambda = -1.0;
+    double bpp       = -1.0;
 
-    // Store probabilities of first CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
-    if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag() )
+    if( ( pcPic->slices[0]->isIRAP() && pCfg->getForceIntraQP() ) || !pCfg->getLCULevelRC() )
     {
-      pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
-      cs.storePrevPLT(pEncLib->m_palettePredictorSyncState);
+      estQP = pcSlice->getSliceQp();
     }
-
-    int actualBits = int(cs.fracBits >> SCALE_BITS);
-    actualBits    -= (int)m_uiPicTotalBits;
-    if ( pCfg->getUseRateCtrl() )
+    else
     {
-      int actualQP        = g_RCInvalidQPValue;
-      double actualLambda = pRdCost->getLambda();
-      int numberOfEffectivePixels    = 0;
-
-      int numberOfSkipPixel = 0;
-      for (auto &cu : cs.traverseCUs(ctuArea, CH_L))
-      {
-        numberOfSkipPixel += cu.skip*cu.lumaSize().area();
-      }
-
-      for( auto &cu : cs.traverseCUs( ctuArea, CH_L ) )
-      {
-        if( !cu.skip || cu.rootCbf )
-        {
-          numberOfEffectivePixels += cu.lumaSize().area();
-          break;
-        }
-      }
-      double skipRatio = (double)numberOfSkipPixel / ctuArea.lumaSize().area();
-      CodingUnit* cu = cs.getCU( ctuArea.lumaPos(), CH_L );
-
-      if ( numberOfEffectivePixels == 0 )
+      bpp = pRateCtrl->getRCPic()->getLCUTargetBpp(pcSlice->isIRAP());
+      if ( pcPic->slices[0]->isIntra())
       {
-        actualQP = g_RCInvalidQPValue;
+        estLambda = pRateCtrl->getRCPic()->getLCUEstLambdaAndQP(bpp, pcSlice->getSliceQp(), &estQP);
       }
       else
       {
-        actualQP = cu->qp;
+        estLambda = pRateCtrl->getRCPic()->getLCUEstLambda( bpp );
+        estQP     = pRateCtrl->getRCPic()->getLCUEstQP    ( estLambda, pcSlice->getSliceQp() );
       }
-      pRdCost->setLambda(oldLambda, pcSlice->getSPS()->getBitDepths());
-      int estQP        = pcSlice->getSliceQp();
+
+      estQP     = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, estQP );
+
+      pRdCost->setLambda(estLambda, pcSlice->getSPS()->getBitDepths());
+#if WCG_EXT
+      pRdCost->saveUnadjustedLambda();
+#endif
       for (uint32_t compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
       {
         const ComponentID compID = ComponentID(compIdx);
@@ -1766,53 +1897,212 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
         }
         m_pcRdCost->setDistortionWeight(compID, tmpWeight);
       }
-      pRateCtrl->getRCPic()->updateAfterCTU(pRateCtrl->getRCPic()->getLCUCoded(), actualBits, actualQP, actualLambda, skipRatio,
-        pcSlice->isIRAP() ? 0 : pCfg->getLCULevelRC());
+#if RDOQ_CHROMA_LAMBDA
+      const double lambdaArray[MAX_NUM_COMPONENT] = {estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Y),
+                                                     estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cb),
+                                                     estLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cr)};
+      pTrQuant->setLambdas( lambdaArray );
+#else
+      pTrQuant->setLambda( estLambda );
+#endif
     }
-#if ENABLE_QPA && !ENABLE_QPA_SUB_CTU
-    else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
-    {
+
+    pRateCtrl->setRCQP( estQP );
+  }
+#if ENABLE_QPA
+  else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
+  {
+#if ENABLE_QPA_SUB_CTU
+    const int adaptedQP    = applyQPAdaptationSubCtu (cs, ctuArea, ctuRsAddr, m_pcCfg->getLumaLevelToDeltaQPMapping().mode == LUMALVL_TO_DQP_NUM_MODES);
+#else
+    const int adaptedQP    = pcPic->m_iOffsetCtu[ctuRsAddr];
+#endif
+    const double newLambda = pcSlice->getLambdas()[0] * pow (2.0, double (adaptedQP - iQPIndex) / 3.0);
+    pcPic->m_uEnerHpCtu[ctuRsAddr] = newLambda; // for ALF and SAO
+#if !ENABLE_QPA_SUB_CTU
 #if RDOQ_CHROMA_LAMBDA
-      pTrQuant->setLambdas (oldLambdaArray);
+    pTrQuant->getLambdas (oldLambdaArray); // save the old lambdas
+    const double lambdaArray[MAX_NUM_COMPONENT] = {newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Y),
+                                                   newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cb),
+                                                   newLambda / m_pcRdCost->getDistortionWeight (COMPONENT_Cr)};
+    pTrQuant->setLambdas (lambdaArray);
 #else
-      pTrQuant->setLambda (oldLambda);
+    pTrQuant->setLambda (newLambda);
+#endif
+    pRdCost->setLambda (newLambda, pcSlice->getSPS()->getBitDepths());
+#endif
+    currQP[0] = currQP[1] = adaptedQP;
+  }
+#endif
+
+  if( !cs.slice->isIntra() && pCfg->getMCTSEncConstraint() )
+  {
+    pcPic->mctsInfo.init( &cs, ctuRsAddr );
+  }
+
+if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
+  pCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+
+#if K0149_BLOCK_STATISTICS
+  getAndStoreBlockStatistics(cs, ctuArea);
+#endif
+
+  pCABACWriter->resetBits();
+  pCABACWriter->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
+  const int numberOfWrittenBits = int( pCABACWriter->getEstFracBits() >> SCALE_BITS );
+
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+#pragma omp critical
 #endif
-      pRdCost->setLambda (oldLambda, pcSlice->getSPS()->getBitDepths());
+  pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
+
+  // Store probabilities of first CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
+  if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag() )
+  {
+#if ENABLE_WPP_PARALLELISM
+    if( m_wppCtuLines )
+    {
+      pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus] = pCABACWriter->getCtx();
+    }
+    else
+    {
+#endif
+    m_ctuSyncContextState = pCABACWriter->getCtx();
+    cs.storePrevPLT(m_ctuPaletteSyncState);
+#if ENABLE_WPP_PARALLELISM
     }
 #endif
+  }
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppCtuLines || m_wppTiles )
+  {
+    return;
+  }
+#endif
+
+  int actualBits = int(cs.fracBits >> SCALE_BITS);
+  actualBits    -= (int)m_uiPicTotalBits;
+  if ( pCfg->getUseRateCtrl() )
+  {
+    int actualQP        = g_RCInvalidQPValue;
+    double actualLambda = pRdCost->getLambda();
+    int numberOfEffectivePixels    = 0;
 
-    m_uiPicTotalBits += actualBits;
-    m_uiPicDist       = cs.dist;
-    // for last Ctu in the slice
-    if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (pcSlice->getNumCtuInSlice() - 1))
+    int numberOfSkipPixel = 0;
+    for (auto &cu : cs.traverseCUs(ctuArea, CH_L))
     {
+      numberOfSkipPixel += cu.skip*cu.lumaSize().area();
+    }
 
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+    for( auto &cu : cs.traverseCUs( ctuArea, CH_L ) )
+    {
+      if( !cu.skip || cu.rootCbf )
+      {
+        numberOfEffectivePixels += cu.lumaSize().area();
+        break;
+      }
+    }
+    double skipRatio = (double)numberOfSkipPixel / ctuArea.lumaSize().area();
+    CodingUnit* cu = cs.getCU( ctuArea.lumaPos(), CH_L );
 
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+    if ( numberOfEffectivePixels == 0 )
+    {
+      actualQP = g_RCInvalidQPValue;
+    }
+    else
+    {
+      actualQP = cu->qp;
+    }
+    pRdCost->setLambda(oldLambda, pcSlice->getSPS()->getBitDepths());
+    int estQP        = pcSlice->getSliceQp();
+    for (uint32_t compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
+    {
+      const ComponentID compID = ComponentID(compIdx);
+      int chromaQPOffset = pcSlice->getPPS()->getQpOffset(compID) + pcSlice->getSliceChromaQpDelta(compID);
+      int qpc = pcSlice->getSPS()->getMappedChromaQpValue(compID, estQP) + chromaQPOffset;
+      double tmpWeight = pow(2.0, (estQP - qpc) / 3.0);  // takes into account of the chroma qp mapping and chroma qp Offset
+      if (m_pcCfg->getDepQuantEnabledFlag())
       {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
-        {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
-          if (refPic->getSubPicSaved())
-          {
-            refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(false);
-          }
-        }
+        tmpWeight *= (m_pcCfg->getGOPSize() >= 8 ? pow(2.0, 0.1 / 3.0) : pow(2.0, 0.2 / 3.0));  // increase chroma weight for dependent quantization (in order to reduce bit rate shift from chroma to luma)
       }
+      m_pcRdCost->setDistortionWeight(compID, tmpWeight);
     }
+    pRateCtrl->getRCPic()->updateAfterCTU(pRateCtrl->getRCPic()->getLCUCoded(), actualBits, actualQP, actualLambda, skipRatio,
+      pcSlice->isIRAP() ? 0 : pCfg->getLCULevelRC());
   }
+#if ENABLE_QPA && !ENABLE_QPA_SUB_CTU
+  else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
+  {
+#if RDOQ_CHROMA_LAMBDA
+    pTrQuant->setLambdas (oldLambdaArray);
+#else
+    pTrQuant->setLambda (oldLambda);
+#endif
+    pRdCost->setLambda (oldLambda, pcSlice->getSPS()->getBitDepths());
+  }
+#endif
 
-  // this is wpp exclusive section
+  m_uiPicTotalBits += actualBits;
+  m_uiPicDist       = cs.dist;
+  // for last Ctu in the slice
+  if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (pcSlice->getNumCtuInSlice() - 1))
+  {
+    xRestoreSubPicRefs( pcSlice, curSubPic );
+  }
+}
 
-//  m_uiPicTotalBits += actualBits;
-//  m_uiPicDist       = cs.dist;
+/** extend the borders of the reference pictures to the sub-picture of the slice, sub-pictures treated as pictures are predicted from padded references
+ */
+void EncSlice::xPadSubPicRefs( const Slice* pcSlice, const SubPic& curSubPic )
+{
+  int subPicX = (int)curSubPic.getSubPicLeft();
+  int subPicY = (int)curSubPic.getSubPicTop();
+  int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+  int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
 
+#if JVET_S0258_SUBPIC_CONSTRAINTS
+      if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+#else
+      if (!refPic->getSubPicSaved() && refPic->numSubpics > 1)
+#endif
+      {
+        refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(true);
+      }
+    }
+  }
+}
+
+/** undo xPadSubPicRefs once the slice is compressed
+ */
+void EncSlice::xRestoreSubPicRefs( const Slice* pcSlice, const SubPic& curSubPic )
+{
+  int subPicX = (int)curSubPic.getSubPicLeft();
+  int subPicY = (int)curSubPic.getSubPicTop();
+  int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+  int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+      if (refPic->getSubPicSaved())
+      {
+        refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(false);
+      }
+    }
+  }
 }
 
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
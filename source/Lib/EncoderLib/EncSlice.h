@@ -93,9 +93,18 @@ private:
   Ctx                     m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   SliceType               m_encCABACTableIdx;
   PLTBuf                  m_palettePredictorSyncState;
+  Ctx                     m_ctuSyncContextState;                ///< context state at the entropy-coding-sync CTU while the slice is compressed
+  PLTBuf                  m_ctuPaletteSyncState;                ///< palette predictor at the entropy-coding-sync CTU while the slice is compressed
 #if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
   int                     m_gopID;
 #endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  int                     m_dataId;                             ///< CU encoder stack the slices are compressed on
+#endif
+#if ENABLE_WPP_PARALLELISM
+  bool                    m_wppCtuLines;                        ///< the CTU lines of the current slice are encoded in parallel
+  bool                    m_wppTiles;                           ///< the tiles of the current slice are encoded in parallel
+#endif
 
 public:
   double  initializeLambda(const Slice* slice, const int GOPid, const int refQP, const double dQP); // called by calculateLambda() and updateLambda()
@@ -114,7 +123,10 @@ public:
 
   void    create              ( int iWidth, int iHeight, ChromaFormat chromaFormat, uint32_t iMaxCUWidth, uint32_t iMaxCUHeight, uint8_t uhTotalDepth );
   void    destroy             ();
-  void    init                ( EncLib* pcEncLib, const SPS& sps );
+  void    init                ( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int dataId = 0 ) );
+#if ENABLE_WPP_PARALLELISM
+  void    copyState           ( const EncSlice& other, Picture* pcPic );
+#endif
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   void    initEncSlice        ( Picture*  pcPic, const int pocLast, const int pocCurr,
@@ -144,6 +156,12 @@ public:
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+  void    xEncodeCtu          ( Picture* pcPic, EncLib* pEncLib, const uint32_t ctuIdx, int ( &prevQP )[2], int ( &currQP )[2] PARL_PARAM( const int dataId ) );
+#if ENABLE_WPP_PARALLELISM
+  void    xInitWppCtuEncoder  ( Picture* pcPic, EncLib* pEncLib, const int dataId, const bool bFastDeltaQP );
+#endif
+  void    xPadSubPicRefs      ( const Slice* pcSlice, const SubPic& curSubPic );
+  void    xRestoreSubPicRefs  ( const Slice* pcSlice, const SubPic& curSubPic );
 };
 
 //! \}
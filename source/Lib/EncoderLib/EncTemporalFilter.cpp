@@ -84,7 +84,8 @@ EncTemporalFilter::EncTemporalFilter() :
   m_sourceHeight(0),
   m_QP(0),
   m_clipInputVideoToRec709Range(false),
-  m_inputColourSpaceConvert(NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS)
+  m_inputColourSpaceConvert(NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS),
+  m_numThreads(1)
 {}
 
 void EncTemporalFilter::init(const int frameSkip,
@@ -100,7 +101,8 @@ void EncTemporalFilter::init(const int frameSkip,
   const InputColourSpaceConversion colorSpaceConv,
   const int qp,
   const std::map<int, double> &temporalFilterStrengths,
-  const bool gopBasedTemporalFilterFutureReference)
+  const bool gopBasedTemporalFilterFutureReference,
+  const int numThreads)
 {
   m_FrameSkip = frameSkip;
   for (int i = 0; i < MAX_NUM_CHANNEL_TYPE; i++)
@@ -124,6 +126,7 @@ void EncTemporalFilter::init(const int frameSkip,
   m_QP = qp;
   m_temporalFilterStrengths = temporalFilterStrengths;
   m_gopBasedTemporalFilterFutureReference = gopBasedTemporalFilterFutureReference;
+  m_numThreads = numThreads;
 }
 
 // ====================================================================================================================
@@ -279,104 +282,41 @@ int EncTemporalFilter::motionErrorLuma(const PelStorage &orig,
   const Pel *buffOrigin = buffer.Y().buf;
   const int buffStride  = buffer.Y().stride;
 
-  int error = 0;// dx * 10 + dy * 10;
   if (((dx | dy) & 0xF) == 0)
   {
     dx /= m_motionVectorFactor;
     dy /= m_motionVectorFactor;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel* origRowStart = origOrigin + (y+y1)*origStride + x;
-      const Pel* bufferRowStart = buffOrigin + (y+y1+dy)*buffStride + (x+dx);
-      for (int x1 = 0; x1 < bs; x1 += 2)
-      {
-        int diff = origRowStart[x1] - bufferRowStart[x1];
-        error += diff * diff;
-        diff = origRowStart[x1 + 1] - bufferRowStart[x1 + 1];
-        error += diff * diff;
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
+    return m_filterOps.m_motionErrorInt(origOrigin + y * origStride + x, origStride, buffOrigin + (y + dy) * buffStride + (x + dx), buffStride, bs, besterror);
   }
-  else
-  {
-    const int *xFilter = m_interpolationFilter[dx & 0xF];
-    const int *yFilter = m_interpolationFilter[dy & 0xF];
-    int tempArray[64 + 8][64];
 
-    int sum, base;
-    for (int y1 = 1; y1 < bs + 7; y1++)
-    {
-      const int yOffset = y + y1 + (dy >> 4) - 3;
-      const Pel *sourceRow = buffOrigin + (yOffset)*buffStride + 0;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        base = x + x1 + (dx >> 4) - 3;
-        const Pel *rowStart = sourceRow + base;
-
-        sum += xFilter[1] * rowStart[1];
-        sum += xFilter[2] * rowStart[2];
-        sum += xFilter[3] * rowStart[3];
-        sum += xFilter[4] * rowStart[4];
-        sum += xFilter[5] * rowStart[5];
-        sum += xFilter[6] * rowStart[6];
-
-        tempArray[y1][x1] = sum;
-      }
-    }
+  const int *xFilter = m_interpolationFilter[dx & 0xF];
+  const int *yFilter = m_interpolationFilter[dy & 0xF];
+  const Pel maxSampleValue = (1<<m_internalBitDepth[CHANNEL_TYPE_LUMA])-1;
 
-    const Pel maxSampleValue = (1<<m_internalBitDepth[CHANNEL_TYPE_LUMA])-1;
-    for (int y1 = 0; y1 < bs; y1++)
-    {
-      const Pel *origRow = origOrigin + (y+y1)*origStride + 0;
-      for (int x1 = 0; x1 < bs; x1++)
-      {
-        sum = 0;
-        sum += yFilter[1] * tempArray[y1 + 1][x1];
-        sum += yFilter[2] * tempArray[y1 + 2][x1];
-        sum += yFilter[3] * tempArray[y1 + 3][x1];
-        sum += yFilter[4] * tempArray[y1 + 4][x1];
-        sum += yFilter[5] * tempArray[y1 + 5][x1];
-        sum += yFilter[6] * tempArray[y1 + 6][x1];
-
-        sum = (sum + (1 << 11)) >> 12;
-        sum = sum < 0 ? 0 : (sum > maxSampleValue ? maxSampleValue : sum);
-
-        error += (sum - origRow[x + x1]) * (sum - origRow[x + x1]);
-      }
-      if (error > besterror)
-      {
-        return error;
-      }
-    }
-  }
-  return error;
+  return m_filterOps.m_motionErrorFrac(origOrigin + y * origStride + x, origStride, buffOrigin + (y + (dy >> 4) - 3) * buffStride + (x + (dx >> 4) - 3), buffStride, bs,
+                                       xFilter, yFilter, maxSampleValue, besterror);
 }
 
 void EncTemporalFilter::motionEstimationLuma(Array2D<MotionVector> &mvs, const PelStorage &orig, const PelStorage &buffer, const int blockSize,
   const Array2D<MotionVector> *previous, const int factor, const bool doubleRes) const
 {
-  int range = 5;
+  const int range = previous == NULL ? 8 : 5;
   const int stepSize = blockSize;
 
   const int origWidth  = orig.Y().width;
   const int origHeight = orig.Y().height;
 
-  for (int blockY = 0; blockY + blockSize < origHeight; blockY += stepSize)
+  // the blocks only depend on the previous stage, so the block rows are searched concurrently
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for (int blockY = 0; blockY < origHeight - blockSize; blockY += stepSize)
   {
     for (int blockX = 0; blockX + blockSize < origWidth; blockX += stepSize)
     {
       MotionVector best;
 
-      if (previous == NULL)
-      {
-        range = 8;
-      }
-      else
+      if (previous != NULL)
       {
         for (int py = -2; py <= 2; py++)
         {
@@ -489,8 +429,12 @@ void EncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const PelS
     Pel *dstImage = output.bufs[c].buf;
     int dstStride  = output.bufs[c].stride;
 
-    for (int y = 0, blockNumY = 0; y + blockSizeY <= height; y += blockSizeY, blockNumY++)
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+    for (int blockNumY = 0; blockNumY < height / blockSizeY; blockNumY++)
     {
+      const int y = blockNumY * blockSizeY;
       for (int x = 0, blockNumX = 0; x + blockSizeX <= width; x += blockSizeX, blockNumX++)
       {
         const MotionVector &mv = mvs.get(blockNumX,blockNumY);
@@ -501,52 +445,10 @@ void EncTemporalFilter::applyMotion(const Array2D<MotionVector> &mvs, const PelS
 
         const int *xFilter = m_interpolationFilter[dx & 0xf];
         const int *yFilter = m_interpolationFilter[dy & 0xf]; // will add 6 bit.
-        const int numFilterTaps=7;
         const int centreTapOffset=3;
 
-        int tempArray[lumaBlockSize + numFilterTaps][lumaBlockSize];
-
-        for (int by = 1; by < blockSizeY + numFilterTaps; by++)
-        {
-          const int yOffset = y + by + yInt - centreTapOffset;
-          const Pel *sourceRow = srcImage+yOffset*srcStride;
-          for (int bx = 0; bx < blockSizeX; bx++)
-          {
-            int base = x + bx + xInt - centreTapOffset;
-            const Pel *rowStart = sourceRow + base;
-
-            int sum = 0;
-            sum += xFilter[1] * rowStart[1];
-            sum += xFilter[2] * rowStart[2];
-            sum += xFilter[3] * rowStart[3];
-            sum += xFilter[4] * rowStart[4];
-            sum += xFilter[5] * rowStart[5];
-            sum += xFilter[6] * rowStart[6];
-
-            tempArray[by][bx] = sum;
-          }
-        }
-
-        Pel *dstRow = dstImage+y*dstStride;
-        for (int by = 0; by < blockSizeY; by++, dstRow+=dstStride)
-        {
-          Pel *dstPel=dstRow+x;
-          for (int bx = 0; bx < blockSizeX; bx++, dstPel++)
-          {
-            int sum = 0;
-
-            sum += yFilter[1] * tempArray[by + 1][bx];
-            sum += yFilter[2] * tempArray[by + 2][bx];
-            sum += yFilter[3] * tempArray[by + 3][bx];
-            sum += yFilter[4] * tempArray[by + 4][bx];
-            sum += yFilter[5] * tempArray[by + 5][bx];
-            sum += yFilter[6] * tempArray[by + 6][bx];
-
-            sum = (sum + (1 << 11)) >> 12;
-            sum = sum < 0 ? 0 : (sum > maxValue ? maxValue : sum);
-            *dstPel = sum;
-          }
-        }
+        m_filterOps.m_applyMotion(srcImage + (y + yInt - centreTapOffset) * srcStride + (x + xInt - centreTapOffset), srcStride,
+                                  dstImage + y * dstStride + x, dstStride, blockSizeX, blockSizeY, xFilter, yFilter, maxValue);
       }
     }
   }
@@ -592,32 +494,34 @@ void EncTemporalFilter::bilateralFilter(const PelStorage &orgPic,
     const Pel maxSampleValue = (1<<m_internalBitDepth[toChannelType(compID)])-1;
     const double bitDepthDiffWeighting=1024.0 / (maxSampleValue+1);
 
-    for (int y = 0; y < height; y++, srcPelRow+=srcStride, dstPelRow+=dstStride)
+    // the weights only depend on the sample difference, so exp() is evaluated once per difference value
+    std::vector<double> expLut(2 * maxSampleValue + 1);
+    for (int d = -maxSampleValue; d <= maxSampleValue; d++)
     {
-      const Pel *srcPel=srcPelRow;
-      Pel *dstPel=dstPelRow;
-      for (int x = 0; x < width; x++, srcPel++, dstPel++)
+      double diff = (double)d;
+      diff *= bitDepthDiffWeighting;
+      double diffSq = diff * diff;
+      expLut[d + maxSampleValue] = exp(-diffSq / (2 * sigmaSq));
+    }
+    std::vector<double> refWeights(numRefs);
+    for (int i = 0; i < numRefs; i++)
+    {
+      const int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
+      refWeights[i] = weightScaling * m_refStrengths[refStrengthRow][index];
+    }
+
+#if defined( _OPENMP )
+#pragma omp parallel for schedule(dynamic,1) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+    for (int y = 0; y < height; y++)
+    {
+      std::vector<const Pel*> correctedRows(numRefs);
+      for (int i = 0; i < numRefs; i++)
       {
-        const int orgVal = (int) *srcPel;
-        double temporalWeightSum = 1.0;
-        double newVal = (double) orgVal;
-        for (int i = 0; i < numRefs; i++)
-        {
-          const Pel *pCorrectedPelPtr=correctedPics[i].bufs[c].buf+(y*correctedPics[i].bufs[c].stride+x);
-          const int refVal = (int) *pCorrectedPelPtr;
-          double diff = (double)(refVal - orgVal);
-          diff *= bitDepthDiffWeighting;
-          double diffSq = diff * diff;
-          const int index = std::min(1, std::abs(srcFrameInfo[i].origOffset) - 1);
-          const double weight = weightScaling * m_refStrengths[refStrengthRow][index] * exp(-diffSq / (2 * sigmaSq));
-          newVal += weight * refVal;
-          temporalWeightSum += weight;
-        }
-        newVal /= temporalWeightSum;
-        Pel sampleVal = (Pel)round(newVal);
-        sampleVal=(sampleVal<0?0 : (sampleVal>maxSampleValue ? maxSampleValue : sampleVal));
-        *dstPel = sampleVal;
+        correctedRows[i] = correctedPics[i].bufs[c].buf + y * correctedPics[i].bufs[c].stride;
       }
+      m_filterOps.m_bilateralFilterRow(srcPelRow + y * srcStride, dstPelRow + y * dstStride, width, correctedRows.data(), numRefs,
+                                       refWeights.data(), expLut.data() + maxSampleValue, maxSampleValue);
     }
   }
 }
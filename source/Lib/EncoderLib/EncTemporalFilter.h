@@ -39,6 +39,7 @@
 #define __TEMPORAL_FILTER__
 #include "EncLib.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/TemporalFilterOps.h"
 #include <sstream>
 #include <map>
 #include <deque>
@@ -116,7 +117,8 @@ public:
     const InputColourSpaceConversion colorSpaceConv,
     const int qp,
     const std::map<int, double> &temporalFilterStrengths,
-    const bool gopBasedTemporalFilterFutureReference);
+    const bool gopBasedTemporalFilterFutureReference,
+    const int numThreads = 1);
 
   bool filter(PelStorage *orgPic, int frame);
 
@@ -147,6 +149,8 @@ private:
   InputColourSpaceConversion m_inputColourSpaceConvert;
   Area m_area;
   bool m_gopBasedTemporalFilterFutureReference;
+  int m_numThreads;                 ///< threads sharing the block rows of motion estimation, motion compensation and filtering
+  TemporalFilterOps m_filterOps;
 
   // Private functions
   void subsampleLuma(const PelStorage &input, PelStorage &output, const int factor = 2) const;
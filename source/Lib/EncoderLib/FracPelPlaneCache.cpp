@@ -0,0 +1,283 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     FracPelPlaneCache.cpp
+    \brief    cache of fractional-sample reference planes for motion estimation
+*/
+
+#include "FracPelPlaneCache.h"
+
+#include "CommonLib/Picture.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+// The planes replicate the two-stage filtering of InterSearch::xExtDIFUpSamplingH/Q (horizontal pass to the
+// intermediate precision, vertical pass with clipping), so a cached phase is bit-exact to the per-PU patch.
+// With the alternative half-pel filter (AMVR half-pel mode) only the half-pel refinement runs, hence only the
+// three half-sample phases are kept for such planes.
+
+static const int NUM_QPEL_PHASES = 4;
+
+static inline bool isPhaseUsed( const int fracY, const int fracX, const bool useAltHpelIf )
+{
+  if( fracY == 0 && fracX == 0 )
+  {
+    return false;
+  }
+  return !useAltHpelIf || ( ( fracY & 1 ) == 0 && ( fracX & 1 ) == 0 );
+}
+
+FracPelPlanes::FracPelPlanes( const Picture* pic, const CPelBuf& refBuf, const int margin, const int tileSize, const int numTaps, const bool useAltHpelIf )
+  : m_pic         ( pic )
+  , m_refBuf      ( refBuf )
+  , m_margin      ( margin )
+  , m_tileSize    ( tileSize )
+  , m_numTaps     ( numTaps )
+  , m_useAltHpelIf( useAltHpelIf )
+{
+  m_minPos  = ( NTAPS_LUMA >> 1 ) - 1 - margin;
+  m_maxPosX = int( refBuf.width  ) + margin - ( NTAPS_LUMA >> 1 ) - 1;
+  m_maxPosY = int( refBuf.height ) + margin - ( NTAPS_LUMA >> 1 ) - 1;
+
+  m_numTilesX = ( m_maxPosX - m_minPos + tileSize ) / tileSize;
+  m_numTilesY = ( m_maxPosY - m_minPos + tileSize ) / tileSize;
+  m_tileReady.assign( m_numTilesX * m_numTilesY, false );
+
+  const size_t planeSize = size_t( refBuf.stride ) * ( refBuf.height + 2 * margin );
+  for( int fracY = 0; fracY < NUM_QPEL_PHASES; fracY++ )
+  {
+    for( int fracX = 0; fracX < NUM_QPEL_PHASES; fracX++ )
+    {
+      m_planeOrigin[fracY][fracX] = nullptr;
+      m_planes     [fracY][fracX] = nullptr;
+      if( isPhaseUsed( fracY, fracX, useAltHpelIf ) )
+      {
+        m_planeOrigin[fracY][fracX] = ( Pel* ) xMalloc( Pel, planeSize );
+        m_planes     [fracY][fracX] = m_planeOrigin[fracY][fracX] + margin * refBuf.stride + margin;
+      }
+    }
+  }
+  m_planes[0][0] = refBuf.buf;
+
+  m_tmpBuf     = ( Pel* ) xMalloc( Pel, NUM_QPEL_PHASES * ( tileSize + NTAPS_LUMA ) * tileSize );
+  m_memorySize = memorySize( refBuf, margin, tileSize, useAltHpelIf );
+  m_lastUse    = 0;
+}
+
+FracPelPlanes::~FracPelPlanes()
+{
+  for( int fracY = 0; fracY < NUM_QPEL_PHASES; fracY++ )
+  {
+    for( int fracX = 0; fracX < NUM_QPEL_PHASES; fracX++ )
+    {
+      if( m_planeOrigin[fracY][fracX] )
+      {
+        xFree( m_planeOrigin[fracY][fracX] );
+      }
+    }
+  }
+  xFree( m_tmpBuf );
+}
+
+size_t FracPelPlanes::memorySize( const CPelBuf& refBuf, const int margin, const int tileSize, const bool useAltHpelIf )
+{
+  const size_t numPlanes = useAltHpelIf ? 3 : NUM_QPEL_PHASES * NUM_QPEL_PHASES - 1;
+  return sizeof( Pel ) * ( numPlanes * refBuf.stride * ( refBuf.height + 2 * margin ) + NUM_QPEL_PHASES * ( tileSize + NTAPS_LUMA ) * tileSize );
+}
+
+bool FracPelPlanes::matches( const Picture* pic, const CPelBuf& refBuf, const int numTaps, const bool useAltHpelIf ) const
+{
+  return m_pic == pic && m_refBuf.buf == refBuf.buf && m_numTaps == numTaps && m_useAltHpelIf == useAltHpelIf;
+}
+
+/** make all phases available in the given area of the reference picture
+ * \returns false if the area reaches beyond the region covered by the padded reference
+ */
+bool FracPelPlanes::prepare( InterpolationFilter& interpFilter, const ClpRng& clpRng, const Area& area )
+{
+  if( area.x < m_minPos || area.y < m_minPos || int( area.x + area.width ) - 1 > m_maxPosX || int( area.y + area.height ) - 1 > m_maxPosY )
+  {
+    return false;
+  }
+
+  const int tileX0 = ( area.x - m_minPos ) / m_tileSize;
+  const int tileY0 = ( area.y - m_minPos ) / m_tileSize;
+  const int tileX1 = ( int( area.x + area.width  ) - 1 - m_minPos ) / m_tileSize;
+  const int tileY1 = ( int( area.y + area.height ) - 1 - m_minPos ) / m_tileSize;
+
+  for( int tileY = tileY0; tileY <= tileY1; tileY++ )
+  {
+    for( int tileX = tileX0; tileX <= tileX1; tileX++ )
+    {
+      if( !m_tileReady[tileY * m_numTilesX + tileX] )
+      {
+        xFillTile( interpFilter, clpRng, tileX, tileY );
+        m_tileReady[tileY * m_numTilesX + tileX] = true;
+      }
+    }
+  }
+  return true;
+}
+
+void FracPelPlanes::xFillTile( InterpolationFilter& interpFilter, const ClpRng& clpRng, const int tileX, const int tileY )
+{
+  const int halfFilterSize = NTAPS_LUMA >> 1;
+  const int refStride      = m_refBuf.stride;
+  const int tmpStride      = m_tileSize;
+
+  int       posX   = m_minPos + tileX * m_tileSize;
+  const int posY   = m_minPos + tileY * m_tileSize;
+  int       width  = std::min( m_tileSize, m_maxPosX + 1 - posX );
+  const int height = std::min( m_tileSize, m_maxPosY + 1 - posY );
+
+  // 4-sample wide blocks would select the 4x4 filter set, widen the last tile column instead
+  if( width < 8 )
+  {
+    posX -= 8 - width;
+    width = 8;
+  }
+
+  const Pel* srcPtr = m_refBuf.buf + ( posY - halfFilterSize + 1 ) * refStride + posX;
+  for( int fracX = 0; fracX < NUM_QPEL_PHASES; fracX++ )
+  {
+    if( m_useAltHpelIf && ( fracX & 1 ) )
+    {
+      continue;
+    }
+    Pel* tmpPtr = m_tmpBuf + fracX * ( m_tileSize + NTAPS_LUMA ) * tmpStride;
+    interpFilter.filterHor( COMPONENT_Y, srcPtr, refStride, tmpPtr, tmpStride, width, height + NTAPS_LUMA - 1, fracX << MV_FRACTIONAL_BITS_DIFF, false, CHROMA_420, clpRng, 0, false, m_useAltHpelIf, m_numTaps );
+  }
+
+  for( int fracY = 0; fracY < NUM_QPEL_PHASES; fracY++ )
+  {
+    for( int fracX = 0; fracX < NUM_QPEL_PHASES; fracX++ )
+    {
+      if( !isPhaseUsed( fracY, fracX, m_useAltHpelIf ) )
+      {
+        continue;
+      }
+      const Pel* tmpPtr = m_tmpBuf + fracX * ( m_tileSize + NTAPS_LUMA ) * tmpStride + ( halfFilterSize - 1 ) * tmpStride;
+      Pel*       dstPtr = m_planeOrigin[fracY][fracX] + ( m_margin + posY ) * refStride + m_margin + posX;
+      interpFilter.filterVer( COMPONENT_Y, tmpPtr, tmpStride, dstPtr, refStride, width, height, fracY << MV_FRACTIONAL_BITS_DIFF, false, true, CHROMA_420, clpRng, 0, false, m_useAltHpelIf, m_numTaps );
+    }
+  }
+}
+
+FracPelPlaneCache::FracPelPlaneCache()
+  : m_maxMemorySize( 0 )
+  , m_memorySize   ( 0 )
+  , m_useCounter   ( 0 )
+{
+}
+
+FracPelPlaneCache::~FracPelPlaneCache()
+{
+  destroy();
+}
+
+void FracPelPlaneCache::init( const int sizeMB )
+{
+  destroy();
+  m_maxMemorySize = size_t( std::max( sizeMB, 0 ) ) << 20;
+}
+
+void FracPelPlaneCache::destroy()
+{
+  for( FracPelPlanes* entry : m_entries )
+  {
+    delete entry;
+  }
+  m_entries.clear();
+  m_memorySize = 0;
+}
+
+FracPelPlanes* FracPelPlaneCache::getPlanes( const Picture* pic, const CPelBuf& refBuf, const int margin, const int tileSize, const int numTaps, const bool useAltHpelIf )
+{
+  m_useCounter++;
+  for( FracPelPlanes* entry : m_entries )
+  {
+    if( entry->matches( pic, refBuf, numTaps, useAltHpelIf ) )
+    {
+      entry->setLastUse( m_useCounter );
+      return entry;
+    }
+  }
+
+  const size_t entrySize = FracPelPlanes::memorySize( refBuf, margin, tileSize, useAltHpelIf );
+  if( entrySize > m_maxMemorySize )
+  {
+    return nullptr;
+  }
+
+  while( m_memorySize + entrySize > m_maxMemorySize )
+  {
+    std::vector<FracPelPlanes*>::iterator lru = m_entries.begin();
+    for( std::vector<FracPelPlanes*>::iterator it = m_entries.begin(); it != m_entries.end(); it++ )
+    {
+      if( ( *it )->getLastUse() < ( *lru )->getLastUse() )
+      {
+        lru = it;
+      }
+    }
+    m_memorySize -= ( *lru )->getMemorySize();
+    delete *lru;
+    m_entries.erase( lru );
+  }
+
+  FracPelPlanes* entry = new FracPelPlanes( pic, refBuf, margin, tileSize, numTaps, useAltHpelIf );
+  entry->setLastUse( m_useCounter );
+  m_entries.push_back( entry );
+  m_memorySize += entry->getMemorySize();
+  return entry;
+}
+
+/// drop all planes of a picture buffer, to be called whenever the buffer is (re)assigned to a new picture
+void FracPelPlaneCache::invalidate( const Picture* pic )
+{
+  for( std::vector<FracPelPlanes*>::iterator it = m_entries.begin(); it != m_entries.end(); )
+  {
+    if( ( *it )->getPic() == pic )
+    {
+      m_memorySize -= ( *it )->getMemorySize();
+      delete *it;
+      it = m_entries.erase( it );
+    }
+    else
+    {
+      it++;
+    }
+  }
+}
+
+//! \}
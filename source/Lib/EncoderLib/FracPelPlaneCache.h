@@ -0,0 +1,121 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     FracPelPlaneCache.h
+    \brief    cache of fractional-sample reference planes for motion estimation (header)
+*/
+
+#ifndef __FRACPELPLANECACHE__
+#define __FRACPELPLANECACHE__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/InterpolationFilter.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+class Picture;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// quarter-sample phases of the luma reconstruction of one reference picture, filled per CTU-sized tile on demand
+class FracPelPlanes
+{
+public:
+  FracPelPlanes( const Picture* pic, const CPelBuf& refBuf, const int margin, const int tileSize, const int numTaps, const bool useAltHpelIf );
+  ~FracPelPlanes();
+
+  static size_t memorySize  ( const CPelBuf& refBuf, const int margin, const int tileSize, const bool useAltHpelIf );
+
+  bool        matches       ( const Picture* pic, const CPelBuf& refBuf, const int numTaps, const bool useAltHpelIf ) const;
+  bool        prepare       ( InterpolationFilter& interpFilter, const ClpRng& clpRng, const Area& area );
+
+  /// phase fracY/fracX (quarter samples) at the reference buffer origin, phase 0/0 is the reference itself
+  const Pel*  getBuf        ( const int fracY, const int fracX ) const { return m_planes[fracY][fracX]; }
+  int         getStride     ()                                   const { return m_refBuf.stride; }
+  size_t      getMemorySize ()                                   const { return m_memorySize; }
+  const Picture* getPic     ()                                   const { return m_pic; }
+  uint64_t    getLastUse    ()                                   const { return m_lastUse; }
+  void        setLastUse    ( const uint64_t lastUse )                 { m_lastUse = lastUse; }
+
+private:
+  void        xFillTile     ( InterpolationFilter& interpFilter, const ClpRng& clpRng, const int tileX, const int tileY );
+
+  const Picture*    m_pic;
+  CPelBuf           m_refBuf;
+  int               m_margin;
+  int               m_tileSize;
+  int               m_numTaps;
+  bool              m_useAltHpelIf;
+  int               m_numTilesX;
+  int               m_numTilesY;
+  int               m_minPos;     ///< first row/column whose filter support is inside the padded reference
+  int               m_maxPosX;
+  int               m_maxPosY;
+  std::vector<bool> m_tileReady;
+  Pel*              m_planeOrigin[4][4];
+  const Pel*        m_planes[4][4];
+  Pel*              m_tmpBuf;
+  size_t            m_memorySize;
+  uint64_t          m_lastUse;
+};
+
+/// per search instance cache of FracPelPlanes with a memory budget, least recently used planes are dropped first
+class FracPelPlaneCache
+{
+public:
+  FracPelPlaneCache();
+  ~FracPelPlaneCache();
+
+  void            init          ( const int sizeMB );
+  void            destroy       ();
+  bool            isEnabled     () const { return m_maxMemorySize > 0; }
+
+  FracPelPlanes*  getPlanes     ( const Picture* pic, const CPelBuf& refBuf, const int margin, const int tileSize, const int numTaps, const bool useAltHpelIf );
+  void            invalidate    ( const Picture* pic );
+
+private:
+  std::vector<FracPelPlanes*> m_entries;
+  size_t                      m_maxMemorySize;
+  size_t                      m_memorySize;
+  uint64_t                    m_useCounter;
+};
+
+//! \}
+
+#endif // __FRACPELPLANECACHE__
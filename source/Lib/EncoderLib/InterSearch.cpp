@@ -97,6 +97,9 @@ InterSearch::InterSearch()
   , m_motionEstimationSearchMethod(MESEARCH_FULL)
   , m_CABACEstimator              (nullptr)
   , m_CtxCache                    (nullptr)
+  , m_fracFilterNumTaps           (NTAPS_LUMA)
+  , m_fracPelPlanes               (nullptr)
+  , m_fracPelPlanesOffset         (0)
   , m_pTempPel                    (nullptr)
   , m_isInitialized               (false)
 {
@@ -116,6 +119,8 @@ InterSearch::InterSearch()
   m_uniMvList = nullptr;
   m_uniMvListSize = 0;
   m_uniMvListIdx = 0;
+  m_reusedUniMVs = nullptr;
+  m_isReusedUniMVsFilled = nullptr;
   m_histBestSbt    = MAX_UCHAR;
   m_histBestMtsIdx = MAX_UCHAR;
 
@@ -141,6 +146,7 @@ void InterSearch::destroy()
   }
   m_tmpStorageLCU.destroy();
   m_tmpAffiStorage.destroy();
+  m_fracPelPlaneCache.destroy();
 
   if ( m_tmpAffiError != NULL )
   {
@@ -168,6 +174,10 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  delete[] m_reusedUniMVs;
+  m_reusedUniMVs = nullptr;
+  delete[] m_isReusedUniMVsFilled;
+  m_isReusedUniMVsFilled = nullptr;
   m_isInitialized = false;
 }
 
@@ -178,7 +188,7 @@ void InterSearch::setTempBuffers( CodingStructure ****pSplitCS, CodingStructure
   m_pSaveCS  = pSaveCS;
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void InterSearch::copyState( const InterSearch& other )
 {
   memcpy( m_aaiAdaptSR, other.m_aaiAdaptSR, sizeof( m_aaiAdaptSR ) );
@@ -224,6 +234,13 @@ void InterSearch::init( EncCfg*        pcEncCfg,
   m_CtxCache                     = ctxCache;
   m_useCompositeRef              = useCompositeRef;
   m_pcReshape                    = pcReshape;
+  m_approxFilterPolicy.init( pcEncCfg->getApproxCfg() );
+  m_fracPelPlaneCache.init( pcEncCfg->getApproxCfg().fmePlaneCacheSizeMB );
+  if( !pcEncCfg->getApproxCfg().fmeFilterBankFile.empty() )
+  {
+    m_approxFilterBank.load( pcEncCfg->getApproxCfg().fmeFilterBankFile );
+  }
+  m_if.setApproxFilterBank( &m_approxFilterBank );
 
   for( uint32_t iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
   {
@@ -274,6 +291,12 @@ void InterSearch::init( EncCfg*        pcEncCfg,
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  if( !m_reusedUniMVs )
+  {
+    m_reusedUniMVs         = new Mv[32][32][8][8][2][33];
+    m_isReusedUniMVsFilled = new bool[32][32][8][8];
+  }
+  resetReusedUniMvs();
   m_isInitialized = true;
 }
 
@@ -334,7 +357,13 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
 
 //  CHECK(!( !( rcStruct.searchRange.left > iSearchX || rcStruct.searchRange.right < iSearchX || rcStruct.searchRange.top > iSearchY || rcStruct.searchRange.bottom < iSearchY )), "Unspecified error");
 
+  if( !xIsInSearchWindow( rcStruct, iSearchX, iSearchY ) )
+  {
+    return;
+  }
+
   const Pel* const  piRefSrch = rcStruct.piRefY + iSearchY * rcStruct.iRefStride + iSearchX;
+  xSearchWindowAccess( rcStruct, piRefSrch, rcStruct.pcPatternKey->width, rcStruct.pcPatternKey->height );
 
   m_cDistParam.cur.buf = piRefSrch;
 
@@ -714,8 +743,8 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   Distortion  uiDistBest  = std::numeric_limits<Distortion>::max();
   uint32_t        uiDirecBest = 0;
 
-  Pel*  piRefPos;
-  int iRefStride = pcPatternKey->width + 1;
+  const Pel* piRefPos;
+  int iRefStride = m_fracPelPlanes ? m_fracPelPlanes->getStride() : pcPatternKey->width + 1;
   m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
   const Mv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
@@ -730,15 +759,22 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
     int horVal = cMvTest.getHor() * iFrac;
     int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
-
-    if (horVal == 2 && (verVal & 1) == 0)
+    if (m_fracPelPlanes)
     {
-      piRefPos += 1;
+      piRefPos = m_fracPelPlanes->getBuf(verVal & 3, horVal & 3) + m_fracPelPlanesOffset + (verVal >> 2) * iRefStride + (horVal >> 2);
     }
-    if ((horVal & 1) == 0 && verVal == 2)
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
+
+      if (horVal == 2 && (verVal & 1) == 0)
+      {
+        piRefPos += 1;
+      }
+      if ((horVal & 1) == 0 && verVal == 2)
+      {
+        piRefPos += iRefStride;
+      }
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -1283,6 +1319,8 @@ void InterSearch::xIBCEstimation(PredictionUnit& pu, PelUnitBuf& origBuf,
   cStruct.pcPatternKey = pcPatternKey;
   cStruct.iRefStride = refBuf.stride;
   cStruct.piRefY = refBuf.buf;
+  cStruct.trackSearchWindow = false;
+  cStruct.clampToWindow = false;
   CHECK(pu.cu->imv == IMV_HPEL, "IF_IBC");
   cStruct.imvShift = pu.cu->imv << 1;
   cStruct.subShiftMode = 0; // used by intra pattern search function
@@ -2455,8 +2493,8 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 
         unsigned idx1, idx2, idx3, idx4;
         getAreaIdx(cu.Y(), *cu.slice->getPPS()->pcv, idx1, idx2, idx3, idx4);
-        ::memcpy(&(g_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, 2 * 33 * sizeof(Mv));
-        g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
+        ::memcpy(&(m_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, 2 * 33 * sizeof(Mv));
+        m_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
       }
       //  Bi-predictive Motion estimation
       if( ( cs.slice->isInterB() ) && ( PU::isBipredRestriction( pu ) == false )
@@ -2922,8 +2960,10 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
       Mv acMvAffine4Para[2][33][3];
       int refIdx4Para[2] = { -1, -1 };
 
+      setApproxMc( true );
       xPredAffineInterSearch(pu, origBuf, puIdx, uiLastModeTemp, uiAffineCost, cMvHevcTemp, acMvAffine4Para, refIdx4Para, bcwIdx, enforceBcwPred,
         ((cu.slice->getSPS()->getUseBcw() == true) ? getWeightIdxBits(bcwIdx) : 0));
+      setApproxMc( false );
 
       if ( pu.cu->imv == 0 )
       {
@@ -2962,8 +3002,10 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 
           Distortion uiAffine6Cost = std::numeric_limits<Distortion>::max();
           cu.affineType = AFFINEMODEL_6PARAM;
+          setApproxMc( true );
           xPredAffineInterSearch(pu, origBuf, puIdx, uiLastModeTemp, uiAffine6Cost, cMvHevcTemp, acMvAffine4Para, refIdx4Para, bcwIdx, enforceBcwPred,
             ((cu.slice->getSPS()->getUseBcw() == true) ? getWeightIdxBits(bcwIdx) : 0));
+          setApproxMc( false );
 
           if ( pu.cu->imv == 0 )
           {
@@ -3346,6 +3388,7 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
   cStruct.useAltHpelIf = pu.cu->imv == IMV_HPEL;
   cStruct.inCtuSearch = false;
   cStruct.zeroMV = false;
+  xInitSearchWindow( pu, pu.cu->slice->getRefPic( eRefPicList, iRefIdxPred ), wrap, cStruct );
   {
     if (m_useCompositeRef && pu.cs->slice->getRefPic(eRefPicList, iRefIdxPred)->longTerm)
     {
@@ -3392,6 +3435,7 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
     m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSearchWindowAccess( cStruct, m_cDistParam.cur.buf, cStruct.pcPatternKey->width, cStruct.pcPatternKey->height );
     Distortion uiBestSad = m_cDistParam.distFunc(m_cDistParam);
     uiBestSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
 
@@ -3414,7 +3458,12 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
       cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
       clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
       cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
+      if( !xIsInSearchWindow( cStruct, cTmpMv.hor, cTmpMv.ver ) )
+      {
+        continue;
+      }
       m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+      xSearchWindowAccess( cStruct, m_cDistParam.cur.buf, cStruct.pcPatternKey->width, cStruct.pcPatternKey->height );
 
       Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
       uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -3561,6 +3610,52 @@ void InterSearch::xSetSearchRange ( const PredictionUnit& pu,
       cStruct.zeroMV = 1;
     }
   }
+
+  if( cStruct.clampToWindow )
+  {
+    // a range outside of the window collapses to the nearest window position
+    const SearchRange& wr = cStruct.windowRange;
+    sr.left   = std::max( sr.left,   wr.left );
+    sr.right  = std::min( sr.right,  wr.right );
+    sr.top    = std::max( sr.top,    wr.top );
+    sr.bottom = std::min( sr.bottom, wr.bottom );
+    if( sr.left > sr.right )
+    {
+      sr.left = sr.right = sr.right < wr.left ? wr.left : wr.right;
+    }
+    if( sr.top > sr.bottom )
+    {
+      sr.top = sr.bottom = sr.bottom < wr.top ? wr.top : wr.bottom;
+    }
+  }
+}
+
+/**
+* \brief Set up the search window model for the integer search of a block
+*
+* The window range keeps the support of the fractional refinement around the integer result inside the window.
+*/
+void InterSearch::xInitSearchWindow( const PredictionUnit& pu, const Picture* refPic, const bool wrapRef, IntTZSearchStruct& cStruct )
+{
+  cStruct.trackSearchWindow = m_searchWindowModel && !wrapRef;
+  cStruct.clampToWindow     = cStruct.trackSearchWindow && m_searchWindowModel->getCfg().clampSearch;
+  if( !cStruct.trackSearchWindow )
+  {
+    return;
+  }
+
+  const PreCalcValues& pcv = *pu.cs->pcv;
+  const Position ctuPos( pu.lumaPos().x & ~pcv.maxCUWidthMask, pu.lumaPos().y & ~pcv.maxCUHeightMask );
+  m_searchWindowModel->setCurrentCtu( ctuPos );
+  m_searchWindowModel->setRefPicture( refPic );
+
+  const Area  window = m_searchWindowModel->getWindow( ctuPos );
+  const Area& blk    = pu.Y();
+  const int   margin = NTAPS_LUMA >> 1;
+  cStruct.windowRange.left   = window.x + margin - blk.x;
+  cStruct.windowRange.top    = window.y + margin - blk.y;
+  cStruct.windowRange.right  = window.x + (int) window.width  - margin - ( blk.x + (int) blk.width );
+  cStruct.windowRange.bottom = window.y + (int) window.height - margin - ( blk.y + (int) blk.height );
 }
 
 
@@ -3579,6 +3674,7 @@ void InterSearch::xPatternSearch( IntTZSearchStruct&    cStruct,
   const SearchRange& sr = cStruct.searchRange;
 
   const Pel* piRef = cStruct.piRefY + (sr.top * cStruct.iRefStride);
+  xSearchWindowAccess( cStruct, piRef + sr.left, sr.right - sr.left + cStruct.pcPatternKey->width, sr.bottom - sr.top + cStruct.pcPatternKey->height );
   for ( int y = sr.top; y <= sr.bottom; y++ )
   {
     for ( int x = sr.left; x <= sr.right; x++ )
@@ -3682,6 +3778,11 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
   }
   rcMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_QUARTER);
   rcMv.divideByPowerOf2(2);
+  if( cStruct.clampToWindow )
+  {
+    const SearchRange& wr = cStruct.windowRange;
+    rcMv.set( Clip3( wr.left, wr.right, rcMv.getHor() ), Clip3( wr.top, wr.bottom, rcMv.getVer() ) );
+  }
 
   // init TZSearchStruct
   cStruct.uiBestSad = std::numeric_limits<Distortion>::max();
@@ -3751,7 +3852,12 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
+    if( !xIsInSearchWindow( cStruct, cTmpMv.hor, cTmpMv.ver ) )
+    {
+      continue;
+    }
     m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSearchWindowAccess( cStruct, m_cDistParam.cur.buf, cStruct.pcPatternKey->width, cStruct.pcPatternKey->height );
 
     Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -4056,7 +4162,12 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
+    if( !xIsInSearchWindow( cStruct, cTmpMv.hor, cTmpMv.ver ) )
+    {
+      continue;
+    }
     m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSearchWindowAccess( cStruct, m_cDistParam.cur.buf, cStruct.pcPatternKey->width, cStruct.pcPatternKey->height );
 
     Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -4297,11 +4408,17 @@ void InterSearch::xPatternSearchFracDIF(
   //  Reference pattern initialization (integer scale)
   int         iOffset    = rcMvInt.getHor() + rcMvInt.getVer() * cStruct.iRefStride;
   CPelBuf cPatternRoi(cStruct.piRefY + iOffset, cStruct.iRefStride, *cStruct.pcPatternKey);
+  m_fracPelPlanes = nullptr;
   if (m_skipFracME)
   {
     Mv baseRefMv(0, 0);
     rcMvHalf.setZero();
     m_pcRdCost->setCostScale(0);
+    m_fracFilterNumTaps = m_approxFilterPolicy.selectNumTaps( pu, ruiCost );
+    if (xIsRefAccessTracked())
+    {
+      xCacheAccessFracPel( pu, eRefPicList, iRefIdx, cPatternRoi );
+    }
     xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
     rcMvQter = rcMvInt;   rcMvQter <<= 2;    // for mv-cost
     ruiCost = xPatternRefinement(cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, !pu.cs->slice->getDisableSATDForRD());
@@ -4319,7 +4436,16 @@ void InterSearch::xPatternSearchFracDIF(
 
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+  m_fracFilterNumTaps = m_approxFilterPolicy.selectNumTaps( pu, ruiCost );
+  m_fracPelPlanes = xGetFracPelPlanes( pu, eRefPicList, iRefIdx, cStruct, rcMvInt );
+  if (!m_fracPelPlanes)
+  {
+    if (xIsRefAccessTracked())
+    {
+      xCacheAccessFracPel( pu, eRefPicList, iRefIdx, cPatternRoi );
+    }
+    xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+  }
 
   rcMvHalf = rcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   Mv baseRefMv(0, 0);
@@ -4329,7 +4455,10 @@ void InterSearch::xPatternSearchFracDIF(
   if (cStruct.imvShift == IMV_OFF)
   {
   m_pcRdCost->setCostScale( 0 );
-  xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  if (!m_fracPelPlanes)
+  {
+    xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  }
   baseRefMv = rcMvHalf;
   baseRefMv <<= 1;
 
@@ -5832,6 +5961,62 @@ void InterSearch::xCopyAffineAMVPInfo (AffineAMVPInfo& src, AffineAMVPInfo& dst)
 }
 
 
+/**
+* \brief Get the precomputed fractional-sample planes around the integer-pel search result
+*
+* \returns nullptr if the planes cannot be used, the caller then interpolates the patch itself
+*/
+const FracPelPlanes* InterSearch::xGetFracPelPlanes( const PredictionUnit& pu, RefPicList eRefPicList, int iRefIdx, const IntTZSearchStruct& cStruct, const Mv& rcMvInt )
+{
+  if( !m_fracPelPlaneCache.isEnabled() || m_useCompositeRef )
+  {
+    return nullptr;
+  }
+
+  // planes of inter-layer references are not invalidated by this encoder, scaled references are not searched in place
+  const Picture* refPic = pu.cu->slice->getRefPic( eRefPicList, iRefIdx );
+  if( refPic->layerId != pu.cs->picture->layerId || refPic->isRefScaled( pu.cs->pps ) )
+  {
+    return nullptr;
+  }
+
+  const bool    wrap   = refPic->isWrapAroundEnabled( pu.cs->pps );
+  const CPelBuf refBuf = refPic->getRecoBuf( COMPONENT_Y, wrap );
+  const Position pos   = pu.lumaPos().offset( rcMvInt.getHor(), rcMvInt.getVer() );
+  if( cStruct.iRefStride != refBuf.stride || cStruct.piRefY != refBuf.bufAt( pu.lumaPos() ) )
+  {
+    return nullptr;
+  }
+
+  FracPelPlanes* planes = m_fracPelPlaneCache.getPlanes( refPic, refBuf, refPic->margin, pu.cs->pcv->maxCUWidth, m_fracFilterNumTaps, cStruct.useAltHpelIf );
+  const Area     area( pos.x - 1, pos.y - 1, cStruct.pcPatternKey->width + 1, cStruct.pcPatternKey->height + 1 );
+  if( planes == nullptr || !planes->prepare( m_if, m_lumaClpRng, area ) )
+  {
+    return nullptr;
+  }
+
+  m_fracPelPlanesOffset = pos.y * refBuf.stride + pos.x;
+  return planes;
+}
+
+/**
+* \brief Account the reference samples read by the half- and quarter-sample refinement in the cache model
+*
+* \param pattern Reference picture ROI at the integer-sample search result
+*/
+void InterSearch::xCacheAccessFracPel( const PredictionUnit& pu, RefPicList eRefPicList, int iRefIdx, const CPelBuf& pattern )
+{
+  const Picture* refPic = pu.cu->slice->getRefPic( eRefPicList, iRefIdx );
+  if( refPic->isWrapAroundEnabled( pu.cs->pps ) )
+  {
+    return;
+  }
+  // the refinement covers fractional positions on both sides of the block, which needs one more sample than the kernel
+  const int filterSize = xGetMcFilterSize( COMPONENT_Y, m_fracFilterNumTaps ) + 1;
+
+  xCacheAccess( pu, refPic, COMPONENT_Y, pattern.buf, pattern.stride, pattern.width, pattern.height, filterSize, filterSize );
+}
+
 /**
 * \brief Generate half-sample interpolated block
 *
@@ -5851,7 +6036,7 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
   Pel *dstPtr;
   int filterSize = NTAPS_LUMA;
 
-  int n_taps_filter = LabUCPel::ntaps_filter;
+  int n_taps_filter = m_fracFilterNumTaps;
 
   int halfFilterSize = (filterSize>>1);
   const Pel *srcPtr = pattern->buf - halfFilterSize*srcStride - 1;
@@ -5910,7 +6095,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   Pel *dstPtr;
   int filterSize = NTAPS_LUMA;
 
-  int n_taps_filter = LabUCPel::ntaps_filter;
+  int n_taps_filter = m_fracFilterNumTaps;
 
   int halfFilterSize = (filterSize>>1);
 
@@ -5929,7 +6114,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   {
     srcPtr += 1;
   }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 1 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, n_taps_filter);
+  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 1 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, 0, false, false, n_taps_filter);
 
   // Horizontal filter 3/4
   srcPtr = pattern->buf - halfFilterSize*srcStride - 1;
@@ -5942,7 +6127,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   {
     srcPtr += 1;
   }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 3 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, n_taps_filter);
+  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 3 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, 0, false, false, n_taps_filter);
 
   // Generate @ 1,1
   intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize-1) * intStride;
@@ -5951,12 +6136,12 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   {
     intPtr += intStride;
   }
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
   // Generate @ 3,1
   intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize-1) * intStride;
   dstPtr = m_filteredBlock[3][1][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
   if (halfPelRef.getVer() != 0)
   {
@@ -5967,7 +6152,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
     // Generate @ 2,3
     intPtr = m_filteredBlockTmp[3][0] + (halfFilterSize - 1) * intStride;
@@ -5976,19 +6161,19 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
   }
   else
   {
     // Generate @ 0,1
     intPtr = m_filteredBlockTmp[1][0] + halfFilterSize * intStride;
     dstPtr = m_filteredBlock[0][1][0];
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
     // Generate @ 0,3
     intPtr = m_filteredBlockTmp[3][0] + halfFilterSize * intStride;
     dstPtr = m_filteredBlock[0][3][0];
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
   }
 
   if (halfPelRef.getHor() != 0)
@@ -6004,7 +6189,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
     // Generate @ 3,2
     intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
@@ -6017,7 +6202,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
   }
   else
   {
@@ -6028,7 +6213,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
     // Generate @ 3,0
     intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
@@ -6037,7 +6222,7 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
     {
       intPtr += intStride;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
   }
 
   // Generate @ 1,3
@@ -6047,12 +6232,12 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   {
     intPtr += intStride;
   }
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 
   // Generate @ 3,3
   intPtr = m_filteredBlockTmp[3][0] + (halfFilterSize - 1) * intStride;
   dstPtr = m_filteredBlock[3][3][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, n_taps_filter);
+  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng, 0, false, false, n_taps_filter);
 }
 
 
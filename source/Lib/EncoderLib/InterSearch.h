@@ -55,6 +55,8 @@
 #include <unordered_map>
 #include <vector>
 #include "EncReshape.h"
+#include "ApproxFilterPolicy.h"
+#include "FracPelPlaneCache.h"
 //! \ingroup EncoderLib
 //! \{
 
@@ -125,6 +127,8 @@ private:
   int             m_uniMvListIdx;
   int             m_uniMvListSize;
   int             m_uniMvListMaxSize;
+  Mv            ( *m_reusedUniMVs )[32][8][8][2][33];        ///< uni-prediction MVs of searched blocks, indexed by getAreaIdx()
+  bool          ( *m_isReusedUniMVsFilled )[32][8][8];
   Distortion      m_hevcCost;
   EncAffineMotion m_affineMotion;
   PatentBvCand    m_defaultCachedBvs;
@@ -150,6 +154,12 @@ protected:
   RefPicList      m_currRefPicList;
   int             m_currRefPicIndex;
   bool            m_skipFracME;
+  ApproxFilterPolicy m_approxFilterPolicy;
+  ApproxFilterBank   m_approxFilterBank;
+  int             m_fracFilterNumTaps;          // luma filter taps of the current fractional-pel refinement
+  FracPelPlaneCache m_fracPelPlaneCache;
+  const FracPelPlanes* m_fracPelPlanes;         // precomputed planes used by the current fractional-pel refinement, if any
+  int             m_fracPelPlanesOffset;        // offset of the integer-pel search result in m_fracPelPlanes
   int             m_numHashMVStoreds[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
   Mv              m_hashMVStoreds[NUM_REF_PIC_LIST_01][MAX_NUM_REF][5];
 
@@ -206,7 +216,7 @@ public:
 
   void setTempBuffers               (CodingStructure ****pSlitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS );
   void resetCtuRecord               ()             { m_ctuRecord.clear(); }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void copyState                    ( const InterSearch& other );
 #endif
   void setAffineModeSelected        ( bool flag) { m_affineModeSelected = flag; }
@@ -243,6 +253,9 @@ public:
     }
   }
   void resetUniMvList() { m_uniMvListIdx = 0; m_uniMvListSize = 0; }
+  void resetReusedUniMvs() { ::memset( m_isReusedUniMVsFilled, 0, 32 * sizeof( *m_isReusedUniMVsFilled ) ); }
+  bool isReusedUniMvsFilled( unsigned idx1, unsigned idx2, unsigned idx3, unsigned idx4 ) const { return m_isReusedUniMVsFilled[idx1][idx2][idx3][idx4]; }
+  Mv ( *getReusedUniMvs( unsigned idx1, unsigned idx2, unsigned idx3, unsigned idx4 ) )[33] { return m_reusedUniMVs[idx1][idx2][idx3][idx4]; }
   void insertUniMvCands(CompArea blkArea, Mv cMvTemp[2][33])
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + m_uniMvListIdx;
@@ -348,10 +361,26 @@ protected:
     bool        useAltHpelIf;
     bool        inCtuSearch;
     bool        zeroMV;
+    bool        trackSearchWindow;  // account the reads in the search window model
+    bool        clampToWindow;      // only test positions in windowRange
+    SearchRange windowRange;        // integer search positions whose interpolation support lies in the search window
   } IntTZSearchStruct;
 
   // sub-functions for ME
   inline void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance );
+  void xInitSearchWindow            ( const PredictionUnit& pu, const Picture* refPic, const bool wrapRef, IntTZSearchStruct& cStruct );
+  bool xIsInSearchWindow            ( const IntTZSearchStruct& cStruct, const int iSearchX, const int iSearchY ) const
+  {
+    const SearchRange& wr = cStruct.windowRange;
+    return !cStruct.clampToWindow || ( iSearchX >= wr.left && iSearchX <= wr.right && iSearchY >= wr.top && iSearchY <= wr.bottom );
+  }
+  void xSearchWindowAccess          ( const IntTZSearchStruct& cStruct, const Pel* buf, const int width, const int height )
+  {
+    if( cStruct.trackSearchWindow )
+    {
+      m_searchWindowModel->blockAccess( buf, width, height );
+    }
+  }
   inline void xTZ2PointSearch       ( IntTZSearchStruct& rcStruct );
   inline void xTZ8PointSquareSearch ( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist );
   inline void xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist, const bool bCheckCornersAtDist1 );
@@ -362,6 +391,10 @@ public:
   /// encoder estimation - inter prediction (non-skip)
 
   void setModeCtrl( EncModeCtrl *modeCtrl ) { m_modeCtrl = modeCtrl;}
+  const ApproxFilterPolicy& getApproxFilterPolicy() const { return m_approxFilterPolicy; }
+  void invalidateFracPelPlanes( const Picture* pic ) { m_fracPelPlaneCache.invalidate( pic ); }
+  /// switch motion compensation between the approximate prescreen filters and the normative ones
+  void setApproxMc( const bool approx ) { approx ? setApproxMcNumTaps( m_pcEncCfg->getApproxCfg().mcPrescreenLumaNumTaps, m_pcEncCfg->getApproxCfg().mcPrescreenChromaNumTaps ) : resetApproxMcNumTaps(); }
 
   void predInterSearch(CodingUnit& cu, Partitioner& partitioner );
 
@@ -584,7 +617,9 @@ public:
 protected:
 
   void xExtDIFUpSamplingH(CPelBuf* pcPattern, bool useAltHpelIf);
+  const FracPelPlanes* xGetFracPelPlanes( const PredictionUnit& pu, RefPicList eRefPicList, int iRefIdx, const IntTZSearchStruct& cStruct, const Mv& rcMvInt );
   void xExtDIFUpSamplingQ         ( CPelBuf* pcPatternKey, Mv halfPelRef );
+  void xCacheAccessFracPel        ( const PredictionUnit& pu, RefPicList eRefPicList, int iRefIdx, const CPelBuf& pattern );
   uint32_t xDetermineBestMvp      ( PredictionUnit& pu, Mv acMvTemp[3], int& mvpIdx, const AffineAMVPInfo& aamvpi );
   // -------------------------------------------------------------------------------------------------------------------
   // compute symbol bits
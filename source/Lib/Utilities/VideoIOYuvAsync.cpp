@@ -0,0 +1,280 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsync.cpp
+    \brief    asynchronous YUV file input/output
+*/
+
+#include "VideoIOYuvAsync.h"
+
+// ====================================================================================================================
+// VideoIOYuvAsyncReader
+// ====================================================================================================================
+
+void VideoIOYuvAsyncReader::open( VideoIOYuv& file, const UnitArea& area, const int numFrames, const int maxFrames, const InputColourSpaceConversion ipcsc, const int aiPad[2], const ChromaFormat fileFormat, const bool clipToRec709 )
+{
+  CHECK( numFrames < 1, "The asynchronous reader needs at least one frame buffer" );
+  close();
+
+  m_file         = &file;
+  m_ipcsc        = ipcsc;
+  m_pad[0]       = aiPad[0];
+  m_pad[1]       = aiPad[1];
+  m_fileFormat   = fileFormat;
+  m_clipToRec709 = clipToRec709;
+  m_maxFrames    = maxFrames;
+
+  m_frames = std::vector<Frame>( numFrames );
+  for( auto& frame : m_frames )
+  {
+    frame.pic   .create( area );
+    frame.picOrg.create( area );
+  }
+  m_readIdx      = 0;
+  m_numReady     = 0;
+  m_numHandedOut = 0;
+  m_stop         = false;
+  m_eof          = false;
+
+  m_thread = std::thread( &VideoIOYuvAsyncReader::xReadFrames, this );
+}
+
+void VideoIOYuvAsyncReader::close()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+  m_frames.clear();
+}
+
+bool VideoIOYuvAsyncReader::read( PelStorage& pic, PelStorage& picOrg )
+{
+  if( m_eof )
+  {
+    return false;
+  }
+  if( m_numHandedOut == m_maxFrames )
+  {
+    // the background thread is done with the file, further frames are read directly
+    const bool ok = m_file->read( pic, picOrg, m_ipcsc, m_pad, m_fileFormat, m_clipToRec709 );
+    m_eof = m_file->isEof();
+    return ok;
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this] { return m_numReady > 0; } );
+  Frame& frame = m_frames[m_readIdx];
+  lock.unlock();
+
+  pic   .swap( frame.pic );
+  picOrg.swap( frame.picOrg );
+  const bool ok = frame.ok;
+  m_eof         = frame.eof;
+
+  lock.lock();
+  m_readIdx = ( m_readIdx + 1 ) % (int)m_frames.size();
+  m_numReady--;
+  m_numHandedOut++;
+  lock.unlock();
+  m_cond.notify_all();
+
+  return ok;
+}
+
+void VideoIOYuvAsyncReader::xReadFrames()
+{
+  const int numFrames = (int)m_frames.size();
+  int       writeIdx  = 0;
+
+  for( int n = 0; n < m_maxFrames; n++ )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [this, numFrames] { return m_numReady < numFrames || m_stop; } );
+      if( m_stop )
+      {
+        return;
+      }
+    }
+
+    // the frame is not visible to the consumer before it is marked ready
+    Frame& frame = m_frames[writeIdx];
+    frame.ok       = m_file->read( frame.pic, frame.picOrg, m_ipcsc, m_pad, m_fileFormat, m_clipToRec709 );
+    frame.eof      = m_file->isEof();
+    const bool eof = frame.eof;
+
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_numReady++;
+    }
+    m_cond.notify_all();
+
+    if( eof )
+    {
+      return;
+    }
+    writeIdx = ( writeIdx + 1 ) % numFrames;
+  }
+}
+
+// ====================================================================================================================
+// VideoIOYuvAsyncWriter
+// ====================================================================================================================
+
+void VideoIOYuvAsyncWriter::open( const int numFrames )
+{
+  CHECK( numFrames < 1, "The asynchronous writer needs at least one frame buffer" );
+  close();
+
+  m_frames    = std::vector<Frame>( numFrames );
+  m_writeIdx  = 0;
+  m_numQueued = 0;
+  m_stop      = false;
+
+  m_thread = std::thread( &VideoIOYuvAsyncWriter::xWriteFrames, this );
+}
+
+void VideoIOYuvAsyncWriter::close()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    // the queued frames are still written before the thread ends
+    m_thread.join();
+  }
+  m_frames.clear();
+}
+
+/** copies src into dst, which is (re-)created when the size or format changed
+ */
+static void copyToStorage( PelStorage& dst, const CPelUnitBuf& src )
+{
+  const Area area( 0, 0, src.get( COMPONENT_Y ).width, src.get( COMPONENT_Y ).height );
+  if( dst.bufs.empty() || dst.chromaFormat != src.chromaFormat || dst.bufs[0].width != area.width || dst.bufs[0].height != area.height )
+  {
+    dst.destroy();
+    dst.create( src.chromaFormat, area );
+  }
+  dst.copyFrom( src );
+}
+
+void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& pic, const WriteFunc& func )
+{
+  if( !isOpen() )
+  {
+    func( pic );
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  Frame& frame = xGetFreeFrame( lock );
+  copyToStorage( frame.pic[0], pic );
+  frame.func = [func]( const CPelUnitBuf& picTop, const CPelUnitBuf& ) { func( picTop ); };
+  xQueueFrame( lock );
+}
+
+void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot, const WriteFieldsFunc& func )
+{
+  if( !isOpen() )
+  {
+    func( picTop, picBot );
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  Frame& frame = xGetFreeFrame( lock );
+  copyToStorage( frame.pic[0], picTop );
+  copyToStorage( frame.pic[1], picBot );
+  frame.func = func;
+  xQueueFrame( lock );
+}
+
+void VideoIOYuvAsyncWriter::flush()
+{
+  if( isOpen() )
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this] { return m_numQueued == 0; } );
+  }
+}
+
+VideoIOYuvAsyncWriter::Frame& VideoIOYuvAsyncWriter::xGetFreeFrame( std::unique_lock<std::mutex>& lock )
+{
+  const int numFrames = (int)m_frames.size();
+  m_cond.wait( lock, [this, numFrames] { return m_numQueued < numFrames; } );
+  Frame& frame = m_frames[( m_writeIdx + m_numQueued ) % numFrames];
+  // the writer thread does not touch frames that are not queued, so the copy can run unlocked
+  lock.unlock();
+  return frame;
+}
+
+void VideoIOYuvAsyncWriter::xQueueFrame( std::unique_lock<std::mutex>& lock )
+{
+  lock.lock();
+  m_numQueued++;
+  lock.unlock();
+  m_cond.notify_all();
+}
+
+void VideoIOYuvAsyncWriter::xWriteFrames()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( true )
+  {
+    m_cond.wait( lock, [this] { return m_numQueued > 0 || m_stop; } );
+    if( m_numQueued == 0 )
+    {
+      return;
+    }
+    Frame& frame = m_frames[m_writeIdx];
+    lock.unlock();
+
+    frame.func( frame.pic[0], frame.pic[1] );
+
+    lock.lock();
+    frame.func = nullptr;
+    m_writeIdx = ( m_writeIdx + 1 ) % (int)m_frames.size();
+    m_numQueued--;
+    m_cond.notify_all();
+  }
+}
@@ -0,0 +1,139 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsync.h
+    \brief    asynchronous YUV file input/output (header)
+*/
+
+#ifndef __VIDEOIOYUVASYNC__
+#define __VIDEOIOYUVASYNC__
+
+#include "VideoIOYuv.h"
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads the frames of an input file in a background thread into a bounded ring of prefetched frames
+class VideoIOYuvAsyncReader
+{
+public:
+  VideoIOYuvAsyncReader() : m_file( nullptr ), m_maxFrames( 0 ), m_readIdx( 0 ), m_numReady( 0 ), m_numHandedOut( 0 ), m_stop( false ), m_eof( false ) {}
+  ~VideoIOYuvAsyncReader() { close(); }
+
+  /// starts prefetching at most maxFrames frames of file into numFrames buffers of the given area, see VideoIOYuv::read for the other parameters
+  void  open ( VideoIOYuv& file, const UnitArea& area, const int numFrames, const int maxFrames, const InputColourSpaceConversion ipcsc, const int aiPad[2], const ChromaFormat fileFormat, const bool clipToRec709 );
+  void  close();
+  bool  isOpen() const { return m_thread.joinable(); }
+
+  /// hands out the next frame by swapping it with pic and picOrg, which must have the area given to open, returns false at the end of the file,
+  /// frames beyond maxFrames are read directly
+  bool  read ( PelStorage& pic, PelStorage& picOrg );
+  bool  isEof() const  { return m_eof; }
+
+private:
+  struct Frame
+  {
+    PelStorage pic;
+    PelStorage picOrg;
+    bool       ok;
+    bool       eof;
+  };
+
+  void  xReadFrames();
+
+  VideoIOYuv*                m_file;
+  InputColourSpaceConversion m_ipcsc;
+  int                        m_pad[2];
+  ChromaFormat               m_fileFormat;
+  bool                       m_clipToRec709;
+  int                        m_maxFrames;
+
+  std::vector<Frame>         m_frames;
+  int                        m_readIdx;                     ///< next frame handed out
+  int                        m_numReady;                    ///< frames read but not handed out yet
+  int                        m_numHandedOut;                ///< frames handed out in total
+  bool                       m_stop;
+  bool                       m_eof;
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_cond;
+};
+
+/// writes output frames in a background thread, the frames are copied into a bounded ring and written in submission order
+class VideoIOYuvAsyncWriter
+{
+public:
+  typedef std::function<void( const CPelUnitBuf& pic )>                               WriteFunc;
+  typedef std::function<void( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot )> WriteFieldsFunc;
+
+  VideoIOYuvAsyncWriter() : m_writeIdx( 0 ), m_numQueued( 0 ), m_stop( false ) {}
+  ~VideoIOYuvAsyncWriter() { close(); }
+
+  void  open ( const int numFrames );
+  void  close();
+  bool  isOpen() const { return m_thread.joinable(); }
+
+  /// queues a copy of pic, func is called with the copy on the writer thread and does the conversion and file output
+  void  write( const CPelUnitBuf& pic, const WriteFunc& func );
+  void  write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot, const WriteFieldsFunc& func );
+  /// waits until all queued frames are written
+  void  flush();
+
+private:
+  struct Frame
+  {
+    PelStorage      pic[2];
+    WriteFieldsFunc func;
+  };
+
+  Frame& xGetFreeFrame( std::unique_lock<std::mutex>& lock );
+  void   xQueueFrame  ( std::unique_lock<std::mutex>& lock );
+  void   xWriteFrames ();
+
+  std::vector<Frame>         m_frames;
+  int                        m_writeIdx;                    ///< next frame written
+  int                        m_numQueued;                   ///< frames queued but not written yet, including the one being written
+  bool                       m_stop;
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_cond;
+};
+
+#endif // __VIDEOIOYUVASYNC__